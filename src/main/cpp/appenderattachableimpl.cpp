@@ -16,6 +16,7 @@
  */
 #include <log4cxx/helpers/appenderattachableimpl.h>
 #include <algorithm>
+#include <atomic>
 #include <mutex>
 
 using namespace LOG4CXX_NS;
@@ -25,8 +26,47 @@ IMPLEMENT_LOG4CXX_OBJECT(AppenderAttachableImpl)
 
 struct AppenderAttachableImpl::priv_data
 {
-	/** Array of appenders. */
-	AppenderList  appenderList;
+	using AppenderListPtr = std::shared_ptr<const AppenderList>;
+
+	priv_data() : appenderList(std::make_shared<AppenderList>())
+	{}
+
+	/**
+	 * The attached appenders.
+	 *
+	 * The list referenced is never modified once published.
+	 * A change builds a new list (while holding m_mutex) and atomically replaces the pointer,
+	 * so readers on the logging path do not need to lock m_mutex.
+	 */
+#ifdef __cpp_lib_atomic_shared_ptr
+	std::atomic<AppenderListPtr> appenderList;
+
+	AppenderListPtr getList() const
+	{
+		return appenderList.load(std::memory_order_acquire);
+	}
+
+	void setList(AppenderListPtr newList)
+	{
+		appenderList.store(std::move(newList), std::memory_order_release);
+	}
+#else
+	AppenderListPtr appenderList;
+
+	AppenderListPtr getList() const
+	{
+		return std::atomic_load_explicit(&appenderList, std::memory_order_acquire);
+	}
+
+	void setList(AppenderListPtr newList)
+	{
+		std::atomic_store_explicit(&appenderList, std::move(newList), std::memory_order_release);
+	}
+#endif
+
+	/**
+	 * Serializes changes to appenderList.
+	 */
 	mutable std::mutex m_mutex;
 };
 
@@ -57,12 +97,15 @@ void AppenderAttachableImpl::addAppender(const AppenderPtr newAppender)
 		m_priv = std::make_unique<AppenderAttachableImpl::priv_data>();
 
 	std::lock_guard<std::mutex> lock( m_priv->m_mutex );
-	AppenderList::iterator it = std::find(
-			m_priv->appenderList.begin(), m_priv->appenderList.end(), newAppender);
+	auto currentList = m_priv->getList();
+	AppenderList::const_iterator it = std::find(
+			currentList->begin(), currentList->end(), newAppender);
 
-	if (it == m_priv->appenderList.end())
+	if (it == currentList->end())
 	{
-		m_priv->appenderList.push_back(newAppender);
+		auto newList = std::make_shared<AppenderList>(*currentList);
+		newList->push_back(newAppender);
+		m_priv->setList(std::move(newList));
 	}
 }
 
@@ -75,10 +118,10 @@ int AppenderAttachableImpl::appendLoopOnAppenders(
 	{
 		// FallbackErrorHandler::error() may modify our list of appenders
 		// while we are iterating over them (if it holds the same logger).
-		// So, make a local copy of the appenders that we want to iterate over
-		// before actually iterating over them.
-		AppenderList allAppenders = getAllAppenders();
-		for (auto appender : allAppenders)
+		// A modification publishes a new list, so holding a reference to
+		// the current list keeps it (and its appenders) valid while we iterate.
+		auto allAppenders = m_priv->getList();
+		for (auto& appender : *allAppenders)
 		{
 			appender->doAppend(event, p);
 			numberAppended++;
@@ -93,8 +136,7 @@ AppenderList AppenderAttachableImpl::getAllAppenders() const
 	AppenderList result;
 	if (m_priv)
 	{
-		std::lock_guard<std::mutex> lock( m_priv->m_mutex );
-		result = m_priv->appenderList;
+		result = *m_priv->getList();
 	}
 	return result;
 }
@@ -104,8 +146,8 @@ AppenderPtr AppenderAttachableImpl::getAppender(const LogString& name) const
 	AppenderPtr result;
 	if (m_priv && !name.empty())
 	{
-		std::lock_guard<std::mutex> lock( m_priv->m_mutex );
-		for (auto appender : m_priv->appenderList)
+		auto currentList = m_priv->getList();
+		for (auto& appender : *currentList)
 		{
 			if (name == appender->getName())
 			{
@@ -122,8 +164,8 @@ bool AppenderAttachableImpl::isAttached(const AppenderPtr appender) const
 	bool result = false;
 	if (m_priv && appender)
 	{
-		std::lock_guard<std::mutex> lock( m_priv->m_mutex );
-		result = std::find(m_priv->appenderList.begin(), m_priv->appenderList.end(), appender) != m_priv->appenderList.end();
+		auto currentList = m_priv->getList();
+		result = std::find(currentList->begin(), currentList->end(), appender) != currentList->end();
 	}
 	return result;
 }
@@ -132,10 +174,11 @@ void AppenderAttachableImpl::removeAllAppenders()
 {
 	if (m_priv)
 	{
-		for (auto a : getAllAppenders())
+		auto currentList = m_priv->getList();
+		for (auto& a : *currentList)
 			a->close();
 		std::lock_guard<std::mutex> lock( m_priv->m_mutex );
-		m_priv->appenderList.clear();
+		m_priv->setList(std::make_shared<AppenderList>());
 	}
 }
 
@@ -144,10 +187,13 @@ void AppenderAttachableImpl::removeAppender(const AppenderPtr appender)
 	if (m_priv && appender)
 	{
 		std::lock_guard<std::mutex> lock( m_priv->m_mutex );
-		auto it = std::find(m_priv->appenderList.begin(), m_priv->appenderList.end(), appender);
-		if (it != m_priv->appenderList.end())
+		auto currentList = m_priv->getList();
+		auto it = std::find(currentList->begin(), currentList->end(), appender);
+		if (it != currentList->end())
 		{
-			m_priv->appenderList.erase(it);
+			auto newList = std::make_shared<AppenderList>(currentList->begin(), it);
+			newList->insert(newList->end(), it + 1, currentList->end());
+			m_priv->setList(std::move(newList));
 		}
 	}
 }
@@ -157,14 +203,17 @@ void AppenderAttachableImpl::removeAppender(const LogString& name)
 	if (m_priv && !name.empty())
 	{
 		std::lock_guard<std::mutex> lock( m_priv->m_mutex );
-		auto it = std::find_if(m_priv->appenderList.begin(), m_priv->appenderList.end()
+		auto currentList = m_priv->getList();
+		auto it = std::find_if(currentList->begin(), currentList->end()
 			, [&name](const AppenderPtr& appender) -> bool
 			{
 				return name == appender->getName();
 			});
-		if (it != m_priv->appenderList.end())
-			m_priv->appenderList.erase(it);
+		if (it != currentList->end())
+		{
+			auto newList = std::make_shared<AppenderList>(currentList->begin(), it);
+			newList->insert(newList->end(), it + 1, currentList->end());
+			m_priv->setList(std::move(newList));
+		}
 	}
 }
-
-
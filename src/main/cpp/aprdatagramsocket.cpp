@@ -18,7 +18,14 @@
 #include <log4cxx/private/aprdatagramsocket.h>
 #include <log4cxx/private/datagramsocket_priv.h>
 #include <log4cxx/helpers/transcoder.h>
+#include <log4cxx/private/log4cxx_private.h>
 #include <apr_network_io.h>
+#include <algorithm>
+#if LOG4CXX_HAS_SENDMMSG
+	#include <apr_portable.h>
+	#include <sys/socket.h>
+	#include <cerrno>
+#endif
 
 namespace LOG4CXX_NS
 {
@@ -205,6 +212,78 @@ void APRDatagramSocket::connect(InetAddressPtr address1, int port1)
 	}
 }
 
+void APRDatagramSocket::send(const std::string* datagrams, size_t count)
+{
+	if (_priv->socket == 0)
+	{
+		throw ClosedChannelException();
+	}
+
+#if LOG4CXX_HAS_SENDMMSG
+	apr_os_sock_t fd;
+	apr_status_t status = apr_os_sock_get(&fd, _priv->socket);
+
+	if (status != APR_SUCCESS)
+	{
+		throw IOException(status);
+	}
+
+	enum { MaxBatchSize = 64 };
+	struct iovec parts[MaxBatchSize];
+	struct mmsghdr messages[MaxBatchSize];
+
+	while (0 < count)
+	{
+		unsigned int batchSize = (unsigned int) std::min(count, (size_t) MaxBatchSize);
+
+		for (unsigned int i = 0; i < batchSize; ++i)
+		{
+			parts[i].iov_base = const_cast<char*>(datagrams[i].data());
+			parts[i].iov_len = datagrams[i].size();
+			messages[i] = mmsghdr();
+			messages[i].msg_hdr.msg_iov = &parts[i];
+			messages[i].msg_hdr.msg_iovlen = 1;
+		}
+
+		int sent = ::sendmmsg(fd, messages, batchSize, 0);
+
+		if (sent < 0)
+		{
+			// A refused earlier datagram is reported (once) by the next send on a connected socket
+			if (errno == EINTR || errno == ECONNREFUSED)
+			{
+				continue;
+			}
+
+			throw IOException(APR_FROM_OS_ERROR(errno));
+		}
+
+		datagrams += sent;
+		count -= sent;
+	}
+#else
+	while (0 < count)
+	{
+		apr_size_t len = datagrams->size();
+		apr_status_t status = apr_socket_send(_priv->socket, datagrams->data(), &len);
+
+		// A refused earlier datagram is reported (once) by the next send on a connected socket
+		if (status == APR_ECONNREFUSED)
+		{
+			continue;
+		}
+
+		if (status != APR_SUCCESS)
+		{
+			throw IOException(status);
+		}
+
+		++datagrams;
+		--count;
+	}
+#endif
+}
+
 
 bool APRDatagramSocket::isClosed() const
 {
@@ -22,10 +22,17 @@
 #include <log4cxx/helpers/stringhelper.h>
 #include <log4cxx/helpers/optionconverter.h>
 #include <log4cxx/helpers/threadutility.h>
+#include <log4cxx/helpers/fileoutputstream.h>
+#include <log4cxx/helpers/fileinputstream.h>
+#include <log4cxx/helpers/bytebuffer.h>
 #include <log4cxx/private/appenderskeleton_priv.h>
+#include <log4cxx/file.h>
 #include <thread>
 #include <atomic>
 #include <condition_variable>
+#include <deque>
+#include <algorithm>
+#include <cstring>
 
 #if LOG4CXX_EVENTS_AT_EXIT
 #include <log4cxx/private/atexitregistry.h>
@@ -102,6 +109,98 @@ typedef std::map<LogString, DiscardSummary> DiscardMap;
 }
 #endif
 
+namespace
+{
+
+/**
+ * Overflowing events held in a file until the dispatch thread is ready for them.
+ *
+ * Levels and locations are recorded as an index into a table held in memory,
+ * so the file content is only meaningful to the process that wrote it.
+*/
+class SpillFile
+{
+	public:
+		SpillFile(const LogString& path);
+		~SpillFile();
+
+		/**
+		 * Append \c events to the file.
+		 *
+		 * @return false if the events could not be written.
+		*/
+		bool write(const LoggingEventList& events, Pool& p);
+
+		/**
+		 * Append to \c events the next \c count events written to the file.
+		 *
+		 * @return false if the events could not be read.
+		*/
+		bool read(size_t count, LoggingEventList& events);
+
+		/**
+		 * Discard the file content and remove the file.
+		*/
+		void clear(Pool& p);
+
+	private:
+		uint32_t getIndex(const LevelPtr& level);
+		uint32_t getIndex(const LocationInfo& location);
+		void putEvent(std::vector<char>& buf, const LoggingEventPtr& event);
+		LoggingEventPtr createEvent(const char* data);
+
+		LogString path;
+		FileOutputStreamPtr output;
+		FileInputStreamPtr input;
+
+		/**
+		 * Bytes read from the file that are not yet converted to an event.
+		*/
+		std::vector<char> pending;
+
+		/**
+		 *  Mutex used to guard access to levels and locations.
+		 */
+		std::mutex tableMutex;
+		std::vector<LevelPtr> levels;
+		std::vector<LocationInfo> locations;
+		std::map<std::pair<const char*, int>, uint32_t> locationIndex;
+};
+
+template <typename T>
+void putValue(std::vector<char>& buf, const T& value)
+{
+	auto p = reinterpret_cast<const char*>(&value);
+	buf.insert(buf.end(), p, p + sizeof (T));
+}
+
+void putString(std::vector<char>& buf, const LogString& value)
+{
+	putValue(buf, value.size());
+	auto p = reinterpret_cast<const char*>(value.data());
+	buf.insert(buf.end(), p, p + value.size() * sizeof (logchar));
+}
+
+template <typename T>
+T getValue(const char*& data)
+{
+	T value;
+	std::memcpy(&value, data, sizeof (T));
+	data += sizeof (T);
+	return value;
+}
+
+LogString getString(const char*& data)
+{
+	auto size = getValue<LogString::size_type>(data);
+	LogString value(size, 0);
+	std::memcpy(&value[0], data, size * sizeof (logchar));
+	data += size * sizeof (logchar);
+	return value;
+}
+
+} // namespace
+
 #ifdef __cpp_lib_hardware_interference_size
 	using std::hardware_constructive_interference_size;
 	using std::hardware_destructive_interference_size;
@@ -115,18 +214,20 @@ struct AsyncAppender::AsyncAppenderPriv : public AppenderSkeleton::AppenderSkele
 {
 	AsyncAppenderPriv()
 		: AppenderSkeletonPrivate()
-		, buffer(DEFAULT_BUFFER_SIZE)
+		, buffer()
 		, bufferSize(DEFAULT_BUFFER_SIZE)
 		, dispatcher()
 		, locationInfo(false)
-		, blocking(true)
+		, overflowPolicy(OverflowPolicy::Block)
+		, overflowThreshold(Level::getWarn())
 #if LOG4CXX_EVENTS_AT_EXIT
 		, atExitRegistryRaii([this]{stopDispatcher();})
 #endif
 		, eventCount(0)
 		, dispatchedCount(0)
-		, commitCount(0)
-		{ }
+		{
+			resetBuffer(DEFAULT_BUFFER_SIZE);
+		}
 
 	~AsyncAppenderPriv()
 	{
@@ -134,12 +235,17 @@ struct AsyncAppender::AsyncAppenderPriv : public AppenderSkeleton::AppenderSkele
 	}
 
 	/**
-	 * Event buffer.
+	 * Event buffer slot.
 	*/
-	struct EventData
+	struct alignas(hardware_destructive_interference_size) EventData
 	{
 		LoggingEventPtr event;
 		size_t pendingCount;
+		/**
+		 * The slot may be written by the logging thread that claims position \c sequence
+		 * and read by the dispatch thread when \c sequence is one more than its position.
+		*/
+		std::atomic<size_t> sequence{0};
 	};
 	std::vector<EventData> buffer;
 
@@ -176,11 +282,172 @@ struct AsyncAppender::AsyncAppenderPriv : public AppenderSkeleton::AppenderSkele
 		this->setClosed();
 		bufferNotEmpty.notify_all();
 		bufferNotFull.notify_all();
+		spillNeeded.notify_all();
 
+		if (spillWriter.joinable())
+		{
+			spillWriter.join();
+		}
 		if (dispatcher.joinable())
 		{
 			dispatcher.join();
 		}
+		appenderDispatchers.clear();
+	}
+
+	/**
+	 * Forwards events to a single appender using a dedicated thread.
+	*/
+	struct AppenderDispatcher
+	{
+		AppenderDispatcher(AsyncAppenderPriv& owner1, const AppenderPtr& appender1)
+			: owner(owner1)
+			, appender(appender1)
+			, thread(ThreadUtility::instance()->createThread(LOG4CXX_STR("AsyncAppender"), &AppenderDispatcher::run, this))
+		{
+		}
+
+		/**
+		 * Forward pending events then stop the thread.
+		*/
+		~AppenderDispatcher()
+		{
+			{
+				std::lock_guard<std::mutex> lock(this->mutex);
+				this->stopped = true;
+			}
+			this->queueNotEmpty.notify_all();
+			this->queueNotFull.notify_all();
+			if (this->thread.joinable())
+				this->thread.join();
+		}
+
+		/**
+		 * Queue \c events for the appender.
+		 *
+		 * When the queue holds \c maxSize events,
+		 * either wait for space or add the event to discardMap.
+		*/
+		void add(const LoggingEventList& events, size_t maxSize, bool blocking)
+		{
+			{
+				std::unique_lock<std::mutex> lock(this->mutex);
+				for (auto& event : events)
+				{
+					if (blocking && maxSize <= this->queue.size())
+					{
+						this->queueNotEmpty.notify_all();
+						this->queueNotFull.wait(lock, [this, maxSize]()
+						{
+							return this->queue.size() < maxSize || this->stopped;
+						});
+					}
+					if (this->queue.size() < maxSize)
+						this->queue.push_back(event);
+					else
+					{
+						auto loggerName = event->getLoggerName();
+						auto iter = this->discardMap.find(loggerName);
+						if (iter == this->discardMap.end())
+							this->discardMap.insert(DiscardMap::value_type(loggerName, DiscardSummary(event)));
+						else
+							iter->second.add(event);
+					}
+				}
+			}
+			this->queueNotEmpty.notify_all();
+		}
+
+		/**
+		 * Dispatch routine.
+		*/
+		void run()
+		{
+			bool isActive = true;
+			while (isActive)
+			{
+				Pool p;
+				LoggingEventList events;
+				{
+					std::unique_lock<std::mutex> lock(this->mutex);
+					this->queueNotEmpty.wait(lock, [this]()
+					{
+						return !this->queue.empty() || !this->discardMap.empty() || this->stopped;
+					});
+					isActive = !this->stopped;
+					events.assign(this->queue.begin(), this->queue.end());
+					this->queue.clear();
+					for (auto& discardItem : this->discardMap)
+						events.push_back(discardItem.second.createEvent(p));
+					this->discardMap.clear();
+				}
+				this->queueNotFull.notify_all();
+				for (auto& item : events)
+				{
+					try
+					{
+						this->appender->doAppend(item, p);
+					}
+					catch (std::exception& ex)
+					{
+						this->owner.errorHandler->error(LOG4CXX_STR("async dispatcher"), ex, 0, item);
+					}
+					catch (...)
+					{
+						this->owner.errorHandler->error(LOG4CXX_STR("async dispatcher"));
+					}
+				}
+			}
+		}
+
+		AsyncAppenderPriv& owner;
+		AppenderPtr appender;
+		std::mutex mutex;
+		std::condition_variable queueNotEmpty;
+		std::condition_variable queueNotFull;
+		std::deque<LoggingEventPtr> queue;
+		DiscardMap discardMap;
+		bool stopped{false};
+		std::thread thread;
+	};
+	using AppenderDispatcherPtr = std::unique_ptr<AppenderDispatcher>;
+
+	/**
+	 * Does each nested appender have its own thread.
+	 * Read by the dispatch thread, possibly while being set by a configuring thread.
+	*/
+	std::atomic<bool> dispatcherPerAppender{false};
+
+	/**
+	 * The thread used by each nested appender when dispatcherPerAppender is true.
+	 *
+	 * Used only by the dispatch thread (and after it has stopped).
+	*/
+	std::map<AppenderPtr, AppenderDispatcherPtr> appenderDispatchers;
+
+	/**
+	 * Queue \c events for each nested appender's thread.
+	 *
+	 * Called only by the dispatch thread.
+	*/
+	void dispatchToAppenders(const LoggingEventList& events)
+	{
+		auto appenderList = appenders.getAllAppenders();
+		// Stop threads of appenders that are no longer attached
+		for (auto iter = appenderDispatchers.begin(); iter != appenderDispatchers.end();)
+		{
+			if (std::find(appenderList.begin(), appenderList.end(), iter->first) == appenderList.end())
+				iter = appenderDispatchers.erase(iter);
+			else
+				++iter;
+		}
+		for (auto& appender : appenderList)
+		{
+			auto& item = appenderDispatchers[appender];
+			if (!item)
+				item = std::make_unique<AppenderDispatcher>(*this, appender);
+			item->add(events, bufferSize, OverflowPolicy::Block == overflowPolicy);
+		}
 	}
 
 	/**
@@ -189,9 +456,251 @@ struct AsyncAppender::AsyncAppenderPriv : public AppenderSkeleton::AppenderSkele
 	bool locationInfo;
 
 	/**
-	 * Does appender block when buffer is full.
+	 * The action taken when the buffer is full.
+	*/
+	OverflowPolicy overflowPolicy;
+
+	/**
+	 * The lowest level not discarded by OverflowPolicy::DropBelowThreshold.
+	*/
+	LevelPtr overflowThreshold;
+
+	/**
+	 * The path used by OverflowPolicy::SpillToDisk.
+	*/
+	LogString spillFile;
+
+	/**
+	 * Events held in memory until the buffer is empty.
+	*/
+	std::deque<LoggingEventPtr> overflowEvents;
+
+	/**
+	 * Events held in a file until the buffer is empty.
+	 * The file content is older than any event in overflowEvents.
+	*/
+	std::unique_ptr<SpillFile> spill;
+
+	/**
+	 * The number of events in spill.
+	*/
+	size_t spillCount{0};
+
+	/**
+	 * The number of events (taken from overflowEvents) spillWriter is adding to spill.
+	*/
+	size_t spillWritingCount{0};
+
+	/**
+	 * Have all events in spill been forwarded since spillWriter last wrote to it?
+	*/
+	bool spillReplayed{false};
+
+	/**
+	 * Did the last attempt to write to spill fail?
+	*/
+	bool spillFailed{false};
+
+	/**
+	 * Moves overflowing events from memory to spill when using OverflowPolicy::SpillToDisk.
+	*/
+	std::thread spillWriter;
+
+	std::condition_variable spillNeeded;
+
+	/**
+	 * The number of events in overflowEvents plus spillWritingCount plus spillCount.
+	 * When non-zero, events are not added to the buffer (to preserve ordering).
+	*/
+	std::atomic<size_t> overflowCount{0};
+
+	/**
+	 * Hold \c event until the buffer is empty.
+	 *
+	 * Requires bufferMutex to be held.
+	 *
+	 * @return false if \c event was neither held nor discarded because isOverflowFull().
+	*/
+	bool addOverflowEvent(const LoggingEventPtr& event)
+	{
+		if (OverflowPolicy::DropBelowThreshold == overflowPolicy
+			&& !event->getLevel()->isGreaterOrEqual(overflowThreshold))
+		{
+			addDiscardedEvent(event);
+			return true;
+		}
+		if (isOverflowFull())
+			return false;
+		overflowEvents.push_back(event);
+		if (OverflowPolicy::DropOldest == overflowPolicy
+			&& static_cast<size_t>(bufferSize) < overflowEvents.size())
+		{
+			addDiscardedEvent(overflowEvents.front());
+			overflowEvents.pop_front();
+		}
+		else
+			++overflowCount;
+		if (isSpillDue() && !closed)
+		{
+			if (!spillWriter.joinable())
+				spillWriter = ThreadUtility::instance()->createThread(LOG4CXX_STR("AsyncSpill"), &AsyncAppenderPriv::writeSpill, this);
+			spillNeeded.notify_all();
+		}
+		return true;
+	}
+
+	/**
+	 * Must a logging thread wait (as OverflowPolicy::Block does) for overflowEvents to be forwarded?
+	 *
+	 * Requires bufferMutex to be held.
+	*/
+	bool isOverflowFull() const
+	{
+		auto maxCount = static_cast<size_t>(bufferSize);
+		if (OverflowPolicy::SpillToDisk == overflowPolicy)
+		{
+			// Allow events to arrive while spillWriter moves the previous ones to spill
+			if (!spillFile.empty() && !spillFailed)
+				maxCount *= 2;
+		}
+		else if (OverflowPolicy::DropBelowThreshold != overflowPolicy)
+			return false;
+		return maxCount <= overflowEvents.size();
+	}
+
+	/**
+	 * Should spillWriter move overflowEvents to spill?
+	 *
+	 * Requires bufferMutex to be held.
+	*/
+	bool isSpillDue() const
+	{
+		return OverflowPolicy::SpillToDisk == overflowPolicy
+			&& !spillFile.empty()
+			&& !spillFailed
+			&& static_cast<size_t>(bufferSize) <= overflowEvents.size();
+	}
+
+	/**
+	 * The spillWriter routine.
+	 *
+	 * Only this thread writes to or clears spill,
+	 * so file I/O never delays a logging thread.
+	*/
+	void writeSpill()
+	{
+		Pool p;
+		std::unique_lock<std::mutex> lock(bufferMutex);
+		while (true)
+		{
+			spillNeeded.wait(lock, [this]()
+			{
+				return closed || spillReplayed || isSpillDue();
+			});
+			if (closed)
+				break;
+			if (spillReplayed)
+			{
+				spillReplayed = false;
+				lock.unlock();
+				spill->clear(p); // The dispatch thread does not read spill while spillCount is zero
+				lock.lock();
+				spillFailed = false;
+				continue;
+			}
+			LoggingEventList events(std::make_move_iterator(overflowEvents.begin()), std::make_move_iterator(overflowEvents.end()));
+			overflowEvents.clear();
+			spillWritingCount = events.size();
+			if (!spill)
+				spill = std::make_unique<SpillFile>(spillFile);
+			lock.unlock();
+			bool ok = spill->write(events, p);
+			lock.lock();
+			spillWritingCount = 0;
+			if (ok)
+				spillCount += events.size();
+			else
+			{
+				// Hold the events in memory (where they are still newer than the file content)
+				overflowEvents.insert(overflowEvents.begin(), std::make_move_iterator(events.begin()), std::make_move_iterator(events.end()));
+				spillFailed = true;
+			}
+			bufferNotEmpty.notify_all();
+			bufferNotFull.notify_all();
+		}
+	}
+
+	/**
+	 * Add \c event to discardMap.
+	 *
+	 * Requires bufferMutex to be held.
+	*/
+	void addDiscardedEvent(const LoggingEventPtr& event)
+	{
+		LogString loggerName = event->getLoggerName();
+		DiscardMap::iterator iter = discardMap.find(loggerName);
+
+		if (iter == discardMap.end())
+		{
+			DiscardSummary summary(event);
+			discardMap.insert(DiscardMap::value_type(loggerName, summary));
+		}
+		else
+		{
+			(*iter).second.add(event);
+		}
+	}
+
+	/**
+	 * Can the dispatch thread take an event held by addOverflowEvent?
+	 *
+	 * Requires bufferMutex to be held.
 	*/
-	bool blocking;
+	bool isOverflowAvailable() const
+	{
+		// Are events (claimed before the overflow) yet to be committed to the buffer?
+		if (eventCount != dispatchedCount)
+			return false;
+		return 0 < spillCount || (0 == spillWritingCount && !overflowEvents.empty());
+	}
+
+	/**
+	 * Append to \c events up to \c maxCount events held by addOverflowEvent.
+	 *
+	 * Called only by the dispatch thread.
+	*/
+	void takeOverflowEvents(size_t maxCount, LoggingEventList& events)
+	{
+		size_t readCount;
+		{
+			std::lock_guard<std::mutex> lock(bufferMutex);
+			if (!isOverflowAvailable())
+				return;
+			readCount = std::min(maxCount, spillCount);
+		}
+		// Read spilled events without blocking logging threads
+		bool spillOk = (0 == readCount) || spill->read(readCount, events);
+		std::lock_guard<std::mutex> lock(bufferMutex);
+		if (!spillOk)
+			readCount = spillCount;
+		spillCount -= readCount;
+		overflowCount -= readCount;
+		maxCount -= readCount;
+		if (0 < readCount && 0 == spillCount)
+		{
+			// Have spillWriter remove the file content
+			spillReplayed = true;
+			spillNeeded.notify_all();
+		}
+		if (!spillOk || 0 < spillCount || 0 < spillWritingCount)
+			return;
+		for (; 0 < maxCount && !overflowEvents.empty(); --maxCount)
+		{
+			events.push_back(std::move(overflowEvents.front()));
+			overflowEvents.pop_front();
+			--overflowCount;
+		}
+	}
 
 #if LOG4CXX_EVENTS_AT_EXIT
 	helpers::AtExitRegistry::Raii atExitRegistryRaii;
@@ -208,9 +717,66 @@ struct AsyncAppender::AsyncAppenderPriv : public AppenderSkeleton::AppenderSkele
 	alignas(hardware_constructive_interference_size) std::atomic<size_t> dispatchedCount;
 
 	/**
-	 * Used to communicate to the dispatch thread when an event is committed in buffer.
+	 * Is the dispatch thread waiting on bufferNotEmpty?
+	*/
+	alignas(hardware_constructive_interference_size) std::atomic<bool> dispatcherWaiting{false};
+
+	/**
+	 * Replace the event buffer with one of \c size slots,
+	 * retaining any events not yet dispatched.
+	 *
+	 * Requires bufferMutex to be held (or the buffer not yet shared)
+	 * and no logging thread to be concurrently writing a slot.
+	*/
+	void resetBuffer(size_t size)
+	{
+		std::vector<EventData> newBuffer(size);
+		size_t position = dispatchedCount;
+		for (size_t index = 0; index < size; ++index, ++position)
+			newBuffer[position % size].sequence.store(position, std::memory_order_relaxed);
+		for (position = dispatchedCount; isCommitted(position); ++position)
+		{
+			auto& data = buffer[position % buffer.size()];
+			auto& newData = newBuffer[position % size];
+			newData.event = std::move(data.event);
+			newData.pendingCount = data.pendingCount;
+			newData.sequence.store(position + 1, std::memory_order_relaxed);
+		}
+		buffer.swap(newBuffer);
+	}
+
+	/**
+	 * Has the event at \c position been written to the buffer?
+	*/
+	bool isCommitted(size_t position) const
+	{
+		return !buffer.empty()
+			&& buffer[position % buffer.size()].sequence.load(std::memory_order_acquire) == position + 1;
+	}
+
+	/**
+	 * Is there an event the dispatch thread can extract?
+	*/
+	bool isEventAvailable() const
+	{
+		return isCommitted(dispatchedCount.load(std::memory_order_relaxed));
+	}
+
+	/**
+	 * Wake the dispatch thread if (and only if) it is waiting for an event.
 	*/
-	alignas(hardware_constructive_interference_size) std::atomic<size_t> commitCount;
+	void notifyDispatcher()
+	{
+		// Pairs with the fence in AsyncAppender::dispatch()
+		// so either the dispatch thread sees the committed event
+		// or this thread sees dispatcherWaiting is set
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (dispatcherWaiting.load(std::memory_order_relaxed))
+		{
+			std::lock_guard<std::mutex> lock(bufferMutex);
+			bufferNotEmpty.notify_all();
+		}
+	}
 
 	bool isClosed()
 	{
@@ -268,6 +834,37 @@ void AsyncAppender::setOption(const LogString& option,
 	{
 		setBlocking(OptionConverter::toBoolean(value, true));
 	}
+	else if (StringHelper::equalsIgnoreCase(option, LOG4CXX_STR("DISPATCHERPERAPPENDER"), LOG4CXX_STR("dispatcherperappender")))
+	{
+		setDispatcherPerAppender(OptionConverter::toBoolean(value, false));
+	}
+	else if (StringHelper::equalsIgnoreCase(option, LOG4CXX_STR("OVERFLOWPOLICY"), LOG4CXX_STR("overflowpolicy")))
+	{
+		if (StringHelper::equalsIgnoreCase(value, LOG4CXX_STR("DISCARD"), LOG4CXX_STR("discard")))
+			setOverflowPolicy(OverflowPolicy::Discard);
+		else if (StringHelper::equalsIgnoreCase(value, LOG4CXX_STR("DROPOLDEST"), LOG4CXX_STR("dropoldest")))
+			setOverflowPolicy(OverflowPolicy::DropOldest);
+		else if (StringHelper::equalsIgnoreCase(value, LOG4CXX_STR("DROPBELOWTHRESHOLD"), LOG4CXX_STR("dropbelowthreshold")))
+			setOverflowPolicy(OverflowPolicy::DropBelowThreshold);
+		else if (StringHelper::equalsIgnoreCase(value, LOG4CXX_STR("SPILLTODISK"), LOG4CXX_STR("spilltodisk")))
+			setOverflowPolicy(OverflowPolicy::SpillToDisk);
+		else if (StringHelper::equalsIgnoreCase(value, LOG4CXX_STR("BLOCK"), LOG4CXX_STR("block")))
+			setOverflowPolicy(OverflowPolicy::Block);
+		else
+			LogLog::warn(LOG4CXX_STR("Unknown OverflowPolicy [") + value + LOG4CXX_STR("]"));
+	}
+	else if (StringHelper::equalsIgnoreCase(option, LOG4CXX_STR("OVERFLOWTHRESHOLD"), LOG4CXX_STR("overflowthreshold")))
+	{
+		auto level = OptionConverter::toLevel(value, LevelPtr());
+		if (level && 0 < level->toInt())
+			setOverflowThreshold(level);
+		else
+			LogLog::warn(LOG4CXX_STR("Invalid OverflowThreshold [") + value + LOG4CXX_STR("]"));
+	}
+	else if (StringHelper::equalsIgnoreCase(option, LOG4CXX_STR("SPILLFILE"), LOG4CXX_STR("spillfile")))
+	{
+		setSpillFile(value);
+	}
 	else
 	{
 		AppenderSkeleton::setOption(option, value);
@@ -298,41 +895,61 @@ void AsyncAppender::append(const spi::LoggingEventPtr& event, Pool& p)
 	}
 	while (true)
 	{
-		auto pendingCount = priv->eventCount - priv->dispatchedCount;
-		if (0 <= pendingCount && pendingCount < priv->bufferSize)
+		auto oldEventCount = priv->eventCount.load(std::memory_order_relaxed);
+		auto& data = priv->buffer[oldEventCount % priv->buffer.size()];
+		auto sequence = data.sequence.load(std::memory_order_acquire);
+		if (sequence == oldEventCount // Has the dispatch thread freed this slot?
+			&& 0 == priv->overflowCount.load(std::memory_order_relaxed)) // and forwarded all overflowing events?
 		{
-			// Claim a slot in the ring buffer
-			auto oldEventCount = priv->eventCount++;
-			auto index = oldEventCount % priv->buffer.size();
-			// Wait for a free slot
-			while (priv->bufferSize <= oldEventCount - priv->dispatchedCount)
-				std::this_thread::yield(); // Allow the dispatch thread to free a slot
+			// Claim the slot in the ring buffer
+			if (!priv->eventCount.compare_exchange_weak(oldEventCount, oldEventCount + 1, std::memory_order_relaxed))
+				continue; // Another thread claimed it
 			// Write to the ring buffer
-			priv->buffer[index] = AsyncAppenderPriv::EventData{event, pendingCount};
-			// Notify the dispatch thread that an event has been added
-			auto failureCount = 0;
-			auto savedEventCount = oldEventCount;
-			while (!priv->commitCount.compare_exchange_weak(oldEventCount, oldEventCount + 1, std::memory_order_release))
-			{
-				oldEventCount = savedEventCount;
-				if (2 < ++failureCount) // Did the scheduler suspend a thread between claiming a slot and advancing commitCount?
-					std::this_thread::yield(); // Wait a bit
-			}
-			priv->bufferNotEmpty.notify_all();
+			data.event = event;
+			data.pendingCount = oldEventCount - priv->dispatchedCount.load(std::memory_order_relaxed);
+			// Make the event available to the dispatch thread
+			data.sequence.store(oldEventCount + 1, std::memory_order_release);
+			priv->notifyDispatcher();
 			break;
 		}
+		if (oldEventCount < sequence) // Did another thread claim this slot?
+			continue;
 		//
-		//   Following code is only reachable if buffer is full or eventCount has overflowed
+		//   Following code is only reachable if buffer is full
+		//   or overflowing events are yet to be forwarded
 		//
 		std::unique_lock<std::mutex> lock(priv->bufferMutex);
 		priv->bufferNotEmpty.notify_all();
+		if (OverflowPolicy::Block != priv->overflowPolicy
+			&& OverflowPolicy::Discard != priv->overflowPolicy)
+		{
+			if (priv->addOverflowEvent(event))
+				break;
+			// Too many events are held in memory, so wait as OverflowPolicy::Block does
+			if (priv->closed || priv->dispatcher.get_id() == std::this_thread::get_id())
+			{
+				priv->addDiscardedEvent(event);
+				break;
+			}
+			priv->bufferNotFull.wait(lock, [this]()
+			{
+				return priv->closed || !priv->isOverflowFull();
+			});
+			continue;
+		}
+		if (0 < priv->overflowCount) // Was the policy changed while events were held?
+		{
+			priv->overflowEvents.push_back(event);
+			++priv->overflowCount;
+			break;
+		}
 		//
 		//   if blocking and thread is not already interrupted
 		//      and not the dispatcher then
 		//      wait for a buffer notification
 		bool discard = true;
 
-		if (priv->blocking
+		if (OverflowPolicy::Block == priv->overflowPolicy
 			&& !priv->closed
 			&& (priv->dispatcher.get_id() != std::this_thread::get_id()) )
 		{
@@ -351,19 +968,7 @@ void AsyncAppender::append(const spi::LoggingEventPtr& event, Pool& p)
 		//
 		if (discard)
 		{
-			LogString loggerName = event->getLoggerName();
-			DiscardMap::iterator iter = priv->discardMap.find(loggerName);
-
-			if (iter == priv->discardMap.end())
-			{
-				DiscardSummary summary(event);
-				priv->discardMap.insert(DiscardMap::value_type(loggerName, summary));
-			}
-			else
-			{
-				(*iter).second.add(event);
-			}
-
+			priv->addDiscardedEvent(event);
 			break;
 		}
 	}
@@ -372,6 +977,10 @@ void AsyncAppender::append(const spi::LoggingEventPtr& event, Pool& p)
 void AsyncAppender::close()
 {
 	priv->stopDispatcher();
+	{
+		std::lock_guard<std::mutex> lock(priv->bufferMutex);
+		priv->spill.reset();
+	}
 	for (auto item : priv->appenders.getAllAppenders())
 	{
 		item->close();
@@ -433,7 +1042,7 @@ void AsyncAppender::setBufferSize(int size)
 
 	std::lock_guard<std::mutex> lock(priv->bufferMutex);
 	priv->bufferSize = (size < 1) ? 1 : size;
-	priv->buffer.resize(priv->bufferSize);
+	priv->resetBuffer(priv->bufferSize);
 	priv->bufferNotFull.notify_all();
 }
 
@@ -445,13 +1054,66 @@ int AsyncAppender::getBufferSize() const
 void AsyncAppender::setBlocking(bool value)
 {
 	std::lock_guard<std::mutex> lock(priv->bufferMutex);
-	priv->blocking = value;
+	if (value)
+		priv->overflowPolicy = OverflowPolicy::Block;
+	else if (OverflowPolicy::Block == priv->overflowPolicy)
+		priv->overflowPolicy = OverflowPolicy::Discard;
 	priv->bufferNotFull.notify_all();
 }
 
 bool AsyncAppender::getBlocking() const
 {
-	return priv->blocking;
+	return OverflowPolicy::Block == priv->overflowPolicy;
+}
+
+void AsyncAppender::setOverflowPolicy(OverflowPolicy value)
+{
+	std::lock_guard<std::mutex> lock(priv->bufferMutex);
+	priv->overflowPolicy = value;
+	priv->bufferNotFull.notify_all();
+}
+
+AsyncAppender::OverflowPolicy AsyncAppender::getOverflowPolicy() const
+{
+	return priv->overflowPolicy;
+}
+
+void AsyncAppender::setOverflowThreshold(const LevelPtr& level)
+{
+	if (!level || level->toInt() <= 0)
+	{
+		throw IllegalArgumentException(LOG4CXX_STR("level argument must be above ALL"));
+	}
+
+	std::lock_guard<std::mutex> lock(priv->bufferMutex);
+	priv->overflowThreshold = level;
+}
+
+LevelPtr AsyncAppender::getOverflowThreshold() const
+{
+	return priv->overflowThreshold;
+}
+
+void AsyncAppender::setSpillFile(const LogString& path)
+{
+	std::lock_guard<std::mutex> lock(priv->bufferMutex);
+	priv->spillFile = path;
+	priv->spillFailed = false;
+}
+
+LogString AsyncAppender::getSpillFile() const
+{
+	return priv->spillFile;
+}
+
+void AsyncAppender::setDispatcherPerAppender(bool value)
+{
+	priv->dispatcherPerAppender.store(value, std::memory_order_relaxed);
+}
+
+bool AsyncAppender::getDispatcherPerAppender() const
+{
+	return priv->dispatcherPerAppender.load(std::memory_order_relaxed);
 }
 
 DiscardSummary::DiscardSummary(const LoggingEventPtr& event) :
@@ -512,6 +1174,196 @@ DiscardSummary::createEvent(::LOG4CXX_NS::helpers::Pool& p,
 #endif
 
 
+SpillFile::SpillFile(const LogString& path1)
+	: path(path1)
+{
+}
+
+SpillFile::~SpillFile()
+{
+	Pool p;
+	clear(p);
+}
+
+uint32_t SpillFile::getIndex(const LevelPtr& level)
+{
+	std::lock_guard<std::mutex> lock(this->tableMutex);
+	auto pItem = std::find(this->levels.begin(), this->levels.end(), level);
+	if (pItem != this->levels.end())
+		return static_cast<uint32_t>(pItem - this->levels.begin());
+	this->levels.push_back(level);
+	return static_cast<uint32_t>(this->levels.size() - 1);
+}
+
+uint32_t SpillFile::getIndex(const LocationInfo& location)
+{
+	std::lock_guard<std::mutex> lock(this->tableMutex);
+	auto key = std::make_pair(location.getFileName(), location.getLineNumber());
+	auto pItem = this->locationIndex.find(key);
+	if (pItem != this->locationIndex.end())
+		return pItem->second;
+	auto index = static_cast<uint32_t>(this->locations.size());
+	this->locations.push_back(location);
+	this->locationIndex[key] = index;
+	return index;
+}
+
+void SpillFile::putEvent(std::vector<char>& record, const LoggingEventPtr& event)
+{
+	auto start = record.size();
+	record.resize(start + sizeof (uint32_t)); // Space for the record length
+	putValue(record, getIndex(event->getLevel()));
+	putValue(record, getIndex(event->getLocationInformation()));
+	putValue(record, event->getTimeStamp());
+	putString(record, event->getLoggerName());
+	putString(record, event->getMessage());
+	putString(record, event->getThreadName());
+	putString(record, event->getThreadUserName());
+	LogString ndc;
+	event->getNDC(ndc);
+	putString(record, ndc);
+	auto keys = event->getMDCKeySet();
+	putValue(record, keys.size());
+	for (auto& key : keys)
+	{
+		LogString value;
+		event->getMDC(key, value);
+		putString(record, key);
+		putString(record, value);
+	}
+	keys = event->getPropertyKeySet();
+	putValue(record, keys.size());
+	for (auto& key : keys)
+	{
+		LogString value;
+		event->getProperty(key, value);
+		putString(record, key);
+		putString(record, value);
+	}
+	auto length = static_cast<uint32_t>(record.size() - start - sizeof (uint32_t));
+	std::memcpy(&record[start], &length, sizeof (length));
+}
+
+bool SpillFile::write(const LoggingEventList& events, Pool& p)
+{
+	std::vector<char> record;
+	for (auto& event : events)
+		putEvent(record, event);
+	try
+	{
+		if (!this->output)
+			this->output = std::make_shared<FileOutputStream>(this->path, false);
+		ByteBuffer buf(record.data(), record.size());
+		this->output->write(buf, p);
+	}
+	catch (IOException& ex)
+	{
+		LogLog::error(LOG4CXX_STR("Unable to write [") + this->path + LOG4CXX_STR("]"), ex);
+		return false;
+	}
+	return true;
+}
+
+LoggingEventPtr SpillFile::createEvent(const char* data)
+{
+	LevelPtr level;
+	LocationInfo location;
+	{
+		auto levelIndex = getValue<uint32_t>(data);
+		auto locationIndex = getValue<uint32_t>(data);
+		std::lock_guard<std::mutex> lock(this->tableMutex);
+		level = this->levels[levelIndex];
+		location = this->locations[locationIndex];
+	}
+	auto timeStamp = getValue<log4cxx_time_t>(data);
+	auto logger = getString(data);
+	auto message = getString(data);
+	auto threadId = getString(data);
+	auto threadName = getString(data);
+	auto ndc = getString(data);
+	MDC::Map mdc;
+	for (auto count = getValue<KeySet::size_type>(data); 0 < count; --count)
+	{
+		auto key = getString(data);
+		mdc[key] = getString(data);
+	}
+	auto result = std::make_shared<LoggingEvent>(logger, level, location, std::move(message)
+		, timeStamp, threadId, threadName, ndc, mdc);
+	for (auto count = getValue<KeySet::size_type>(data); 0 < count; --count)
+	{
+		auto key = getString(data);
+		result->setProperty(key, getString(data));
+	}
+	return result;
+}
+
+bool SpillFile::read(size_t count, LoggingEventList& events)
+{
+	size_t offset = 0;
+	try
+	{
+		if (!this->input)
+			this->input = std::make_shared<FileInputStream>(this->path);
+		while (0 < count)
+		{
+			uint32_t length = 0;
+			auto available = this->pending.size() - offset;
+			if (sizeof (length) <= available)
+				std::memcpy(&length, &this->pending[offset], sizeof (length));
+			if (available < sizeof (length) || available - sizeof (length) < length)
+			{
+				// Load more of the file
+				this->pending.erase(this->pending.begin(), this->pending.begin() + offset);
+				offset = 0;
+				char chunk[8192];
+				ByteBuffer buf(chunk, sizeof (chunk));
+				if (this->input->read(buf) <= 0)
+					throw IOException(LOG4CXX_STR("Unexpected end of file"));
+				this->pending.insert(this->pending.end(), chunk, chunk + buf.position());
+				continue;
+			}
+			events.push_back(createEvent(&this->pending[offset + sizeof (length)]));
+			offset += sizeof (length) + length;
+			--count;
+		}
+	}
+	catch (IOException& ex)
+	{
+		LogLog::error(LOG4CXX_STR("Unable to read [") + this->path + LOG4CXX_STR("]"), ex);
+		return false;
+	}
+	this->pending.erase(this->pending.begin(), this->pending.begin() + offset);
+	return true;
+}
+
+void SpillFile::clear(Pool& p)
+{
+	if (this->output)
+	{
+		try
+		{
+			this->output->close(p);
+		}
+		catch (IOException&)
+		{
+		}
+		this->output.reset();
+	}
+	if (this->input)
+	{
+		try
+		{
+			this->input->close();
+		}
+		catch (IOException&)
+		{
+		}
+		this->input.reset();
+	}
+	this->pending.clear();
+	File(this->path).deleteFile(p);
+}
+
 void AsyncAppender::dispatch()
 {
 	size_t discardCount = 0;
@@ -523,26 +1375,39 @@ void AsyncAppender::dispatch()
 		Pool p;
 		LoggingEventList events;
 		events.reserve(priv->bufferSize);
-		for (int count = 0; count < 2 && priv->dispatchedCount == priv->commitCount; ++count)
+		for (int count = 0; count < 2 && !priv->isEventAvailable(); ++count)
 			std::this_thread::yield(); // Wait a bit
-		if (priv->dispatchedCount == priv->commitCount)
+		if (!priv->isEventAvailable())
 		{
 			std::unique_lock<std::mutex> lock(priv->bufferMutex);
+			priv->dispatcherWaiting.store(true, std::memory_order_relaxed);
+			// Pairs with the fence in AsyncAppenderPriv::notifyDispatcher()
+			std::atomic_thread_fence(std::memory_order_seq_cst);
 			priv->bufferNotEmpty.wait(lock, [this]() -> bool
-				{ return 0 < priv->blockedCount || priv->dispatchedCount != priv->commitCount || priv->closed; }
-			);
+				{
+					return 0 < priv->blockedCount
+						|| priv->isEventAvailable()
+						|| priv->isOverflowAvailable()
+						|| (priv->closed && 0 == priv->spillWritingCount);
+				});
+			priv->dispatcherWaiting.store(false, std::memory_order_relaxed);
 		}
-		isActive = !priv->isClosed();
+		isActive = !priv->isClosed() || 0 < priv->overflowCount;
 
-		while (events.size() < priv->bufferSize && priv->dispatchedCount != priv->commitCount)
+		while (events.size() < static_cast<size_t>(priv->bufferSize) && priv->isEventAvailable())
 		{
-			auto index = priv->dispatchedCount % priv->buffer.size();
-			const auto& data = priv->buffer[index];
-			events.push_back(data.event);
+			auto position = priv->dispatchedCount.load(std::memory_order_relaxed);
+			auto& data = priv->buffer[position % priv->buffer.size()];
+			events.push_back(std::move(data.event));
 			if (data.pendingCount < pendingCountHistogram.size())
 				++pendingCountHistogram[data.pendingCount];
-			++priv->dispatchedCount;
+			// Allow a logging thread to reuse the slot on the next cycle
+			data.sequence.store(position + priv->buffer.size(), std::memory_order_release);
+			priv->dispatchedCount.store(position + 1, std::memory_order_release);
 		}
+		auto maxEventCount = static_cast<size_t>(priv->bufferSize);
+		if (events.size() < maxEventCount && 0 < priv->overflowCount)
+			priv->takeOverflowEvents(maxEventCount - events.size(), events);
 		priv->bufferNotFull.notify_all();
 		{
 			std::lock_guard<std::mutex> lock(priv->bufferMutex);
@@ -554,6 +1419,13 @@ void AsyncAppender::dispatch()
 			priv->discardMap.clear();
 		}
 
+		if (priv->dispatcherPerAppender.load(std::memory_order_relaxed))
+		{
+			priv->dispatchToAppenders(events);
+			continue;
+		}
+		// Forward events queued while DispatcherPerAppender was set before these
+		priv->appenderDispatchers.clear();
 		for (auto item : events)
 		{
 			try
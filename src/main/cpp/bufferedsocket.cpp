@@ -0,0 +1,214 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <log4cxx/private/bufferedsocket.h>
+#include <log4cxx/private/socket_priv.h>
+#include <log4cxx/helpers/bytebuffer.h>
+#include <log4cxx/helpers/loglog.h>
+#include <log4cxx/helpers/threadutility.h>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace LOG4CXX_NS
+{
+namespace helpers
+{
+
+struct BufferedSocket::BufferedSocketPriv : public Socket::SocketPrivate
+{
+	BufferedSocketPriv(const InetAddressPtr& address, int port, size_t capacity1, std::function<void()> onDisconnect1)
+		: Socket::SocketPrivate(address, port)
+		, capacity(capacity1)
+		, onDisconnect(std::move(onDisconnect1))
+	{}
+
+	const size_t capacity;
+	std::function<void()> onDisconnect;
+	mutable std::mutex mutex;
+	std::condition_variable ready;
+	std::thread thread;
+
+	/**
+	The connection to the remote host, if established.
+	*/
+	SocketPtr connection;
+
+	/**
+	The bytes waiting to be sent.
+	*/
+	std::string pending;
+
+	/**
+	The number of bytes handed to the connection but not yet sent.
+	*/
+	size_t sendingSize{ 0 };
+
+	size_t discardedSize{ 0 };
+
+	/**
+	Has the discarding of bytes been reported?
+	*/
+	bool discarding{ false };
+
+	bool stopping{ false };
+};
+
+#define _priv static_cast<BufferedSocketPriv*>(m_priv.get())
+
+BufferedSocket::BufferedSocket(const InetAddressPtr& address, int port, size_t capacity, std::function<void()> onDisconnect)
+	: Socket(std::make_unique<BufferedSocketPriv>(address, port, capacity, std::move(onDisconnect)))
+{
+	_priv->thread = ThreadUtility::instance()->createThread(LOG4CXX_STR("SocketSender"), &BufferedSocket::run, this);
+}
+
+BufferedSocket::~BufferedSocket()
+{
+	close();
+}
+
+size_t BufferedSocket::write(ByteBuffer& buf)
+{
+	auto size = buf.remaining();
+	bool reportDiscard = false;
+	{
+		std::lock_guard<std::mutex> lock(_priv->mutex);
+		if (_priv->capacity < _priv->pending.size() + size || _priv->stopping)
+		{
+			_priv->discardedSize += size;
+			reportDiscard = !_priv->discarding;
+			_priv->discarding = true;
+		}
+		else
+		{
+			_priv->pending.append(buf.current(), size);
+			_priv->ready.notify_one();
+		}
+	}
+	buf.position(buf.limit());
+	if (reportDiscard)
+		LogLog::warn(LOG4CXX_STR("Discarding logging output: the socket buffer is full"));
+	return size;
+}
+
+void BufferedSocket::close()
+{
+	{
+		std::lock_guard<std::mutex> lock(_priv->mutex);
+		_priv->stopping = true;
+		_priv->ready.notify_one();
+	}
+	if (_priv->thread.joinable())
+		_priv->thread.join();
+	SocketPtr connection;
+	{
+		std::lock_guard<std::mutex> lock(_priv->mutex);
+		connection.swap(_priv->connection);
+	}
+	if (connection)
+	{
+		try
+		{
+			connection->close();
+		}
+		catch (std::exception&)
+		{
+		}
+	}
+}
+
+void BufferedSocket::setConnection(const SocketPtr& connection)
+{
+	std::lock_guard<std::mutex> lock(_priv->mutex);
+	_priv->connection = connection;
+	_priv->ready.notify_one();
+}
+
+bool BufferedSocket::isConnected() const
+{
+	std::lock_guard<std::mutex> lock(_priv->mutex);
+	return !!_priv->connection;
+}
+
+size_t BufferedSocket::getQueuedByteCount() const
+{
+	std::lock_guard<std::mutex> lock(_priv->mutex);
+	return _priv->pending.size() + _priv->sendingSize;
+}
+
+size_t BufferedSocket::getDiscardedByteCount() const
+{
+	std::lock_guard<std::mutex> lock(_priv->mutex);
+	return _priv->discardedSize;
+}
+
+void BufferedSocket::run()
+{
+	std::string sending;
+	std::unique_lock<std::mutex> lock(_priv->mutex);
+	for (;;)
+	{
+		_priv->ready.wait(lock, [this]
+			{ return _priv->stopping || (_priv->connection && !_priv->pending.empty()); }
+			);
+		if (!_priv->connection || _priv->pending.empty())
+			break; // Stopping with nothing that can be sent
+		// Send everything written since the previous send
+		sending.swap(_priv->pending);
+		_priv->sendingSize = sending.size();
+		auto connection = _priv->connection;
+		lock.unlock();
+		bool sent = true;
+		try
+		{
+			ByteBuffer buf(&sending[0], sending.size());
+			connection->write(buf);
+		}
+		catch (std::exception& e)
+		{
+			sent = false;
+			LogLog::warn(LOG4CXX_STR("Detected problem with connection: "), e);
+			try
+			{
+				connection->close();
+			}
+			catch (std::exception&)
+			{
+			}
+		}
+		lock.lock();
+		_priv->sendingSize = 0;
+		if (sent)
+			_priv->discarding = false;
+		else
+		{
+			_priv->discardedSize += sending.size();
+			if (_priv->connection == connection)
+				_priv->connection.reset();
+			if (!_priv->stopping && _priv->onDisconnect)
+			{
+				lock.unlock();
+				_priv->onDisconnect();
+				lock.lock();
+			}
+		}
+		sending.clear();
+	}
+}
+
+} // namespace helpers
+} // namespace log4cxx
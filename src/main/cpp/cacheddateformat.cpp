@@ -21,44 +21,80 @@
 #include <log4cxx/helpers/pool.h>
 #include <limits>
 #include <log4cxx/helpers/exception.h>
+#include <log4cxx/private/log4cxx_private.h>
+#include <atomic>
+#include <mutex>
 
 using namespace LOG4CXX_NS;
 using namespace LOG4CXX_NS::helpers;
 using namespace LOG4CXX_NS::pattern;
 
-struct CachedDateFormat::CachedDateFormatPriv
+namespace
 {
-	CachedDateFormatPriv(DateFormatPtr dateFormat, int expiration1) :
-		formatter(dateFormat),
-		millisecondStart(0),
-		slotBegin(std::numeric_limits<log4cxx_time_t>::min()),
-		cache(50, 0x20),
-		expiration(expiration1),
-		previousTime(std::numeric_limits<log4cxx_time_t>::min())
-	{}
 
+/**
+ *  The state of conversions using one CachedDateFormat.
+ */
+struct CacheState
+{
 	/**
-	 *   Wrapped formatter.
+	 *  The CachedDateFormat instance identifier.
 	 */
-	LOG4CXX_NS::helpers::DateFormatPtr formatter;
+	uint64_t id = 0;
+
+	/**
+	 *  The CachedDateFormat generation when this state was initialized.
+	 */
+	unsigned generation = 0;
 
 	/**
 	 *  Index of initial digit of millisecond pattern or
 	 *   UNRECOGNIZED_MILLISECONDS or NO_MILLISECONDS.
 	 */
-	mutable int millisecondStart;
+	int millisecondStart = 0;
 
 	/**
 	 *  Integral second preceding the previous convered Date.
 	 */
-	mutable log4cxx_time_t slotBegin;
+	log4cxx_time_t slotBegin = std::numeric_limits<log4cxx_time_t>::min();
 
+	/**
+	 *  Date requested in previous conversion.
+	 */
+	log4cxx_time_t previousTime = std::numeric_limits<log4cxx_time_t>::min();
 
 	/**
 	 *  Cache of previous conversion.
 	 */
-	mutable LogString cache;
+	LogString cache;
+
+	void reset(uint64_t newId, unsigned newGeneration)
+	{
+		this->id = newId;
+		this->generation = newGeneration;
+		this->millisecondStart = 0;
+		this->slotBegin = std::numeric_limits<log4cxx_time_t>::min();
+		this->previousTime = std::numeric_limits<log4cxx_time_t>::min();
+	}
+};
 
+std::atomic<uint64_t> nextInstanceId{ 1 };
+
+} // namespace
+
+struct CachedDateFormat::CachedDateFormatPriv
+{
+	CachedDateFormatPriv(DateFormatPtr dateFormat, int expiration1) :
+		formatter(dateFormat),
+		expiration(expiration1),
+		id(nextInstanceId++),
+		generation(0)
+	{}
+
+	/**
+	 *   Wrapped formatter.
+	 */
+	LOG4CXX_NS::helpers::DateFormatPtr formatter;
 
 	/**
 	 *  Maximum validity period for the cache.
@@ -68,9 +104,52 @@ struct CachedDateFormat::CachedDateFormatPriv
 	const int expiration;
 
 	/**
-	 *  Date requested in previous conversion.
+	 *  Identifies the cache state of this instance.
+	 */
+	const uint64_t id;
+
+	/**
+	 *  Incremented when cache state becomes invalid.
 	 */
-	mutable log4cxx_time_t previousTime;
+	std::atomic<unsigned> generation;
+
+#if LOG4CXX_HAS_THREAD_LOCAL
+	enum { ThreadCacheCount = 8 };
+
+	/**
+	 *  The cache state of this instance used by the calling thread.
+	 *
+	 *  Each thread holds the state of a few instances,
+	 *  so conversions on different threads do not interfere.
+	 */
+	CacheState& getState() const
+	{
+		thread_local CacheState states[ThreadCacheCount];
+		auto& result = states[this->id % ThreadCacheCount];
+		auto currentGeneration = this->generation.load(std::memory_order_acquire);
+		if (result.id != this->id || result.generation != currentGeneration)
+			result.reset(this->id, currentGeneration);
+		return result;
+	}
+#else
+	/**
+	 *  Serializes use of sharedState.
+	 */
+	mutable std::mutex mutex;
+
+	/**
+	 *  The cache state used by all threads.
+	 */
+	mutable CacheState sharedState;
+
+	CacheState& getState() const
+	{
+		auto currentGeneration = this->generation.load(std::memory_order_acquire);
+		if (this->sharedState.id != this->id || this->sharedState.generation != currentGeneration)
+			this->sharedState.reset(this->id, currentGeneration);
+		return this->sharedState;
+	}
+#endif
 };
 
 
@@ -242,14 +321,18 @@ int CachedDateFormat::findMillisecondStart(
  */
 void CachedDateFormat::format(LogString& buf, log4cxx_time_t now, Pool& p) const
 {
+#if !LOG4CXX_HAS_THREAD_LOCAL
+	std::lock_guard<std::mutex> lock(m_priv->mutex);
+#endif
+	auto& state = m_priv->getState();
 
 	//
 	// If the current requested time is identical to the previously
 	//     requested time, then append the cache contents.
 	//
-	if (now == m_priv->previousTime)
+	if (now == state.previousTime)
 	{
-		buf.append(m_priv->cache);
+		buf.append(state.cache);
 		return;
 	}
 
@@ -257,28 +340,28 @@ void CachedDateFormat::format(LogString& buf, log4cxx_time_t now, Pool& p) const
 	//   If millisecond pattern was not unrecognized
 	//     (that is if it was found or milliseconds did not appear)
 	//
-	if (m_priv->millisecondStart != UNRECOGNIZED_MILLISECONDS)
+	if (state.millisecondStart != UNRECOGNIZED_MILLISECONDS)
 	{
 		//    Check if the cache is still valid.
 		//    If the requested time is within the same integral second
 		//       as the last request and a shorter expiration was not requested.
-		if (now < m_priv->slotBegin + m_priv->expiration
-			&& now >= m_priv->slotBegin
-			&& now < m_priv->slotBegin + 1000000L)
+		if (now < state.slotBegin + m_priv->expiration
+			&& now >= state.slotBegin
+			&& now < state.slotBegin + 1000000L)
 		{
 			//
 			//    if there was a millisecond field then update it
 			//
-			if (m_priv->millisecondStart >= 0)
+			if (state.millisecondStart >= 0)
 			{
-				millisecondFormat((int) ((now - m_priv->slotBegin) / 1000), m_priv->cache, m_priv->millisecondStart);
+				millisecondFormat((int) ((now - state.slotBegin) / 1000), state.cache, state.millisecondStart);
 			}
 
 			//
 			//   update the previously requested time
 			//      (the slot begin should be unchanged)
-			m_priv->previousTime = now;
-			buf.append(m_priv->cache);
+			state.previousTime = now;
+			buf.append(state.cache);
 
 			return;
 		}
@@ -287,24 +370,24 @@ void CachedDateFormat::format(LogString& buf, log4cxx_time_t now, Pool& p) const
 	//
 	//  could not use previous value.
 	//    Call underlying formatter to format date.
-	m_priv->cache.erase(m_priv->cache.begin(), m_priv->cache.end());
-	m_priv->formatter->format(m_priv->cache, now, p);
-	buf.append(m_priv->cache);
-	m_priv->previousTime = now;
-	m_priv->slotBegin = (m_priv->previousTime / 1000000) * 1000000;
+	state.cache.erase(state.cache.begin(), state.cache.end());
+	m_priv->formatter->format(state.cache, now, p);
+	buf.append(state.cache);
+	state.previousTime = now;
+	state.slotBegin = (state.previousTime / 1000000) * 1000000;
 
-	if (m_priv->slotBegin > m_priv->previousTime)
+	if (state.slotBegin > state.previousTime)
 	{
-		m_priv->slotBegin -= 1000000;
+		state.slotBegin -= 1000000;
 	}
 
 	//
 	//    if the milliseconds field was previous found
 	//       then reevaluate in case it moved.
 	//
-	if (m_priv->millisecondStart >= 0)
+	if (state.millisecondStart >= 0)
 	{
-		m_priv->millisecondStart = findMillisecondStart(now, m_priv->cache, m_priv->formatter, p);
+		state.millisecondStart = findMillisecondStart(now, state.cache, m_priv->formatter, p);
 	}
 }
 
@@ -334,8 +417,7 @@ void CachedDateFormat::millisecondFormat(int millis,
 void CachedDateFormat::setTimeZone(const TimeZonePtr& timeZone)
 {
 	m_priv->formatter->setTimeZone(timeZone);
-	m_priv->previousTime = std::numeric_limits<log4cxx_time_t>::min();
-	m_priv->slotBegin = std::numeric_limits<log4cxx_time_t>::min();
+	++m_priv->generation;
 }
 
 
@@ -0,0 +1,135 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <log4cxx/spi/callsite.h>
+#include <log4cxx/helpers/widelife.h>
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+using namespace LOG4CXX_NS;
+using namespace LOG4CXX_NS::spi;
+
+namespace
+{
+std::atomic<unsigned> generation{1};
+
+struct Override
+{
+	std::string fileName;
+	int lineNumber;
+	bool enabled;
+};
+
+struct Overrides
+{
+	std::mutex mutex;
+	std::vector<Override> items;
+	std::atomic<bool> empty{true};
+};
+
+Overrides& getOverrides()
+{
+	static helpers::WideLife<Overrides> overrides;
+	return overrides;
+}
+
+/**
+ * Does \c path name the file \c name or a file \c name in some directory?
+ */
+bool isFileName(const char* path, const std::string& name)
+{
+	auto pathLength = std::strlen(path);
+	if (pathLength < name.size())
+		return false;
+	auto start = path + (pathLength - name.size());
+	if (0 != name.compare(start))
+		return false;
+	return start == path || '/' == start[-1] || '\\' == start[-1];
+}
+
+} // namespace
+
+void CallSite::invalidateAll()
+{
+	generation.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void CallSite::setEnabled(const std::string& fileName, int lineNumber, bool enabled)
+{
+	auto& overrides = getOverrides();
+	{
+		std::lock_guard<std::mutex> lock(overrides.mutex);
+		auto pItem = std::find_if(overrides.items.begin(), overrides.items.end()
+			, [&fileName, lineNumber](const Override& item)
+			{ return item.lineNumber == lineNumber && item.fileName == fileName; }
+			);
+		if (overrides.items.end() == pItem)
+			overrides.items.push_back(Override{fileName, lineNumber, enabled});
+		else
+			pItem->enabled = enabled;
+		overrides.empty = false;
+	}
+	invalidateAll();
+}
+
+void CallSite::removeAllOverrides()
+{
+	auto& overrides = getOverrides();
+	{
+		std::lock_guard<std::mutex> lock(overrides.mutex);
+		overrides.items.clear();
+		overrides.empty = true;
+	}
+	invalidateAll();
+}
+
+bool CallSite::refresh(const LoggerPtr& logger, int level)
+{
+	// Only one thread at a time stores a new state,
+	// others compute their result without storing it
+	auto oldState = m_state.load(std::memory_order_relaxed);
+	bool isOwner = 0 == (oldState & Updating)
+		&& m_state.compare_exchange_strong(oldState, (oldState & SequenceMask) | Updating, std::memory_order_relaxed);
+	if (isOwner)
+		std::atomic_thread_fence(std::memory_order_release);
+	// Use the generation current before the state is computed
+	// so a concurrent change causes it to be computed again
+	auto newState = (uint64_t)generation.load(std::memory_order_acquire) << GenerationShift | Valid;
+	bool result = logger && logger->isEnabledFor(Level::toLevel(level));
+	auto& overrides = getOverrides();
+	if (!overrides.empty)
+	{
+		std::lock_guard<std::mutex> lock(overrides.mutex);
+		for (auto& item : overrides.items)
+		{
+			if (item.lineNumber == m_lineNumber && isFileName(m_fileName, item.fileName))
+				result = item.enabled;
+		}
+	}
+	if (isOwner)
+	{
+		if (result)
+			newState |= Enabled;
+		newState |= (oldState + SequenceStep) & SequenceMask;
+		m_logger.store(logger.get(), std::memory_order_relaxed);
+		m_state.store(newState, std::memory_order_release);
+		m_generation.store(&generation, std::memory_order_release);
+	}
+	return result;
+}
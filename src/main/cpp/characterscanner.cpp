@@ -0,0 +1,106 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <log4cxx/private/characterscanner.h>
+#include <algorithm>
+#if LOG4CXX_LOGCHAR_IS_UTF8 && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+	#define LOG4CXX_SCAN_USING_SSE2 1
+	#include <immintrin.h>
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+	#endif
+#else
+	#define LOG4CXX_SCAN_USING_SSE2 0
+#endif
+
+using namespace LOG4CXX_NS;
+using namespace LOG4CXX_NS::helpers;
+
+namespace
+{
+
+#if LOG4CXX_SCAN_USING_SSE2
+/**
+ * The index of the least significant bit set in \c mask, which must not be zero.
+ */
+inline int firstBit(unsigned int mask)
+{
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanForward(&index, mask);
+	return int(index);
+#else
+	return __builtin_ctz(mask);
+#endif
+}
+#endif
+
+} // namespace
+
+CharacterScanner::CharacterScanner(std::initializer_list<logchar> specials)
+	: m_count(int(std::min<size_t>(specials.size(), MaxCount)))
+{
+	std::copy(specials.begin(), specials.begin() + m_count, m_specials);
+}
+
+const logchar* CharacterScanner::find(const logchar* begin, const logchar* end) const
+{
+	auto p = begin;
+#if LOG4CXX_SCAN_USING_SSE2
+#if defined(__AVX2__)
+	if (32 <= end - p)
+	{
+		__m256i needles[MaxCount];
+		for (int i = 0; i < m_count; ++i)
+			needles[i] = _mm256_set1_epi8(m_specials[i]);
+		for (; 32 <= end - p; p += 32)
+		{
+			auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+			auto hit = _mm256_cmpeq_epi8(block, needles[0]);
+			for (int i = 1; i < m_count; ++i)
+				hit = _mm256_or_si256(hit, _mm256_cmpeq_epi8(block, needles[i]));
+			if (auto mask = static_cast<unsigned int>(_mm256_movemask_epi8(hit)))
+				return p + firstBit(mask);
+		}
+	}
+#endif
+	if (16 <= end - p)
+	{
+		__m128i needles[MaxCount];
+		for (int i = 0; i < m_count; ++i)
+			needles[i] = _mm_set1_epi8(m_specials[i]);
+		for (; 16 <= end - p; p += 16)
+		{
+			auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+			auto hit = _mm_cmpeq_epi8(block, needles[0]);
+			for (int i = 1; i < m_count; ++i)
+				hit = _mm_or_si128(hit, _mm_cmpeq_epi8(block, needles[i]));
+			if (auto mask = static_cast<unsigned int>(_mm_movemask_epi8(hit)))
+				return p + firstBit(mask);
+		}
+	}
+#endif
+	for (; p < end; ++p)
+	{
+		for (int i = 0; i < m_count; ++i)
+		{
+			if (*p == m_specials[i])
+				return p;
+		}
+	}
+	return end;
+}
@@ -26,6 +26,7 @@
 	#define LOG4CXX 1
 #endif
 #include <log4cxx/private/log4cxx_private.h>
+#include <log4cxx/private/singlebyterun.h>
 #include <locale.h>
 #include <apr_portable.h>
 #include <log4cxx/helpers/stringhelper.h>
@@ -294,6 +295,13 @@ class UTF8CharsetDecoder : public CharsetDecoder
 
 				while (iter != tmp.end())
 				{
+					SingleByteRun::append(tmp, iter, out);
+
+					if (iter == tmp.end())
+					{
+						break;
+					}
+
 					unsigned int sv = Transcoder::decode(tmp, iter);
 
 					if (sv == 0xFFFF)
@@ -342,13 +350,20 @@ class ISOLatinCharsetDecoder : public CharsetDecoder
 			if (in.remaining() > 0)
 			{
 
-				const unsigned char* src = (unsigned char*) in.current();
-				const unsigned char* srcEnd = src + in.remaining();
+				const char* src = in.current();
+				const char* srcEnd = src + in.remaining();
 
 				while (src < srcEnd)
 				{
-					unsigned int sv = *(src++);
-					Transcoder::encode(sv, out);
+					auto count = SingleByteRun::length(src, srcEnd, 0x80);
+					SingleByteRun::append(src, src + count, out);
+					src += count;
+
+					if (src < srcEnd)
+					{
+						unsigned int sv = (unsigned char) *(src++);
+						Transcoder::encode(sv, out);
+					}
 				}
 
 				in.position(in.limit());
@@ -390,26 +405,19 @@ class USASCIICharsetDecoder : public CharsetDecoder
 			if (in.remaining() > 0)
 			{
 
-				const unsigned char* src = (unsigned char*) in.current();
-				const unsigned char* srcEnd = src + in.remaining();
+				const char* src = in.current();
+				const char* srcEnd = src + in.remaining();
 
-				while (src < srcEnd)
-				{
-					unsigned char sv = *src;
+				auto count = SingleByteRun::length(src, srcEnd, 0x80);
+				SingleByteRun::append(src, src + count, out);
+				src += count;
 
-					if (sv < 0x80)
-					{
-						src++;
-						Transcoder::encode(sv, out);
-					}
-					else
-					{
-						stat = APR_BADARG;
-						break;
-					}
+				if (src < srcEnd)
+				{
+					stat = APR_BADARG;
 				}
 
-				in.position(src - (const unsigned char*) in.data());
+				in.position(src - in.data());
 			}
 
 			return stat;
@@ -441,10 +449,11 @@ class LocaleCharsetDecoder : public CharsetDecoder
 			if (std::mbsinit(&this->state)) // ByteBuffer not partially decoded?
 			{
 				// Copy single byte characters
-				for (; 0 < remain && ((unsigned int) *p) < 0x80; --remain, ++i, p++)
-				{
-					out.append(1, *p);
-				}
+				auto count = SingleByteRun::length(p, p + remain, 0x80);
+				SingleByteRun::append(p, p + count, out);
+				remain -= count;
+				i += count;
+				p += count;
 			}
 #endif
 			// Decode characters that may be represented by multiple bytes
@@ -28,6 +28,7 @@
 #endif
 
 #include <log4cxx/private/log4cxx_private.h>
+#include <log4cxx/private/singlebyterun.h>
 #include <apr_portable.h>
 #include <mutex>
 
@@ -212,6 +213,25 @@ class WcstombsCharsetEncoder : public CharsetEncoder
 #endif
 
 
+/**
+*   Copy the characters less than \c limit that start at \c iter
+*   without decoding each character.
+*/
+static void copySingleByteCharacters
+	( const LogString&           in
+	, LogString::const_iterator& iter
+	, ByteBuffer&                out
+	, unsigned int               limit
+	)
+{
+	auto begin = in.data() + (iter - in.begin());
+	auto end = begin + std::min(size_t(in.end() - iter), out.remaining());
+	auto count = SingleByteRun::length(begin, end, limit);
+	SingleByteRun::copy(begin, begin + count, out.current());
+	out.position(out.position() + count);
+	iter += count;
+}
+
 /**
 *   Encodes a LogString to US-ASCII.
 */
@@ -230,6 +250,7 @@ class USASCIICharsetEncoder : public CharsetEncoder
 
 			if (iter != in.end())
 			{
+				copySingleByteCharacters(in, iter, out, 0x80);
 				while (out.remaining() > 0 && iter != in.end())
 				{
 					LogString::const_iterator prev(iter);
@@ -274,6 +295,11 @@ class ISOLatinCharsetEncoder : public CharsetEncoder
 
 			if (iter != in.end())
 			{
+#if LOG4CXX_LOGCHAR_IS_UTF8
+				copySingleByteCharacters(in, iter, out, 0x80);
+#else
+				copySingleByteCharacters(in, iter, out, 0x100);
+#endif
 				while (out.remaining() > 0 && iter != in.end())
 				{
 					LogString::const_iterator prev(iter);
@@ -356,6 +382,7 @@ class UTF8CharsetEncoder : public CharsetEncoder
 			LogString::const_iterator& iter,
 			ByteBuffer& out)
 		{
+			copySingleByteCharacters(in, iter, out, 0x80);
 			while (iter != in.end() && out.remaining() >= 8)
 			{
 				unsigned int sv = Transcoder::decode(in, iter);
@@ -39,6 +39,7 @@
 	#include <log4cxx/nt/outputdebugstringappender.h>
 #endif
 #include <log4cxx/net/smtpappender.h>
+#include <log4cxx/rolling/mappedfileappender.h>
 #if LOG4CXX_HAS_MULTIPROCESS_ROLLING_FILE_APPENDER
 #include <log4cxx/rolling/multiprocessrollingfileappender.h>
 #endif
@@ -202,6 +203,7 @@ void Class::registerClasses()
 	StringMatchFilter::registerClass();
 	LocationInfoFilter::registerClass();
 	LOG4CXX_NS::rolling::RollingFileAppender::registerClass();
+	LOG4CXX_NS::rolling::MappedFileAppender::registerClass();
 #if LOG4CXX_HAS_MULTIPROCESS_ROLLING_FILE_APPENDER
 	LOG4CXX_NS::rolling::MultiprocessRollingFileAppender::registerClass();
 #endif
@@ -0,0 +1,51 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <log4cxx/spi/deferredmessage.h>
+#include <log4cxx/private/recyclingallocator.h>
+
+using namespace LOG4CXX_NS;
+using namespace LOG4CXX_NS::spi;
+using namespace LOG4CXX_NS::helpers;
+
+DeferredMessage::~DeferredMessage()
+{
+}
+
+// Blocks are recycled in a few size classes, larger instances use the heap
+void* DeferredMessage::operator new(std::size_t size)
+{
+	if (size <= 64)
+		return RecycledBlocks<64>::allocate();
+	if (size <= 128)
+		return RecycledBlocks<128>::allocate();
+	if (size <= 256)
+		return RecycledBlocks<256>::allocate();
+	return ::operator new(size);
+}
+
+void DeferredMessage::operator delete(void* p, std::size_t size)
+{
+	if (size <= 64)
+		RecycledBlocks<64>::deallocate(p);
+	else if (size <= 128)
+		RecycledBlocks<128>::deallocate(p);
+	else if (size <= 256)
+		RecycledBlocks<256>::deallocate(p);
+	else
+		::operator delete(p);
+}
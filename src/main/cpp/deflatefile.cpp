@@ -0,0 +1,104 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <log4cxx/logstring.h>
+#include <log4cxx/private/deflatefile.h>
+#include <log4cxx/helpers/exception.h>
+#include <apr_file_io.h>
+#include <zlib.h>
+#include <vector>
+
+using namespace LOG4CXX_NS;
+using namespace LOG4CXX_NS::rolling;
+using namespace LOG4CXX_NS::helpers;
+
+namespace
+{
+
+const uInt chunkSize = 64 * 1024;
+
+/**
+ * A zlib compression stream that is released on destruction.
+ */
+struct DeflateStream : public z_stream
+{
+	DeflateStream(int level, int windowBits) : z_stream{}
+	{
+		if (Z_OK != deflateInit2(this, level, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY))
+			throw IOException(LOG4CXX_STR("zlib initialization failed"));
+	}
+
+	~DeflateStream()
+	{
+		deflateEnd(this);
+	}
+};
+
+} // namespace
+
+DeflateSummary LOG4CXX_NS::rolling::deflateFile
+	( apr_file_t* source
+	, apr_file_t* destination
+	, int         level
+	, const char* gzipName
+	, uint32_t    modificationTime
+	)
+{
+	DeflateStream zs(level, gzipName ? MAX_WBITS + 16 : -MAX_WBITS);
+	gz_header header{};
+	if (gzipName)
+	{
+		header.name = (Bytef*)gzipName;
+		header.time = modificationTime;
+		header.os = 255; // unknown
+		deflateSetHeader(&zs, &header);
+	}
+	std::vector<Bytef> input(chunkSize), output(chunkSize);
+	DeflateSummary result{ (uint32_t)crc32(0, Z_NULL, 0), 0, 0 };
+	int flush = Z_NO_FLUSH;
+	while (Z_NO_FLUSH == flush)
+	{
+		apr_size_t byteCount = chunkSize;
+		apr_status_t stat = apr_file_read(source, input.data(), &byteCount);
+		if (APR_STATUS_IS_EOF(stat))
+		{
+			flush = Z_FINISH;
+			byteCount = 0;
+		}
+		else if (stat != APR_SUCCESS)
+			throw IOException(stat);
+		result.crc = (uint32_t)crc32(result.crc, input.data(), (uInt)byteCount);
+		result.inputSize += byteCount;
+		zs.next_in = input.data();
+		zs.avail_in = (uInt)byteCount;
+		do
+		{
+			zs.next_out = output.data();
+			zs.avail_out = chunkSize;
+			deflate(&zs, flush);
+			apr_size_t outputCount = chunkSize - zs.avail_out;
+			if (0 < outputCount)
+			{
+				stat = apr_file_write_full(destination, output.data(), outputCount, NULL);
+				if (stat != APR_SUCCESS)
+					throw IOException(stat);
+				result.outputSize += outputCount;
+			}
+		} while (0 == zs.avail_out);
+	}
+	return result;
+}
@@ -28,6 +28,7 @@
 #include "log4cxx/helpers/threadutility.h"
 #include <log4cxx/private/writerappender_priv.h>
 #include <log4cxx/private/fileappender_priv.h>
+#include <log4cxx/private/groupcommitoutputstream.h>
 #include <mutex>
 
 using namespace LOG4CXX_NS;
@@ -84,6 +85,7 @@ FileAppender::~FileAppender()
 	finalize();
 	if (auto p = _priv->taskManager.lock())
 		p->value().removePeriodicTask(getName());
+	_priv->removeGroupCommitTask();
 }
 
 void FileAppender::setAppend(bool fileAppend1)
@@ -148,6 +150,11 @@ void FileAppender::setOption(const LogString& option,
 		std::lock_guard<std::recursive_mutex> lock(_priv->mutex);
 		_priv->bufferedSeconds = OptionConverter::toInt(value, 0);
 	}
+	else if (StringHelper::equalsIgnoreCase(option, LOG4CXX_STR("GROUPCOMMITMILLISECONDS"), LOG4CXX_STR("groupcommitmilliseconds")))
+	{
+		std::lock_guard<std::recursive_mutex> lock(_priv->mutex);
+		_priv->groupCommitMilliseconds = OptionConverter::toInt(value, 0);
+	}
 	else
 	{
 		WriterAppender::setOption(option, value);
@@ -291,8 +298,8 @@ void FileAppender::setFileInternal(
 	size_t bufferSize1,
 	Pool& p)
 {
-	// It does not make sense to have immediate flush and bufferedIO.
-	if (bufferedIO1)
+	// It does not make sense to have immediate flush and bufferedIO or group commit.
+	if (bufferedIO1 || 0 < _priv->groupCommitMilliseconds)
 	{
 		setImmediateFlush(false);
 	}
@@ -323,7 +330,7 @@ void FileAppender::setFileInternal(
 
 	try
 	{
-		outStream = FileOutputStreamPtr(new FileOutputStream(filename, append1));
+		outStream = _priv->createOutputStream(filename, append1);
 	}
 	catch (IOException&)
 	{
@@ -336,7 +343,7 @@ void FileAppender::setFileInternal(
 
 			if (!parentDir.exists(p) && parentDir.mkdirs(p))
 			{
-				outStream = OutputStreamPtr(new FileOutputStream(filename, append1));
+				outStream = _priv->createOutputStream(filename, append1);
 			}
 			else
 			{
@@ -360,6 +367,7 @@ void FileAppender::setFileInternal(
 		outStream->write(buf, p);
 	}
 
+	outStream = _priv->createGroupCommitStream(outStream, bufferSize1);
 	WriterPtr newWriter(createWriter(outStream));
 
 	if (bufferedIO1)
@@ -397,6 +405,11 @@ int FileAppender::getBufferedSeconds() const
 	return _priv->bufferedSeconds;
 }
 
+int FileAppender::getGroupCommitMilliseconds() const
+{
+	return _priv->groupCommitMilliseconds;
+}
+
 void FileAppender::setBufferSize(int newValue)
 {
 	_priv->bufferSize = newValue;
@@ -407,7 +420,56 @@ void FileAppender::setBufferedSeconds(int newValue)
 	_priv->bufferedSeconds = newValue;
 }
 
+void FileAppender::setGroupCommitMilliseconds(int newValue)
+{
+	_priv->groupCommitMilliseconds = newValue;
+}
+
 bool FileAppender::getAppend() const
 {
 	return _priv->fileAppend;
 }
+
+OutputStreamPtr FileAppender::FileAppenderPriv::createOutputStream(const LogString& fileName, bool append)
+{
+	return std::make_shared<FileOutputStream>(fileName, append);
+}
+
+OutputStreamPtr FileAppender::FileAppenderPriv::createGroupCommitStream(const OutputStreamPtr& out, size_t batchSize)
+{
+	removeGroupCommitTask();
+	if (this->groupCommitMilliseconds <= 0)
+		return out;
+	auto result = std::make_shared<GroupCommitOutputStream>(out, 0 < batchSize ? batchSize : 8 * 1024);
+	std::weak_ptr<GroupCommitOutputStream> weakStream(result);
+	auto taskManager = ThreadUtility::instancePtr();
+	taskManager->value().addPeriodicTask(groupCommitTaskName()
+		, [weakStream, taskName = groupCommitTaskName()]()
+		{
+			if (auto stream = weakStream.lock())
+			{
+				Pool p;
+				try
+				{
+					stream->commit(p);
+				}
+				catch (std::exception& ex)
+				{
+					// Report subsequent failures through the appender's error handler
+					LogLog::warn(taskName + LOG4CXX_STR(" failed, writing each event instead"), ex);
+					stream->setCommitEachWrite();
+				}
+			}
+		}
+		, std::chrono::milliseconds(this->groupCommitMilliseconds)
+		);
+	this->groupCommitTaskManager = taskManager;
+	return result;
+}
+
+void FileAppender::FileAppenderPriv::removeGroupCommitTask()
+{
+	if (auto p = this->groupCommitTaskManager.lock())
+		p->value().removePeriodicTask(groupCommitTaskName());
+	this->groupCommitTaskManager.reset();
+}
@@ -48,6 +48,7 @@ struct FixedWindowRollingPolicy::FixedWindowRollingPolicyPrivate : public Rollin
 	int maxIndex;
 	bool explicitActiveFile;
 	bool throwIOExceptionOnForkFailure = true;
+	int compressionLevel = -1;
 };
 
 IMPLEMENT_LOG4CXX_OBJECT(FixedWindowRollingPolicy)
@@ -90,6 +91,20 @@ void FixedWindowRollingPolicy::setOption(const LogString& option,
 	{
 		priv->throwIOExceptionOnForkFailure = OptionConverter::toBoolean(value, true);
 	}
+	else if (StringHelper::equalsIgnoreCase(option,
+			LOG4CXX_STR("COMPRESSIONLEVEL"),
+			LOG4CXX_STR("compressionlevel")))
+	{
+		int level = OptionConverter::toInt(value, -2);
+		if (level < -1 || 9 < level)
+		{
+			LogLog::warn(LOG4CXX_STR("Invalid CompressionLevel [") + value + LOG4CXX_STR("]"));
+		}
+		else
+		{
+			priv->compressionLevel = level;
+		}
+	}
 	else
 	{
 		RollingPolicyBase::setOption(option, value);
@@ -203,6 +218,7 @@ RolloverDescriptionPtr FixedWindowRollingPolicy::rollover(
 					File().setPath(compressedName),
 					true);
 		comp->setThrowIOExceptionOnForkFailure(priv->throwIOExceptionOnForkFailure);
+		comp->setCompressionLevel(priv->compressionLevel);
 		compressAction = comp;
 	}
 	else if (StringHelper::endsWith(renameTo, LOG4CXX_STR(".zip")))
@@ -213,6 +229,7 @@ RolloverDescriptionPtr FixedWindowRollingPolicy::rollover(
 					File().setPath(compressedName),
 					true);
 		comp->setThrowIOExceptionOnForkFailure(priv->throwIOExceptionOnForkFailure);
+		comp->setCompressionLevel(priv->compressionLevel);
 		compressAction = comp;
 	}
 
@@ -30,6 +30,178 @@
 using namespace LOG4CXX_NS;
 using namespace LOG4CXX_NS::spi;
 
+namespace
+{
+
+/**
+ * A part of the conversion pattern.
+ */
+struct PatternField
+{
+	enum Kind
+	{
+		Literal,
+		Date,
+		Logger,
+		ShortFileName,
+		FileName,
+		Location,
+		Line,
+		Message,
+		Method,
+		NewLine,
+		Level,
+		RelativeTime,
+		Thread,
+		NDC
+	};
+	Kind kind;
+
+	/**
+	 * The text of a Literal field.
+	 */
+	LogString literal;
+
+	/**
+	 * The {fmt} format string (e.g. "{:<5}") when a format specification is provided.
+	 */
+	std::string format;
+};
+using PatternFieldList = std::vector<PatternField>;
+
+/**
+ * Append \c value to \c output using \c format (or the default format when empty).
+ */
+template <typename T>
+void appendField(LogString& output, const std::string& format, const T& value)
+{
+	if (format.empty())
+		fmt::format_to(std::back_inserter(output), "{}", value);
+	else
+		fmt::format_to(std::back_inserter(output), fmt::runtime(format), value);
+}
+
+void appendField(LogString& output, const std::string& format, const LogString& value)
+{
+#if LOG4CXX_LOGCHAR_IS_UTF8
+	if (format.empty())
+		output.append(value);
+	else
+		fmt::format_to(std::back_inserter(output), fmt::runtime(format), value);
+#else
+	LOG4CXX_ENCODE_CHAR(sValue, value);
+	appendField<std::string>(output, format, sValue);
+#endif
+}
+
+/**
+ * The field named \c name.
+ * @return false if \c name is not a recognized field name.
+ */
+bool getFieldKind(const std::string& name, PatternField::Kind& kind)
+{
+	static const struct
+	{
+		const char* name;
+		PatternField::Kind kind;
+	} names[] =
+	{ { "d", PatternField::Date }
+	, { "c", PatternField::Logger }
+	, { "logger", PatternField::Logger }
+	, { "f", PatternField::ShortFileName }
+	, { "shortfilename", PatternField::ShortFileName }
+	, { "F", PatternField::FileName }
+	, { "filename", PatternField::FileName }
+	, { "l", PatternField::Location }
+	, { "location", PatternField::Location }
+	, { "L", PatternField::Line }
+	, { "line", PatternField::Line }
+	, { "m", PatternField::Message }
+	, { "message", PatternField::Message }
+	, { "M", PatternField::Method }
+	, { "method", PatternField::Method }
+	, { "n", PatternField::NewLine }
+	, { "newline", PatternField::NewLine }
+	, { "p", PatternField::Level }
+	, { "level", PatternField::Level }
+	, { "r", PatternField::RelativeTime }
+	, { "t", PatternField::Thread }
+	, { "thread", PatternField::Thread }
+	, { "T", PatternField::Thread }
+	, { "threadname", PatternField::Thread }
+	, { "x", PatternField::NDC }
+	, { "ndc", PatternField::NDC }
+	};
+	for (auto& item : names)
+	{
+		if (name == item.name)
+		{
+			kind = item.kind;
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Append to \c fields the parts of \c pattern.
+ * @return false if \c pattern uses a feature that requires {fmt} to parse the pattern for each event.
+ */
+bool parsePattern(const std::string& pattern, PatternFieldList& fields)
+{
+	std::string literal;
+	auto addLiteral = [&literal, &fields]()
+	{
+		if (!literal.empty())
+		{
+			PatternField field{ PatternField::Literal };
+			LOG4CXX_NS::helpers::Transcoder::decode(literal, field.literal);
+			fields.push_back(std::move(field));
+			literal.clear();
+		}
+	};
+	for (size_t i = 0; i < pattern.size(); ++i)
+	{
+		auto c = pattern[i];
+		if ('{' == c && i + 1 < pattern.size() && '{' == pattern[i + 1])
+		{
+			literal += c;
+			++i;
+		}
+		else if ('}' == c && i + 1 < pattern.size() && '}' == pattern[i + 1])
+		{
+			literal += c;
+			++i;
+		}
+		else if ('{' == c)
+		{
+			auto endIndex = pattern.find('}', i + 1);
+			if (pattern.npos == endIndex)
+				return false;
+			auto replacement = pattern.substr(i + 1, endIndex - i - 1);
+			if (replacement.npos != replacement.find('{')) // A nested replacement field?
+				return false;
+			auto specIndex = replacement.find(':');
+			PatternField field{ PatternField::Literal };
+			if (!getFieldKind(replacement.substr(0, specIndex), field.kind))
+				return false;
+			if (replacement.npos != specIndex)
+				field.format = "{" + replacement.substr(specIndex) + "}";
+			addLiteral();
+			fields.push_back(std::move(field));
+			i = endIndex;
+		}
+		else if ('}' == c)
+			return false;
+		else
+			literal += c;
+	}
+	addLiteral();
+	return true;
+}
+
+} // namespace
+
 struct FMTLayout::FMTLayoutPrivate{
 	FMTLayoutPrivate()
 		: expectedPatternLength(100)
@@ -44,6 +216,18 @@ struct FMTLayout::FMTLayoutPrivate{
 
 	// Expected length of a formatted event excluding the message text
 	size_t expectedPatternLength;
+
+	// The parts of conversionPattern
+	PatternFieldList fields;
+
+	// Can the parts of conversionPattern be formatted separately?
+	bool useFields = false;
+
+	/**
+	 * Append to \c output the \c event content that \c conversionPattern specifies,
+	 * using {fmt} to parse the pattern.
+	 */
+	void formatUsingRuntimePattern(LogString& output, const spi::LoggingEventPtr& event) const;
 };
 
 IMPLEMENT_LOG4CXX_OBJECT(FMTLayout)
@@ -54,7 +238,10 @@ FMTLayout::FMTLayout() :
 
 FMTLayout::FMTLayout(const LogString& pattern) :
 	m_priv(std::make_unique<FMTLayoutPrivate>(pattern))
-{}
+{
+	helpers::Pool pool;
+	activateOptions(pool);
+}
 
 FMTLayout::~FMTLayout(){}
 
@@ -82,6 +269,9 @@ void FMTLayout::setOption(const LogString& option, const LogString& value)
 
 void FMTLayout::activateOptions(helpers::Pool&)
 {
+	m_priv->fields.clear();
+	LOG4CXX_ENCODE_CHAR(sPattern, m_priv->conversionPattern);
+	m_priv->useFields = parsePattern(sPattern, m_priv->fields);
 	m_priv->expectedPatternLength = getFormattedEventCharacterCount() * 2;
 }
 
@@ -90,6 +280,71 @@ void FMTLayout::format(LogString& output,
 	LOG4CXX_NS::helpers::Pool&) const
 {
 	output.reserve(m_priv->expectedPatternLength + event->getMessage().size());
+	if (!m_priv->useFields)
+	{
+		m_priv->formatUsingRuntimePattern(output, event);
+		return;
+	}
+	auto& location = event->getLocationInformation();
+	for (auto& field : m_priv->fields)
+	{
+		switch (field.kind)
+		{
+		case PatternField::Literal:
+			output.append(field.literal);
+			break;
+		case PatternField::Date:
+			appendField(output, field.format, event->getChronoTimeStamp());
+			break;
+		case PatternField::Logger:
+			appendField(output, field.format, event->getLoggerName());
+			break;
+		case PatternField::ShortFileName:
+			appendField(output, field.format, location.getShortFileName());
+			break;
+		case PatternField::FileName:
+			appendField(output, field.format, location.getFileName());
+			break;
+		case PatternField::Location:
+			appendField(output, field.format, fmt::format("{}({})", location.getFileName(), location.getLineNumber()));
+			break;
+		case PatternField::Line:
+			appendField(output, field.format, location.getLineNumber());
+			break;
+		case PatternField::Message:
+			appendField(output, field.format, event->getMessage());
+			break;
+		case PatternField::Method:
+			appendField(output, field.format, location.getMethodName());
+			break;
+		case PatternField::NewLine:
+			if (field.format.empty())
+				output.append(LOG4CXX_EOL);
+			else
+				appendField(output, field.format, LogString(LOG4CXX_EOL));
+			break;
+		case PatternField::Level:
+			appendField(output, field.format, event->getLevel()->toString());
+			break;
+		case PatternField::RelativeTime:
+			appendField(output, field.format, event->getTimeStamp());
+			break;
+		case PatternField::Thread:
+			appendField(output, field.format, event->getThreadName());
+			break;
+		case PatternField::NDC:
+		{
+			LogString ndc;
+			event->getNDC(ndc);
+			appendField(output, field.format, ndc);
+			break;
+		}
+		}
+	}
+}
+
+void FMTLayout::FMTLayoutPrivate::formatUsingRuntimePattern(LogString& output, const spi::LoggingEventPtr& event) const
+{
 	auto locationFull = fmt::format("{}({})",
 										 event->getLocationInformation().getFileName(),
 										 event->getLocationInformation().getLineNumber());
@@ -97,7 +352,7 @@ void FMTLayout::format(LogString& output,
 	event->getNDC(ndc);
 #if LOG4CXX_LOGCHAR_IS_WCHAR || LOG4CXX_LOGCHAR_IS_UNICHAR
 	LOG4CXX_ENCODE_CHAR(sNDC, ndc);
-	LOG4CXX_ENCODE_CHAR(sPattern, m_priv->conversionPattern);
+	LOG4CXX_ENCODE_CHAR(sPattern, this->conversionPattern);
 	LOG4CXX_ENCODE_CHAR(sLogger, event->getLoggerName());
 	LOG4CXX_ENCODE_CHAR(sLevel, event->getLevel()->toString());
 	LOG4CXX_ENCODE_CHAR(sMsg, event->getMessage());
@@ -105,7 +360,7 @@ void FMTLayout::format(LogString& output,
 	LOG4CXX_ENCODE_CHAR(endOfLine, LOG4CXX_EOL);
 #else
 	auto& sNDC = ndc;
-	auto& sPattern = m_priv->conversionPattern;
+	auto& sPattern = this->conversionPattern;
 	auto& sLogger = event->getLoggerName();
 	auto sLevel = event->getLevel()->toString();
 	auto& sMsg = event->getMessage();
@@ -0,0 +1,115 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <log4cxx/logstring.h>
+#include <log4cxx/private/groupcommitoutputstream.h>
+#include <log4cxx/helpers/bytebuffer.h>
+#include <log4cxx/helpers/pool.h>
+#if !defined(LOG4CXX)
+	#define LOG4CXX 1
+#endif
+#include <log4cxx/helpers/aprinitializer.h>
+
+using namespace LOG4CXX_NS;
+using namespace LOG4CXX_NS::helpers;
+
+GroupCommitOutputStream::GroupCommitOutputStream(const OutputStreamPtr& out, size_t batchSize)
+	: m_out(out)
+	, m_batchSize(batchSize)
+	, m_closed(false)
+	, m_commitEachWrite(false)
+{
+	m_pending.reserve(batchSize);
+	m_committing.reserve(batchSize);
+}
+
+GroupCommitOutputStream::~GroupCommitOutputStream()
+{
+	if (!m_closed && !m_pending.empty() && !APRInitializer::isDestructed)
+	{
+		try
+		{
+			Pool p;
+			commit(p);
+		}
+		catch (std::exception&)
+		{
+		}
+	}
+}
+
+void GroupCommitOutputStream::close(Pool& p)
+{
+	commit(p);
+	std::lock_guard<std::mutex> lock(m_commitMutex);
+	if (!m_closed)
+	{
+		m_closed = true;
+		m_out->close(p);
+	}
+}
+
+void GroupCommitOutputStream::flush(Pool& p)
+{
+	commit(p);
+	m_out->flush(p);
+}
+
+void GroupCommitOutputStream::write(ByteBuffer& buf, Pool& p)
+{
+	bool isFull;
+	{
+		std::lock_guard<std::mutex> lock(m_pendingMutex);
+		m_pending.append(buf.current(), buf.remaining());
+		isFull = m_batchSize <= m_pending.size() || m_commitEachWrite;
+	}
+	buf.position(buf.limit());
+	if (isFull)
+		commit(p);
+}
+
+void GroupCommitOutputStream::commit(Pool& p)
+{
+	std::lock_guard<std::mutex> lock(m_commitMutex);
+	{
+		std::lock_guard<std::mutex> lock(m_pendingMutex);
+		if (m_pending.empty())
+			return;
+		m_committing.swap(m_pending);
+	}
+	if (m_closed)
+	{
+		m_committing.clear();
+		return;
+	}
+	ByteBuffer buf(&m_committing[0], m_committing.size());
+	try
+	{
+		m_out->write(buf, p);
+	}
+	catch (...)
+	{
+		m_committing.clear();
+		throw;
+	}
+	m_committing.clear();
+}
+
+void GroupCommitOutputStream::setCommitEachWrite()
+{
+	m_commitEachWrite = true;
+}
@@ -22,6 +22,9 @@
 #include <log4cxx/helpers/transcoder.h>
 #include <log4cxx/private/action_priv.h>
 #include <log4cxx/helpers/loglog.h>
+#if LOG4CXX_HAS_ZLIB
+#include <log4cxx/private/deflatefile.h>
+#endif
 
 using namespace LOG4CXX_NS;
 using namespace LOG4CXX_NS::rolling;
@@ -40,6 +43,7 @@ struct GZCompressAction::GZCompressActionPrivate : public ActionPrivate
 	File destination;
 	bool deleteSource;
 	bool throwIOExceptionOnForkFailure = true;
+	int compressionLevel = -1;
 };
 
 IMPLEMENT_LOG4CXX_OBJECT(GZCompressAction)
@@ -56,6 +60,51 @@ GZCompressAction::~GZCompressAction() {}
 
 bool GZCompressAction::execute(LOG4CXX_NS::helpers::Pool& p) const
 {
+#if LOG4CXX_HAS_ZLIB
+	if (priv->source.exists(p))
+	{
+		apr_file_t* in;
+		apr_status_t stat = priv->source.open(&in, APR_FOPEN_READ, APR_OS_DEFAULT, p);
+
+		if (stat != APR_SUCCESS)
+		{
+			throw IOException(priv->source.getName(), stat);
+		}
+
+		apr_file_t* out;
+		apr_int32_t flags = APR_FOPEN_WRITE | APR_FOPEN_CREATE | APR_FOPEN_TRUNCATE;
+		stat = priv->destination.open(&out, flags, APR_OS_DEFAULT, p);
+
+		if (stat != APR_SUCCESS)
+		{
+			throw IOException(priv->destination.getName(), stat);
+		}
+
+		priv->destination.setAutoDelete(true);
+		deflateFile(in, out, priv->compressionLevel
+			, Transcoder::encode(priv->source.getName(), p)
+			, static_cast<uint32_t>(priv->source.lastModified(p) / APR_USEC_PER_SEC)
+			);
+		stat = apr_file_close(out);
+
+		if (stat != APR_SUCCESS)
+		{
+			throw IOException(stat);
+		}
+
+		apr_file_close(in);
+		priv->destination.setAutoDelete(false);
+
+		if (priv->deleteSource)
+		{
+			priv->source.deleteFile(p);
+		}
+
+		return true;
+	}
+
+	return false;
+#else
 	if (priv->source.exists(p))
 	{
 		apr_pool_t* aprpool = p.getAPRPool();
@@ -166,9 +215,14 @@ bool GZCompressAction::execute(LOG4CXX_NS::helpers::Pool& p) const
 	}
 
 	return false;
+#endif
 }
 
 void GZCompressAction::setThrowIOExceptionOnForkFailure(bool throwIO){
 	priv->throwIOExceptionOnForkFailure = throwIO;
 }
 
+void GZCompressAction::setCompressionLevel(int level){
+	priv->compressionLevel = level;
+}
+
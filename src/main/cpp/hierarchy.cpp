@@ -23,9 +23,13 @@
 #include <log4cxx/appender.h>
 #include <log4cxx/helpers/stringhelper.h>
 #include <log4cxx/spi/rootlogger.h>
+#include <log4cxx/spi/callsite.h>
 #include <algorithm>
+#include <atomic>
 #include <map>
 #include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
 #include <vector>
 
 
@@ -37,6 +41,26 @@ using namespace LOG4CXX_NS::helpers;
 typedef std::map<LogString, LoggerPtr> LoggerMap;
 typedef std::map<LogString, ProvisionNode> ProvisionNodeMap;
 
+namespace
+{
+#ifdef __cpp_lib_shared_mutex
+using SharedMutex = std::shared_mutex;
+#else
+using SharedMutex = std::shared_timed_mutex;
+#endif
+
+/**
+ * A subset of the loggers, selected by the hash of the logger name,
+ * that can be searched concurrently.
+ */
+struct alignas(64) LoggerShard
+{
+	mutable SharedMutex mutex;
+	std::unordered_map<LogString, LoggerPtr> loggers;
+};
+const size_t LoggerShardCount = 16;
+}
+
 struct Hierarchy::HierarchyPrivate
 {
 	HierarchyPrivate()
@@ -50,7 +74,7 @@ struct Hierarchy::HierarchyPrivate
 	helpers::Pool pool;
 	mutable std::recursive_mutex mutex;
 	mutable std::mutex configuredMutex;
-	bool configured;
+	std::atomic<bool> configured;
 	bool emittedNoAppenderWarning;
 	bool emittedNoResourceBundleWarning;
 	int thresholdInt;
@@ -61,9 +85,51 @@ struct Hierarchy::HierarchyPrivate
 	LoggerMap loggers;
 	ProvisionNodeMap provisionNodes;
 
+	/**
+	 * A copy of \c loggers used to find an existing logger without locking \c mutex.
+	 * Modified only while holding \c mutex.
+	 */
+	LoggerShard shards[LoggerShardCount];
+
 	std::vector<AppenderPtr> allAppenders;
 
 	mutable std::mutex listenerMutex;
+
+	LoggerShard& getShard(const LogString& name)
+	{
+		return this->shards[std::hash<LogString>()(name) % LoggerShardCount];
+	}
+
+	LoggerPtr findExisting(const LogString& name)
+	{
+		auto& shard = getShard(name);
+		std::shared_lock<SharedMutex> lock(shard.mutex);
+		auto it = shard.loggers.find(name);
+		return it == shard.loggers.end() ? LoggerPtr() : it->second;
+	}
+
+	void addExisting(const LogString& name, const LoggerPtr& logger)
+	{
+		auto& shard = getShard(name);
+		std::unique_lock<SharedMutex> lock(shard.mutex);
+		shard.loggers[name] = logger;
+	}
+
+	void removeExisting(const LogString& name)
+	{
+		auto& shard = getShard(name);
+		std::unique_lock<SharedMutex> lock(shard.mutex);
+		shard.loggers.erase(name);
+	}
+
+	void removeAllExisting()
+	{
+		for (auto& shard : this->shards)
+		{
+			std::unique_lock<SharedMutex> lock(shard.mutex);
+			shard.loggers.clear();
+		}
+	}
 };
 
 IMPLEMENT_LOG4CXX_OBJECT(Hierarchy)
@@ -118,6 +184,7 @@ void Hierarchy::removeHierarchyEventListener(const spi::HierarchyEventListenerPt
 void Hierarchy::clear()
 {
 	std::lock_guard<std::recursive_mutex> lock(m_priv->mutex);
+	m_priv->removeAllExisting();
 	m_priv->loggers.clear();
 }
 
@@ -142,18 +209,7 @@ void Hierarchy::emitNoAppenderWarning(const Logger* logger)
 
 LoggerPtr Hierarchy::exists(const LogString& name)
 {
-	std::lock_guard<std::recursive_mutex> lock(m_priv->mutex);
-
-	LoggerPtr logger;
-	LoggerMap::iterator it = m_priv->loggers.find(name);
-
-	if (it != m_priv->loggers.end())
-	{
-		logger = it->second;
-	}
-
-
-	return logger;
+	return m_priv->findExisting(name);
 }
 
 void Hierarchy::setThreshold(const LevelPtr& l)
@@ -189,6 +245,7 @@ void Hierarchy::setThresholdInternal(const LevelPtr& l)
 	{
 		m_priv->configured = true;
 	}
+	CallSite::invalidateAll();
 }
 
 void Hierarchy::fireAddAppenderEvent(const Logger* logger, const Appender* appender)
@@ -234,6 +291,9 @@ LoggerPtr Hierarchy::getLogger(const LogString& name)
 LoggerPtr Hierarchy::getLogger(const LogString& name,
 	const spi::LoggerFactoryPtr& factory)
 {
+	if (auto result = m_priv->findExisting(name))
+		return result;
+
 	auto root = getRootLogger();
 	std::lock_guard<std::recursive_mutex> lock(m_priv->mutex);
 
@@ -263,6 +323,8 @@ LoggerPtr Hierarchy::getLogger(const LogString& name,
 		}
 
 		updateParents(logger, root);
+		// Publish to lock-free readers only once the logger is linked into the hierarchy
+		m_priv->addExisting(name, logger);
 		result = logger;
 	}
 	return result;
@@ -301,11 +363,14 @@ bool Hierarchy::isDisabled(int level) const
 
 void Hierarchy::ensureIsConfigured(std::function<void()> configurator)
 {
+	if (m_priv->configured.load(std::memory_order_acquire))
+		return;
 	std::lock_guard<std::mutex> lock(m_priv->configuredMutex);
 	if (!m_priv->configured)
 	{
 		configurator();
 		m_priv->configured = true;
+		CallSite::invalidateAll();
 	}
 }
 
@@ -343,6 +408,7 @@ void Hierarchy::shutdown()
 void Hierarchy::shutdownInternal()
 {
 	m_priv->configured = false;
+	CallSite::invalidateAll();
 
 	// begin by closing nested appenders
 	if (m_priv->root)
@@ -446,6 +512,7 @@ void Hierarchy::setConfigured(bool newValue)
 	std::unique_lock<std::mutex> lock(m_priv->configuredMutex, std::try_to_lock);
 	if (lock.owns_lock()) // Not being auto-configured?
 		m_priv->configured = newValue;
+	CallSite::invalidateAll();
 }
 
 bool Hierarchy::isConfigured()
@@ -487,7 +554,7 @@ bool Hierarchy::removeLogger(const LogString& name, bool ifNotUsed)
 	auto it = m_priv->loggers.find(name);
 	if (it == m_priv->loggers.end())
 		;
-	else if (ifNotUsed && 1 + parentRefCount(it->second) < it->second.use_count())
+	else if (ifNotUsed && 2 + parentRefCount(it->second) < it->second.use_count()) // Held by loggers and a shard
 		;
 	else
 	{
@@ -499,6 +566,7 @@ bool Hierarchy::removeLogger(const LogString& name, bool ifNotUsed)
 					node.second.erase(node.second.begin() + i);
 			}
 		}
+		m_priv->removeExisting(name);
 		m_priv->loggers.erase(it);
 		result = true;
 	}
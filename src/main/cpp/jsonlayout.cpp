@@ -23,6 +23,7 @@
 #include <log4cxx/helpers/iso8601dateformat.h>
 #include <log4cxx/helpers/stringhelper.h>
 #include <log4cxx/helpers/transcoder.h>
+#include <log4cxx/private/characterscanner.h>
 
 #include <string.h>
 
@@ -215,23 +216,21 @@ void JSONLayout::appendQuotedEscapedString(LogString& buf,
 
 void JSONLayout::appendItem(const LogString& input, LogString& buf)
 {
+	static const CharacterScanner specialChars
+		{ 0x08   /* \b backspace         */
+		, 0x09   /* \t tab               */
+		, 0x0a   /* \n newline           */
+		, 0x0c   /* \f form feed         */
+		, 0x0d   /* \r carriage return   */
+		, 0x22   /* \" double quote      */
+		, 0x5c   /* \\ backslash         */
+		};
+
 	/* add leading quote */
 	buf.push_back(0x22);
 
-	logchar specialChars[] =
-	{
-		0x08,   /* \b backspace         */
-		0x09,   /* \t tab               */
-		0x0a,   /* \n newline           */
-		0x0c,   /* \f form feed         */
-		0x0d,   /* \r carriage return   */
-		0x22,   /* \" double quote      */
-		0x5c,   /* \\ backslash         */
-		0x00    /* terminating NULL for C-strings */
-	};
-
 	size_t start = 0;
-	size_t found = input.find_first_of(specialChars, start);
+	size_t found = specialChars.find(input, start);
 
 	while (found != LogString::npos)
 	{
@@ -240,65 +239,43 @@ void JSONLayout::appendItem(const LogString& input, LogString& buf)
 			buf.append(input, start, found - start);
 		}
 
+		logchar escape[] = { 0x5c, input[found] };
+
 		switch (input[found])
 		{
 			case 0x08:
 				/* \b backspace */
-				buf.push_back(0x5c);
-				buf.push_back('b');
+				escape[1] = 'b';
 				break;
 
 			case 0x09:
 				/* \t tab */
-				buf.push_back(0x5c);
-				buf.push_back('t');
+				escape[1] = 't';
 				break;
 
 			case 0x0a:
 				/* \n newline */
-				buf.push_back(0x5c);
-				buf.push_back('n');
+				escape[1] = 'n';
 				break;
 
 			case 0x0c:
 				/* \f form feed */
-				buf.push_back(0x5c);
-				buf.push_back('f');
+				escape[1] = 'f';
 				break;
 
 			case 0x0d:
 				/* \r carriage return */
-				buf.push_back(0x5c);
-				buf.push_back('r');
-				break;
-
-			case 0x22:
-				/* \" double quote */
-				buf.push_back(0x5c);
-				buf.push_back(0x22);
-				break;
-
-			case 0x5c:
-				/* \\ backslash */
-				buf.push_back(0x5c);
-				buf.push_back(0x5c);
+				escape[1] = 'r';
 				break;
 
 			default:
-				buf.push_back(input[found]);
+				/* \" double quote or \\ backslash */
 				break;
 		}
 
+		buf.append(escape, 2);
 		start = found + 1;
-
-		if (found < input.size())
-		{
-			found = input.find_first_of(specialChars, start);
-		}
-		else
-		{
-			found = LogString::npos;
-		}
+		found = specialChars.find(input, start);
 	}
 
 	if (start < input.size())
@@ -21,6 +21,8 @@
 #include <log4cxx/appender.h>
 #include <log4cxx/level.h>
 #include <log4cxx/hierarchy.h>
+#include <log4cxx/spi/callsite.h>
+#include <log4cxx/spi/deferredmessage.h>
 #include <log4cxx/helpers/stringhelper.h>
 #include <log4cxx/helpers/transcoder.h>
 #include <log4cxx/helpers/appenderattachableimpl.h>
@@ -29,6 +31,7 @@
 	#define LOG4CXX 1
 #endif
 #include <log4cxx/private/log4cxx_private.h>
+#include <log4cxx/private/recyclingallocator.h>
 #include <log4cxx/helpers/aprinitializer.h>
 
 using namespace LOG4CXX_NS;
@@ -38,16 +41,16 @@ using namespace LOG4CXX_NS::spi;
 struct Logger::LoggerPrivate
 {
 	LoggerPrivate(const LogString& name1)
-		: name(name1)
+		: name(std::make_shared<const LogString>(name1))
 		, repositoryRaw(0)
 		, additive(true)
 		, levelData(Level::getData())
 		{}
 
 	/**
-	The name of this logger.
+	The name of this logger, shared with the events it creates.
 	*/
-	LogString name;
+	LoggingEvent::LoggerNamePtr name;
 
 	/**
 	The assigned level of this logger.  The
@@ -82,6 +85,22 @@ struct Logger::LoggerPrivate
 	bool additive;
 
 	Level::DataPtr levelData;
+
+	/**
+	A new event for a logging request of this logger,
+	using memory previously released by the current thread where possible.
+	*/
+	LoggingEventPtr createEvent(const LevelPtr& level, const LocationInfo& location, LogString&& message) const
+	{
+		return std::allocate_shared<LoggingEvent>(RecyclingAllocator<LoggingEvent>()
+			, this->name, level, location, std::move(message));
+	}
+
+	LoggingEventPtr createEvent(const LevelPtr& level, const LocationInfo& location, DeferredMessageUniquePtr&& message) const
+	{
+		return std::allocate_shared<LoggingEvent>(RecyclingAllocator<LoggingEvent>()
+			, this->name, level, location, std::move(message));
+	}
 };
 
 IMPLEMENT_LOG4CXX_OBJECT(Logger)
@@ -166,10 +185,10 @@ void Logger::addEvent(const LevelPtr& level, std::string&& message, const Locati
 	if (!getHierarchy()) // Has removeHierarchy() been called?
 		return;
 #if LOG4CXX_LOGCHAR_IS_UTF8
-	auto event = std::make_shared<LoggingEvent>(m_priv->name, level, location, std::move(message));
+	auto event = m_priv->createEvent(level, location, std::move(message));
 #else
 	LOG4CXX_DECODE_CHAR(msg, message);
-	auto event = std::make_shared<LoggingEvent>(m_priv->name, level, location, std::move(msg));
+	auto event = m_priv->createEvent(level, location, std::move(msg));
 #endif
 	Pool p;
 	callAppenders(event, p);
@@ -211,10 +230,10 @@ void Logger::forcedLog(const LevelPtr& level, const std::string& message,
 	if (!getHierarchy()) // Has removeHierarchy() been called?
 		return;
 #if LOG4CXX_LOGCHAR_IS_UTF8
-	auto event = std::make_shared<LoggingEvent>(m_priv->name, level, message, location);
+	auto event = m_priv->createEvent(level, location, LogString(message));
 #else
 	LOG4CXX_DECODE_CHAR(msg, message);
-	auto event = std::make_shared<LoggingEvent>(m_priv->name, level, location, std::move(msg));
+	auto event = m_priv->createEvent(level, location, std::move(msg));
 #endif
 	Pool p;
 	callAppenders(event, p);
@@ -229,7 +248,16 @@ void Logger::addEventLS(const LevelPtr& level, LogString&& message, const Locati
 {
 	if (!getHierarchy()) // Has removeHierarchy() been called?
 		return;
-	auto event = std::make_shared<LoggingEvent>(m_priv->name, level, location, std::move(message));
+	auto event = m_priv->createEvent(level, location, std::move(message));
+	Pool p;
+	callAppenders(event, p);
+}
+
+void Logger::addEvent(const LevelPtr& level, DeferredMessageUniquePtr&& message, const LocationInfo& location) const
+{
+	if (!getHierarchy()) // Has removeHierarchy() been called?
+		return;
+	auto event = m_priv->createEvent(level, location, std::move(message));
 	Pool p;
 	callAppenders(event, p);
 }
@@ -239,7 +267,7 @@ void Logger::forcedLogLS(const LevelPtr& level1, const LogString& message,
 {
 	if (!getHierarchy()) // Has removeHierarchy() been called?
 		return;
-	auto event = std::make_shared<LoggingEvent>(m_priv->name, level1, message, location);
+	auto event = m_priv->createEvent(level1, location, LogString(message));
 	Pool p;
 	callAppenders(event, p);
 }
@@ -566,6 +594,7 @@ void Logger::removeAppender(const LogString& name1)
 void Logger::removeHierarchy()
 {
 	m_priv->repositoryRaw = 0;
+	spi::CallSite::invalidateAll();
 }
 
 void Logger::setAdditivity(bool additive1)
@@ -576,6 +605,7 @@ void Logger::setAdditivity(bool additive1)
 void Logger::setHierarchy(spi::LoggerRepository* repository1)
 {
 	m_priv->repositoryRaw = repository1;
+	spi::CallSite::invalidateAll();
 }
 
 void Logger::setParent(LoggerPtr parentLogger)
@@ -598,11 +628,12 @@ void Logger::setLevel(const LevelPtr level1)
 void Logger::updateThreshold()
 {
 	m_threshold = getEffectiveLevel()->toInt();
+	spi::CallSite::invalidateAll();
 }
 
 const LogString& Logger::getName() const
 {
-	return m_priv->name;
+	return *m_priv->name;
 }
 
 LoggerPtr Logger::getLogger(const std::string& name)
@@ -634,7 +665,7 @@ LoggerPtr Logger::getLoggerLS(const LogString& name,
 
 void Logger::getName(std::string& rv) const
 {
-	Transcoder::encode(m_priv->name, rv);
+	Transcoder::encode(*m_priv->name, rv);
 }
 
 
@@ -777,10 +808,10 @@ void Logger::addEvent(const LevelPtr& level, std::wstring&& message, const Locat
 	if (!getHierarchy()) // Has removeHierarchy() been called?
 		return;
 #if LOG4CXX_LOGCHAR_IS_WCHAR
-	auto event = std::make_shared<LoggingEvent>(m_priv->name, level, location, std::move(message));
+	auto event = m_priv->createEvent(level, location, std::move(message));
 #else
 	LOG4CXX_DECODE_WCHAR(msg, message);
-	auto event = std::make_shared<LoggingEvent>(m_priv->name, level, location, std::move(msg));
+	auto event = m_priv->createEvent(level, location, std::move(msg));
 #endif
 	Pool p;
 	callAppenders(event, p);
@@ -822,10 +853,10 @@ void Logger::forcedLog(const LevelPtr& level, const std::wstring& message,
 	if (!getHierarchy()) // Has removeHierarchy() been called?
 		return;
 #if LOG4CXX_LOGCHAR_IS_WCHAR
-	auto event = std::make_shared<LoggingEvent>(m_priv->name, level, message, location);
+	auto event = m_priv->createEvent(level, location, LogString(message));
 #else
 	LOG4CXX_DECODE_WCHAR(msg, message);
-	auto event = std::make_shared<LoggingEvent>(m_priv->name, level, location, std::move(msg));
+	auto event = m_priv->createEvent(level, location, std::move(msg));
 #endif
 	Pool p;
 	callAppenders(event, p);
@@ -838,7 +869,7 @@ void Logger::forcedLog(const LevelPtr& level1, const std::wstring& message) cons
 
 void Logger::getName(std::wstring& rv) const
 {
-	Transcoder::encode(m_priv->name, rv);
+	Transcoder::encode(*m_priv->name, rv);
 }
 
 LoggerPtr Logger::getLogger(const std::wstring& name)
@@ -974,7 +1005,7 @@ void Logger::addEvent(const LevelPtr& level1, std::basic_string<UniChar>&& messa
 	if (!getHierarchy()) // Has removeHierarchy() been called?
 		return;
 	LOG4CXX_DECODE_UNICHAR(msg, message);
-	auto event = std::make_shared<LoggingEvent>(m_priv->name, level1, location, std::move(msg));
+	auto event = m_priv->createEvent(level1, location, std::move(msg));
 	Pool p;
 	callAppenders(event, p);
 }
@@ -1015,7 +1046,7 @@ void Logger::forcedLog(const LevelPtr& level1, const std::basic_string<UniChar>&
 	if (!getHierarchy()) // Has removeHierarchy() been called?
 		return;
 	LOG4CXX_DECODE_UNICHAR(msg, message);
-	auto event = std::make_shared<LoggingEvent>(m_priv->name, level1, location, std::move(msg));
+	auto event = m_priv->createEvent(level1, location, std::move(msg));
 	Pool p;
 	callAppenders(event, p);
 }
@@ -1025,15 +1056,14 @@ void Logger::forcedLog(const LevelPtr& level1, const std::basic_string<UniChar>&
 	if (!getHierarchy()) // Has removeHierarchy() been called?
 		return;
 	LOG4CXX_DECODE_UNICHAR(msg, message);
-	auto event = std::make_shared<LoggingEvent>(m_priv->name, level1, msg,
-			LocationInfo::getLocationUnavailable());
+	auto event = m_priv->createEvent(level1, LocationInfo::getLocationUnavailable(), std::move(msg));
 	Pool p;
 	callAppenders(event, p);
 }
 
 void Logger::getName(std::basic_string<UniChar>& rv) const
 {
-	Transcoder::encode(m_priv->name, rv);
+	Transcoder::encode(*m_priv->name, rv);
 }
 
 LoggerPtr Logger::getLogger(const std::basic_string<UniChar>& name)
@@ -1165,7 +1195,7 @@ void Logger::forcedLog(const LevelPtr& level, const CFStringRef& message,
 	if (!getHierarchy()) // Has removeHierarchy() been called?
 		return;
 	LOG4CXX_DECODE_CFSTRING(msg, message);
-	auto event = std::make_shared<LoggingEvent>(m_priv->name, level, location, std::move(msg));
+	auto event = m_priv->createEvent(level, location, std::move(msg));
 	Pool p;
 	callAppenders(event, p);
 }
@@ -1175,15 +1205,14 @@ void Logger::forcedLog(const LevelPtr& level, const CFStringRef& message) const
 	if (!getHierarchy()) // Has removeHierarchy() been called?
 		return;
 	LOG4CXX_DECODE_CFSTRING(msg, message);
-	auto event = std::make_shared<LoggingEvent>(m_priv->name, level, msg,
-			LocationInfo::getLocationUnavailable());
+	auto event = m_priv->createEvent(level, LocationInfo::getLocationUnavailable(), std::move(msg));
 	Pool p;
 	callAppenders(event, p);
 }
 
 void Logger::getName(CFStringRef& rv) const
 {
-	rv = Transcoder::encode(m_priv->name);
+	rv = Transcoder::encode(*m_priv->name);
 }
 
 LoggerPtr Logger::getLogger(const CFStringRef& name)
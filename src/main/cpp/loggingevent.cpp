@@ -31,6 +31,10 @@
 #include <log4cxx/helpers/bytebuffer.h>
 #include <log4cxx/helpers/date.h>
 #include <log4cxx/helpers/optional.h>
+#include <log4cxx/helpers/transcoder.h>
+#include <log4cxx/private/recyclingallocator.h>
+#include <log4cxx/spi/deferredmessage.h>
+#include <mutex>
 
 using namespace LOG4CXX_NS;
 using namespace LOG4CXX_NS::spi;
@@ -49,13 +53,13 @@ struct LoggingEvent::LoggingEventPrivate
 	}
 
 	LoggingEventPrivate
-		( const LogString& logger1
+		( const LoggerNamePtr& logger1
 		, const LevelPtr& level1
 		, const LocationInfo& locationInfo1
 		, LogString&& message1
 		, const ThreadSpecificData::NamePairPtr p = ThreadSpecificData::getNames()
 		) :
-		logger(logger1),
+		sharedLogger(logger1),
 		level(level1),
 		message(std::move(message1)),
 		timeStamp(Date::currentTime()),
@@ -70,11 +74,11 @@ struct LoggingEvent::LoggingEventPrivate
 	}
 
 	LoggingEventPrivate(
-		const LogString& logger1, const LevelPtr& level1,
+		const LoggerNamePtr& logger1, const LevelPtr& level1,
 		const LogString& message1, const LocationInfo& locationInfo1,
 		const ThreadSpecificData::NamePairPtr& p = ThreadSpecificData::getNames()
 		) :
-		logger(logger1),
+		sharedLogger(logger1),
 		level(level1),
 		message(message1),
 		timeStamp(Date::currentTime()),
@@ -93,8 +97,28 @@ struct LoggingEvent::LoggingEventPrivate
 		delete properties;
 	}
 
+	/**
+	* Reuse memory released by the current thread.
+	**/
+	static void* operator new(size_t)
+	{
+		return RecycledBlocks<sizeof (LoggingEventPrivate)>::allocate();
+	}
+
+	static void operator delete(void* p)
+	{
+		RecycledBlocks<sizeof (LoggingEventPrivate)>::deallocate(p);
+	}
+
+	/**
+	* The name of the logger used to make the logging request
+	* when the name is shared with that logger
+	**/
+	LoggerNamePtr sharedLogger;
+
 	/**
 	* The name of the logger used to make the logging request
+	* when sharedLogger is not set
 	**/
 	LogString logger;
 
@@ -119,7 +143,36 @@ struct LoggingEvent::LoggingEventPrivate
 #endif
 
 	/** The application supplied message. */
-	LogString message;
+	mutable LogString message;
+
+	/** The values from which \c message is produced when it is first required. */
+	DeferredMessageUniquePtr deferredMessage;
+
+	mutable std::once_flag messageFormatted;
+
+	const LogString& getMessage()
+	{
+		if (this->deferredMessage)
+			std::call_once(this->messageFormatted, &LoggingEventPrivate::formatMessage, this);
+		return this->message;
+	}
+
+	void formatMessage()
+	{
+		try
+		{
+			this->deferredMessage->format(this->message);
+		}
+		catch (std::exception& ex)
+		{
+			if (this->message.empty())
+			{
+				this->message = LOG4CXX_STR("Unable to format message: ");
+				Transcoder::decode(ex.what(), this->message);
+			}
+			LogLog::warn(LOG4CXX_STR("Unable to format message"), ex);
+		}
+	}
 
 
 	/** The number of microseconds elapsed since 1970-01-01
@@ -148,13 +201,13 @@ struct LoggingEvent::LoggingEventPrivate
 	struct DiagnosticContext
 	{
 		Optional<NDC::DiagnosticContext> ctx;
-		MDC::Map map;
+		ThreadSpecificData::MapPtr map;
 	};
 	/**
 	 *  Used to hold the diagnostic context when the lifetime
 	 *  of this LoggingEvent exceeds the duration of the logging request.
 	 */
-	mutable std::unique_ptr<DiagnosticContext> dc;
+	mutable Optional<DiagnosticContext> dc;
 };
 
 IMPLEMENT_LOG4CXX_OBJECT(LoggingEvent)
@@ -179,15 +232,62 @@ LoggingEvent::LoggingEvent
 	, const LocationInfo& location
 	, LogString&&         message
 	)
+	: m_priv(std::make_unique<LoggingEventPrivate>(LoggerNamePtr(), level, location, std::move(message)))
+{
+	m_priv->logger = logger;
+}
+
+LoggingEvent::LoggingEvent
+	( const LoggerNamePtr& logger
+	, const LevelPtr&      level
+	, const LocationInfo&  location
+	, LogString&&          message
+	)
 	: m_priv(std::make_unique<LoggingEventPrivate>(logger, level, location, std::move(message)))
 {
 }
 
+LoggingEvent::LoggingEvent
+	( const LoggerNamePtr&       logger
+	, const LevelPtr&            level
+	, const LocationInfo&        location
+	, DeferredMessageUniquePtr&& message
+	)
+	: m_priv(std::make_unique<LoggingEventPrivate>(logger, level, location, LogString()))
+{
+	m_priv->deferredMessage = std::move(message);
+}
+
 LoggingEvent::LoggingEvent(
 	const LogString& logger1, const LevelPtr& level1,
 	const LogString& message1, const LocationInfo& locationInfo1) :
-	m_priv(std::make_unique<LoggingEventPrivate>(logger1, level1, message1, locationInfo1))
+	m_priv(std::make_unique<LoggingEventPrivate>(LoggerNamePtr(), level1, message1, locationInfo1))
 {
+	m_priv->logger = logger1;
+}
+
+LoggingEvent::LoggingEvent
+	( const LogString&    logger
+	, const LevelPtr&     level
+	, const LocationInfo& location
+	, LogString&&         message
+	, log4cxx_time_t      timeStamp
+	, const LogString&    threadId
+	, const LogString&    threadName
+	, const LogString&    ndc
+	, const MDC::Map&     mdc
+	)
+	: m_priv(std::make_unique<LoggingEventPrivate>(LoggerNamePtr(), level, location, std::move(message)
+		, std::make_shared<ThreadSpecificData::NamePair>(ThreadSpecificData::NamePair{threadId, threadName})))
+{
+	m_priv->logger = logger;
+	m_priv->timeStamp = timeStamp;
+	m_priv->chronoTimeStamp = std::chrono::time_point<std::chrono::system_clock>(std::chrono::microseconds(timeStamp));
+	LoggingEventPrivate::DiagnosticContext dc;
+	dc.map = std::make_shared<const MDC::Map>(mdc);
+	if (!ndc.empty())
+		dc.ctx = NDC::DiagnosticContext(ndc, ndc);
+	m_priv->dc = dc;
 }
 
 LoggingEvent::~LoggingEvent()
@@ -206,9 +306,10 @@ bool LoggingEvent::getNDC(LogString& dest) const
 	// Otherwise use the NDC that is associated with the thread.
 	if (m_priv->dc)
 	{
-		result = bool(m_priv->dc->ctx);
+		auto& ctx = m_priv->dc.value().ctx;
+		result = bool(ctx);
 		if (result)
-			dest.append(NDC::getFullMessage(m_priv->dc->ctx.value()));
+			dest.append(NDC::getFullMessage(ctx.value()));
 	}
 	else
 		result = NDC::get(dest);
@@ -222,7 +323,7 @@ bool LoggingEvent::getMDC(const LogString& key, LogString& dest) const
 	// Otherwise use the MDC that is associated with the thread.
 	if (m_priv->dc)
 	{
-		auto& map = m_priv->dc->map;
+		auto& map = *m_priv->dc.value().map;
 		auto it = map.find(key);
 		if (it != map.end() && !it->second.empty())
 		{
@@ -240,10 +341,10 @@ LoggingEvent::KeySet LoggingEvent::getMDCKeySet() const
 	LoggingEvent::KeySet result;
 	if (m_priv->dc)
 	{
-		for (auto const& item : m_priv->dc->map)
+		for (auto const& item : *m_priv->dc.value().map)
 			result.push_back(item.first);
 	}
-	else if (auto pData = ThreadSpecificData::getCurrentData())
+	else if (const ThreadSpecificData* pData = ThreadSpecificData::getCurrentData())
 	{
 		for (auto const& item : pData->getMap())
 			result.push_back(item.first);
@@ -253,14 +354,17 @@ LoggingEvent::KeySet LoggingEvent::getMDCKeySet() const
 
 void LoggingEvent::LoadDC() const
 {
-	m_priv->dc = std::make_unique<LoggingEventPrivate::DiagnosticContext>();
+	LoggingEventPrivate::DiagnosticContext dc;
 	if (auto pData = ThreadSpecificData::getCurrentData())
 	{
-		m_priv->dc->map = pData->getMap();
+		dc.map = pData->getMapCopy();
 		auto& stack = pData->getStack();
 		if (!stack.empty())
-			m_priv->dc->ctx = stack.top();
+			dc.ctx = stack.top();
 	}
+	else
+		dc.map = std::make_shared<const MDC::Map>();
+	m_priv->dc = std::move(dc);
 }
 
 #if LOG4CXX_ABI_VERSION <= 15
@@ -321,17 +425,17 @@ const LevelPtr& LoggingEvent::getLevel() const
 
 const LogString& LoggingEvent::getLoggerName() const
 {
-	return m_priv->logger;
+	return m_priv->sharedLogger ? *m_priv->sharedLogger : m_priv->logger;
 }
 
 const LogString& LoggingEvent::getMessage() const
 {
-	return m_priv->message;
+	return m_priv->getMessage();
 }
 
 const LogString& LoggingEvent::getRenderedMessage() const
 {
-	return m_priv->message;
+	return m_priv->getMessage();
 }
 
 const LogString& LoggingEvent::getThreadName() const
@@ -0,0 +1,90 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <log4cxx/logstring.h>
+#include <log4cxx/rolling/mappedfileappender.h>
+#include <log4cxx/helpers/stringhelper.h>
+#include <log4cxx/helpers/optionconverter.h>
+#include <log4cxx/private/rollingfileappender_priv.h>
+#include <log4cxx/private/mappedfileoutputstream.h>
+#include <mutex>
+
+using namespace LOG4CXX_NS;
+using namespace LOG4CXX_NS::rolling;
+using namespace LOG4CXX_NS::helpers;
+
+struct MappedFileAppender::MappedFileAppenderPriv
+	: public RollingFileAppenderPriv
+{
+	OutputStreamPtr createOutputStream(const LogString& fileName, bool append) override
+	{
+		auto result = std::make_shared<MappedFileOutputStream>(fileName, append, this->mapSize);
+		this->activeStream = result;
+		return result;
+	}
+
+	size_t getActiveFileLength(const LogString& fileName, Pool& p) override
+	{
+		// The file on disk includes the unused part of the mapped region
+		auto stream = this->activeStream.lock();
+		if (stream && stream->getFileName() == fileName)
+			return stream->getLength();
+		return RollingFileAppenderPriv::getActiveFileLength(fileName, p);
+	}
+
+	/**
+	The number of bytes by which the log file is extended.
+	*/
+	size_t mapSize{ 4 * 1024 * 1024 };
+
+	/**
+	The stream writing to the current log file.
+	*/
+	std::weak_ptr<MappedFileOutputStream> activeStream;
+};
+
+#define _priv static_cast<MappedFileAppenderPriv*>(m_priv.get())
+
+IMPLEMENT_LOG4CXX_OBJECT(MappedFileAppender)
+
+MappedFileAppender::MappedFileAppender()
+	: RollingFileAppender(std::make_unique<MappedFileAppenderPriv>())
+{
+}
+
+void MappedFileAppender::setOption(const LogString& option, const LogString& value)
+{
+	if (StringHelper::equalsIgnoreCase(option, LOG4CXX_STR("MAPSIZE"), LOG4CXX_STR("mapsize")))
+	{
+		std::lock_guard<std::recursive_mutex> lock(_priv->mutex);
+		_priv->mapSize = OptionConverter::toFileSize(value, 4 * 1024 * 1024);
+	}
+	else
+	{
+		RollingFileAppender::setOption(option, value);
+	}
+}
+
+size_t MappedFileAppender::getMapSize() const
+{
+	return _priv->mapSize;
+}
+
+void MappedFileAppender::setMapSize(size_t newValue)
+{
+	_priv->mapSize = newValue;
+}
@@ -0,0 +1,212 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <log4cxx/logstring.h>
+#include <log4cxx/private/mappedfileoutputstream.h>
+#include <log4cxx/helpers/exception.h>
+#include <log4cxx/helpers/bytebuffer.h>
+#include <log4cxx/file.h>
+#include <apr_file_io.h>
+#include <apr_mmap.h>
+#include <apr_portable.h>
+#if !defined(LOG4CXX)
+	#define LOG4CXX 1
+#endif
+#include <log4cxx/private/log4cxx_private.h>
+#include <log4cxx/helpers/aprinitializer.h>
+#if LOG4CXX_HAS_POSIX_FALLOCATE
+#include <fcntl.h>
+#endif
+#include <cstring>
+
+using namespace LOG4CXX_NS;
+using namespace LOG4CXX_NS::helpers;
+
+namespace
+{
+// The alignment required for a mapped region offset on all supported platforms
+const size_t MapAlignment = 64 * 1024;
+}
+
+MappedFileOutputStream::MappedFileOutputStream(const LogString& fileName, bool append, size_t mapSize)
+	: m_fileName(fileName)
+	, m_file(nullptr)
+	, m_mapPool(nullptr)
+	, m_map(nullptr)
+	, m_mapSize(mapSize < MapAlignment ? MapAlignment : (mapSize + MapAlignment - 1) / MapAlignment * MapAlignment)
+	, m_mapOffset(0)
+	, m_length(0)
+{
+	apr_status_t stat = apr_pool_create(&m_mapPool, m_pool.getAPRPool());
+	if (stat != APR_SUCCESS)
+		throw IOException(fileName, stat);
+
+	apr_int32_t flags = APR_READ | APR_WRITE | APR_CREATE;
+	if (!append)
+		flags |= APR_TRUNCATE;
+	File fn;
+	fn.setPath(fileName);
+	stat = fn.open(&m_file, flags, APR_OS_DEFAULT, m_pool);
+	if (stat != APR_SUCCESS)
+		throw IOException(fileName, stat);
+
+	if (append)
+	{
+		apr_finfo_t finfo;
+		stat = apr_file_info_get(&finfo, APR_FINFO_SIZE, m_file);
+		if (stat != APR_SUCCESS)
+		{
+			apr_file_close(m_file);
+			throw IOException(fileName, stat);
+		}
+		m_length = static_cast<size_t>(finfo.size);
+	}
+	try
+	{
+		if (0 < m_length)
+		{
+			// Map the region containing the last byte and skip back over unused bytes
+			map((m_length - 1) / m_mapSize * m_mapSize);
+			auto start = static_cast<const char*>(m_map->mm);
+			size_t used = m_length - m_mapOffset;
+			while (0 < used && 0 == start[used - 1])
+				--used;
+			m_length = m_mapOffset + used;
+			if (m_length == m_mapOffset + m_mapSize)
+				map(m_length);
+		}
+		else
+			map(0);
+	}
+	catch (IOException&)
+	{
+		apr_file_close(m_file);
+		m_file = nullptr;
+		throw;
+	}
+}
+
+MappedFileOutputStream::~MappedFileOutputStream()
+{
+	if (m_file && !APRInitializer::isDestructed)
+	{
+		unmap();
+		apr_file_trunc(m_file, static_cast<apr_off_t>(m_length));
+		apr_file_close(m_file);
+	}
+}
+
+void MappedFileOutputStream::close(Pool& /* p */)
+{
+	if (m_file)
+	{
+		unmap();
+		apr_status_t stat = apr_file_trunc(m_file, static_cast<apr_off_t>(m_length));
+		apr_status_t closeStat = apr_file_close(m_file);
+		m_file = nullptr;
+		if (stat == APR_SUCCESS)
+			stat = closeStat;
+		if (stat != APR_SUCCESS)
+			throw IOException(stat);
+	}
+}
+
+void MappedFileOutputStream::flush(Pool& /* p */)
+{
+}
+
+void MappedFileOutputStream::write(ByteBuffer& buf, Pool& /* p */)
+{
+	if (!m_map)
+		throw NullPointerException(LOG4CXX_STR("MappedFileOutputStream"));
+
+	const char* data = buf.current();
+	size_t remaining = buf.remaining();
+	while (0 < remaining)
+	{
+		size_t used = m_length - m_mapOffset;
+		size_t count = m_mapSize - used;
+		if (remaining < count)
+			count = remaining;
+		std::memcpy(static_cast<char*>(m_map->mm) + used, data, count);
+		m_length += count;
+		data += count;
+		remaining -= count;
+		if (m_length == m_mapOffset + m_mapSize)
+			map(m_length);
+	}
+	buf.position(buf.limit());
+}
+
+void MappedFileOutputStream::map(size_t offset)
+{
+	unmap();
+	apr_status_t stat = apr_file_trunc(m_file, static_cast<apr_off_t>(offset + m_mapSize));
+	if (stat != APR_SUCCESS)
+		throw IOException(stat);
+	allocate(offset);
+	stat = apr_mmap_create(&m_map, m_file, static_cast<apr_off_t>(offset), m_mapSize, APR_MMAP_READ | APR_MMAP_WRITE, m_mapPool);
+	if (stat != APR_SUCCESS)
+	{
+		m_map = nullptr;
+		throw IOException(stat);
+	}
+	m_mapOffset = offset;
+}
+
+void MappedFileOutputStream::allocate(size_t offset)
+{
+	apr_status_t stat;
+#if LOG4CXX_HAS_POSIX_FALLOCATE
+	apr_os_file_t fd;
+	stat = apr_os_file_get(&fd, m_file);
+	if (stat == APR_SUCCESS)
+	{
+		int err = posix_fallocate(fd, static_cast<off_t>(offset), static_cast<off_t>(m_mapSize));
+		if (err != 0)
+			stat = APR_FROM_OS_ERROR(err);
+	}
+#else
+	// Write out the blocks after the data in the region
+	size_t start = offset < m_length ? m_length : offset;
+	apr_off_t position = static_cast<apr_off_t>(start);
+	stat = apr_file_seek(m_file, APR_SET, &position);
+	static const char zeros[MapAlignment] = {};
+	for (size_t remaining = offset + m_mapSize - start; stat == APR_SUCCESS && 0 < remaining;)
+	{
+		size_t count = remaining < sizeof(zeros) ? remaining : sizeof(zeros);
+		stat = apr_file_write_full(m_file, zeros, count, nullptr);
+		remaining -= count;
+	}
+#endif
+	if (stat != APR_SUCCESS)
+	{
+		// Do not leave an unallocated region at the end of the file
+		apr_file_trunc(m_file, static_cast<apr_off_t>(m_length));
+		throw IOException(stat);
+	}
+}
+
+void MappedFileOutputStream::unmap()
+{
+	if (m_map)
+	{
+		apr_mmap_delete(m_map);
+		m_map = nullptr;
+	}
+	apr_pool_clear(m_mapPool);
+}
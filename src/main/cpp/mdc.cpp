@@ -58,9 +58,10 @@ bool MDC::get(const LogString& key, LogString& value)
 
 	if (data != 0)
 	{
-		Map& map = data->getMap();
+		const ThreadSpecificData& constData = *data;
+		const Map& map = constData.getMap();
 
-		Map::iterator it = map.find(key);
+		Map::const_iterator it = map.find(key);
 
 		if (it != map.end())
 		{
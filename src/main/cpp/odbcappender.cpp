@@ -19,6 +19,7 @@
 #include <log4cxx/helpers/optionconverter.h>
 #include <log4cxx/helpers/stringhelper.h>
 #include <log4cxx/helpers/transcoder.h>
+#include <log4cxx/helpers/threadutility.h>
 #include <log4cxx/patternlayout.h>
 #include <log4cxx/pattern/mdcpatternconverter.h>
 #include <apr_strings.h>
@@ -134,6 +135,9 @@ ODBCAppender::ODBCAppender()
 				_priv->errorHandler->error(LOG4CXX_STR("Error flushing connection"),
 					e, ErrorCode::GENERIC_FAILURE);
 			}
+#if LOG4CXX_HAVE_ODBC
+			_priv->stopFlushThread();
+#endif
 		}
 #endif
 								))
@@ -199,6 +203,10 @@ void ODBCAppender::setOption(const LogString& option, const LogString& value)
 	{
 		_priv->mappedName.push_back(value);
 	}
+	else if (StringHelper::equalsIgnoreCase(option, LOG4CXX_STR("BACKGROUNDFLUSH"), LOG4CXX_STR("backgroundflush")))
+	{
+		setBackgroundFlush(OptionConverter::toBoolean(value, false));
+	}
 	else
 	{
 		AppenderSkeleton::setOption(option, value);
@@ -250,6 +258,14 @@ void ODBCAppender::activateOptions(LOG4CXX_NS::helpers::Pool&)
 			_priv->parameterValue.push_back(paramData);
 		}
 	}
+	if (_priv->backgroundFlush && !_priv->flushThread.joinable())
+	{
+		_priv->stopFlushing = false;
+		_priv->flushThread = ThreadUtility::instance()->createThread
+			( LOG4CXX_STR("ODBCAppender")
+			, &ODBCAppenderPriv::flushPending, _priv, this
+			);
+	}
 #endif
 }
 
@@ -392,6 +408,7 @@ void ODBCAppender::close()
 	}
 
 #if LOG4CXX_HAVE_ODBC
+	_priv->stopFlushThread();
 
 	if (_priv->connection != SQL_NULL_HDBC)
 	{
@@ -431,6 +448,37 @@ void ODBCAppender::ODBCAppenderPriv::setPreparedStatement(SQLHDBC con, Pool& p)
 		throw SQLException(SQL_HANDLE_STMT, this->preparedStatement, "Failed to prepare sql statement.", p);
 	}
 
+	// Bind column-wise arrays of parameter values so a full buffer is inserted using one execution
+	this->rowCapacity = this->rowCount = 1;
+	this->paramStatus.clear();
+	if (1 < this->bufferSize)
+	{
+		ret = SQLSetStmtAttr(this->preparedStatement, SQL_ATTR_PARAM_BIND_TYPE, (SQLPOINTER) SQL_PARAM_BIND_BY_COLUMN, 0);
+		if (SQL_SUCCEEDED(ret))
+			ret = SQLSetStmtAttr(this->preparedStatement, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER) (SQLULEN) this->bufferSize, 0);
+		if (SQL_SUCCEEDED(ret))
+		{
+			this->rowCapacity = this->rowCount = this->bufferSize;
+			// Have the driver report which rows could not be inserted
+			this->paramStatus.assign(this->rowCapacity, SQL_PARAM_UNUSED);
+			this->paramsProcessed = 0;
+			ret = SQLSetStmtAttr(this->preparedStatement, SQL_ATTR_PARAM_STATUS_PTR, (SQLPOINTER) this->paramStatus.data(), 0);
+			if (SQL_SUCCEEDED(ret))
+				ret = SQLSetStmtAttr(this->preparedStatement, SQL_ATTR_PARAMS_PROCESSED_PTR, (SQLPOINTER) &this->paramsProcessed, 0);
+			if (!SQL_SUCCEEDED(ret))
+			{
+				SQLSetStmtAttr(this->preparedStatement, SQL_ATTR_PARAM_STATUS_PTR, (SQLPOINTER) 0, 0);
+				this->paramStatus.clear();
+			}
+		}
+		else
+		{
+			LogLog::warn(LOG4CXX_STR("The ODBC driver does not support arrays of parameter values."
+				" Each logging event will be inserted using a separate execution."));
+			SQLSetStmtAttr(this->preparedStatement, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER) 1, 0);
+		}
+	}
+
 	int parameterNumber = 0;
 	for (auto& item : this->parameterValue)
 	{
@@ -456,14 +504,12 @@ void ODBCAppender::ODBCAppenderPriv::setPreparedStatement(SQLHDBC con, Pool& p)
 			item.paramType = SQL_C_CHAR;
 			item.paramMaxCharCount = targetMaxCharCount;
 			item.paramValueSize = (SQLINTEGER)(item.paramMaxCharCount) * sizeof(char) + sizeof(char);
-			item.paramValue = (SQLPOINTER)p.palloc(item.paramValueSize + sizeof(char));
 		}
 		else if (SQL_WCHAR == targetType || SQL_WVARCHAR == targetType || SQL_WLONGVARCHAR == targetType)
 		{
 			item.paramType = SQL_C_WCHAR;
 			item.paramMaxCharCount = targetMaxCharCount;
 			item.paramValueSize = (SQLINTEGER)(targetMaxCharCount) * sizeof(wchar_t) + sizeof(wchar_t);
-			item.paramValue = (SQLPOINTER)p.palloc(item.paramValueSize + sizeof(wchar_t));
 		}
 		else if (SQL_TYPE_TIMESTAMP == targetType || SQL_TYPE_DATE == targetType || SQL_TYPE_TIME == targetType
 			|| SQL_DATETIME == targetType)
@@ -471,7 +517,6 @@ void ODBCAppender::ODBCAppenderPriv::setPreparedStatement(SQLHDBC con, Pool& p)
 			item.paramType = SQL_C_TYPE_TIMESTAMP;
 			item.paramMaxCharCount = (0 <= decimalDigits) ? decimalDigits : 6;
 			item.paramValueSize = sizeof(SQL_TIMESTAMP_STRUCT);
-			item.paramValue = (SQLPOINTER)p.palloc(item.paramValueSize);
 		}
 		else
 		{
@@ -488,14 +533,14 @@ void ODBCAppender::ODBCAppenderPriv::setPreparedStatement(SQLHDBC con, Pool& p)
 #if LOG4CXX_LOGCHAR_IS_UTF8
 			item.paramType = SQL_C_CHAR;
 			item.paramValueSize = (SQLINTEGER)(item.paramMaxCharCount) * sizeof(char);
-			item.paramValue = (SQLPOINTER)p.palloc(item.paramValueSize + sizeof(char));
 #else
 			item.paramType = SQL_C_WCHAR;
 			item.paramValueSize = (SQLINTEGER)(item.paramMaxCharCount) * sizeof(wchar_t);
-			item.paramValue = (SQLPOINTER)p.palloc(item.paramValueSize + sizeof(wchar_t));
 #endif
 		}
-		item.strLen_or_Ind = SQL_NTS;
+		item.storage.resize(item.paramValueSize * this->rowCapacity);
+		item.paramValue = (SQLPOINTER)item.storage.data();
+		item.strLen_or_Ind.assign(this->rowCapacity, SQL_NTS);
 		ret = SQLBindParameter
 			( this->preparedStatement
 			, parameterNumber
@@ -506,7 +551,7 @@ void ODBCAppender::ODBCAppenderPriv::setPreparedStatement(SQLHDBC con, Pool& p)
 			, decimalDigits
 			, item.paramValue
 			, item.paramValueSize
-			, &item.strLen_or_Ind
+			, item.strLen_or_Ind.data()
 			);
 		if (ret < 0)
 		{
@@ -515,13 +560,14 @@ void ODBCAppender::ODBCAppenderPriv::setPreparedStatement(SQLHDBC con, Pool& p)
 	}
 }
 
-void ODBCAppender::ODBCAppenderPriv::setParameterValues(const spi::LoggingEventPtr& event, Pool& p)
+void ODBCAppender::ODBCAppenderPriv::setParameterValues(const spi::LoggingEventPtr& event, size_t row, Pool& p)
 {
 	for (auto& item : this->parameterValue)
 	{
 		if (!item.paramValue || item.paramValueSize <= 0)
-			;
-		else if (SQL_C_WCHAR == item.paramType)
+			continue;
+		auto value = (char*)item.paramValue + row * item.paramValueSize;
+		if (SQL_C_WCHAR == item.paramType)
 		{
 			LogString sbuf;
 			item.converter->format(event, sbuf, p);
@@ -531,7 +577,7 @@ void ODBCAppender::ODBCAppenderPriv::setParameterValues(const spi::LoggingEventP
 			std::wstring tmp;
 			Transcoder::encode(sbuf, tmp);
 #endif
-			auto dst = (wchar_t*)item.paramValue;
+			auto dst = (wchar_t*)value;
 			auto charCount = std::min(size_t(item.paramMaxCharCount), tmp.size());
 			auto copySize = std::min(size_t(item.paramValueSize - 1), charCount * sizeof(wchar_t));
 			std::memcpy(dst, tmp.data(), copySize);
@@ -547,7 +593,7 @@ void ODBCAppender::ODBCAppenderPriv::setParameterValues(const spi::LoggingEventP
 			std::string tmp;
 			Transcoder::encode(sbuf, tmp);
 #endif
-			auto dst = (char*)item.paramValue;
+			auto dst = value;
 			auto sz = std::min(size_t(item.paramMaxCharCount), tmp.size());
 			auto copySize = std::min(size_t(item.paramValueSize - 1), sz * sizeof(char));
 			std::memcpy(dst, tmp.data(), copySize);
@@ -559,7 +605,7 @@ void ODBCAppender::ODBCAppenderPriv::setParameterValues(const spi::LoggingEventP
 			apr_status_t stat = this->timeZone->explode(&exploded, event->getTimeStamp());
 			if (stat == APR_SUCCESS)
 			{
-				auto dst = (SQL_TIMESTAMP_STRUCT*)item.paramValue;
+				auto dst = (SQL_TIMESTAMP_STRUCT*)value;
 				dst->year = 1900 + exploded.tm_year;
 				dst->month = 1 + exploded.tm_mon;
 				dst->day = exploded.tm_mday;
@@ -579,33 +625,139 @@ void ODBCAppender::ODBCAppenderPriv::setParameterValues(const spi::LoggingEventP
 		}
 	}
 }
-#endif
 
-void ODBCAppender::flushBuffer(Pool& p)
+void ODBCAppender::ODBCAppenderPriv::insertRows(ODBCAppender* owner, const std::vector<spi::LoggingEventPtr>& events, Pool& p)
 {
-	for (auto& logEvent : _priv->buffer)
+	try
 	{
-		if (_priv->parameterValue.empty())
-			_priv->errorHandler->error(LOG4CXX_STR("ODBCAppender column mappings not defined"));
-#if LOG4CXX_HAVE_ODBC
-		else try
+		if (0 == this->preparedStatement)
+			setPreparedStatement(owner->getConnection(p), p);
+	}
+	catch (SQLException& e)
+	{
+		this->errorHandler->error(LOG4CXX_STR("Failed to execute sql"), e,
+			ErrorCode::FLUSH_FAILURE);
+		return;
+	}
+	// A failure in one chunk does not prevent insertion of the remaining chunks
+	for (size_t start = 0; start < events.size(); start += this->rowCapacity)
+	{
+		auto count = std::min(this->rowCapacity, events.size() - start);
+		try
 		{
-			if (0 == _priv->preparedStatement)
-				_priv->setPreparedStatement(getConnection(p), p);
-			_priv->setParameterValues(logEvent, p);
-			auto ret = SQLExecute(_priv->preparedStatement);
+			for (size_t row = 0; row < count; ++row)
+				setParameterValues(events[start + row], row, p);
+			if (count != this->rowCount)
+			{
+				auto ret = SQLSetStmtAttr(this->preparedStatement, SQL_ATTR_PARAMSET_SIZE, (SQLPOINTER) (SQLULEN) count, 0);
+				if (ret < 0)
+				{
+					throw SQLException(SQL_HANDLE_STMT, this->preparedStatement, "Failed to set parameter array size", p);
+				}
+				this->rowCount = count;
+			}
+			this->paramsProcessed = 0;
+			auto ret = SQLExecute(this->preparedStatement);
 			if (ret < 0)
 			{
-				throw SQLException(SQL_HANDLE_STMT, _priv->preparedStatement, "Failed to execute prepared statement", p);
+				throw SQLException(SQL_HANDLE_STMT, this->preparedStatement, "Failed to execute prepared statement", p);
+			}
+			if (!this->paramStatus.empty())
+			{
+				size_t failedCount = 0;
+				auto processedCount = std::min(size_t(this->paramsProcessed), count);
+				for (size_t row = 0; row < processedCount; ++row)
+				{
+					if (SQL_PARAM_ERROR == this->paramStatus[row])
+						++failedCount;
+				}
+				if (0 < failedCount)
+				{
+					LogString msg;
+					helpers::StringHelper::toString(failedCount, p, msg);
+					msg += LOG4CXX_STR(" of ");
+					helpers::StringHelper::toString(count, p, msg);
+					msg += LOG4CXX_STR(" logging events were not inserted");
+					this->errorHandler->error(msg,
+						SQLException(SQL_HANDLE_STMT, this->preparedStatement, "Failed to insert rows", p),
+						ErrorCode::FLUSH_FAILURE);
+				}
 			}
 		}
 		catch (SQLException& e)
 		{
-			_priv->errorHandler->error(LOG4CXX_STR("Failed to execute sql"), e,
+			this->errorHandler->error(LOG4CXX_STR("Failed to execute sql"), e,
 				ErrorCode::FLUSH_FAILURE);
 		}
-#endif
 	}
+}
+
+void ODBCAppender::ODBCAppenderPriv::queueBuffer()
+{
+	bool reportDiscard = false;
+	{
+		std::lock_guard<std::mutex> lock(this->flushMutex);
+		// Hold no more than 8 buffers of events for the flush thread
+		if (8 * std::max(this->bufferSize, size_t(1)) < this->pendingEvents.size() + this->buffer.size())
+		{
+			reportDiscard = !this->discarding;
+			this->discarding = true;
+		}
+		else
+		{
+			this->pendingEvents.insert(this->pendingEvents.end(), this->buffer.begin(), this->buffer.end());
+			this->discarding = false;
+			this->flushRequested.notify_one();
+		}
+	}
+	if (reportDiscard)
+		LogLog::warn(LOG4CXX_STR("Discarding logging events: the database is not keeping up"));
+}
+
+void ODBCAppender::ODBCAppenderPriv::flushPending(ODBCAppender* owner)
+{
+	std::vector<spi::LoggingEventPtr> events;
+	std::unique_lock<std::mutex> lock(this->flushMutex);
+	for (;;)
+	{
+		this->flushRequested.wait(lock, [this]
+			{ return this->stopFlushing || !this->pendingEvents.empty(); }
+			);
+		if (this->pendingEvents.empty())
+			break; // Stopping with nothing to insert
+		events.swap(this->pendingEvents);
+		lock.unlock();
+		Pool p;
+		insertRows(owner, events, p);
+		events.clear();
+		lock.lock();
+	}
+}
+
+void ODBCAppender::ODBCAppenderPriv::stopFlushThread()
+{
+	{
+		std::lock_guard<std::mutex> lock(this->flushMutex);
+		this->stopFlushing = true;
+		this->flushRequested.notify_one();
+	}
+	if (this->flushThread.joinable())
+		this->flushThread.join();
+}
+#endif
+
+void ODBCAppender::flushBuffer(Pool& p)
+{
+	if (_priv->buffer.empty())
+		;
+	else if (_priv->parameterValue.empty())
+		_priv->errorHandler->error(LOG4CXX_STR("ODBCAppender column mappings not defined"));
+#if LOG4CXX_HAVE_ODBC
+	else if (_priv->flushThread.joinable())
+		_priv->queueBuffer();
+	else
+		_priv->insertRows(this, _priv->buffer, p);
+#endif
 
 	// clear the buffer of reported events
 	_priv->buffer.clear();
@@ -699,3 +851,13 @@ size_t ODBCAppender::getBufferSize() const
 	return _priv->bufferSize;
 }
 
+void ODBCAppender::setBackgroundFlush(bool newValue)
+{
+	_priv->backgroundFlush = newValue;
+}
+
+bool ODBCAppender::getBackgroundFlush() const
+{
+	return _priv->backgroundFlush;
+}
+
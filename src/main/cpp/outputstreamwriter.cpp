@@ -21,6 +21,8 @@
 #include <log4cxx/helpers/charsetencoder.h>
 #include <log4cxx/helpers/bytebuffer.h>
 #include <log4cxx/helpers/stringhelper.h>
+#include <log4cxx/private/log4cxx_private.h>
+#include <vector>
 
 using namespace LOG4CXX_NS;
 using namespace LOG4CXX_NS::helpers;
@@ -38,6 +40,85 @@ struct OutputStreamWriter::OutputStreamWriterPrivate{
 	CharsetEncoderPtr enc;
 };
 
+namespace
+{
+
+/**
+ * Storage, reused by the current thread, large enough to hold an encoded logging event.
+ */
+class EncodeBuffer
+{
+	public:
+		enum { StackSize = 1024, MaxCapacity = 256 * 1024 };
+
+		EncodeBuffer(size_t charCount)
+			: m_data(m_stackData)
+			, m_size(StackSize)
+		{
+			// Allow for the longest multi-byte sequence of any encoder
+			size_t required = charCount * 4 + 16;
+			if (required <= StackSize)
+				return;
+#if LOG4CXX_HAS_THREAD_LOCAL
+			auto& spare = getSpare();
+			if (!spare.inUse && required <= MaxCapacity)
+			{
+				if (spare.data.size() < required)
+					spare.data.resize(required);
+				spare.inUse = true;
+				m_spare = &spare;
+				m_data = spare.data.data();
+				m_size = spare.data.size();
+				return;
+			}
+#endif
+#ifdef LOG4CXX_MULTI_PROCESS
+			// Ensure the logging event is a single write system call to keep events from each process separate
+			m_heapData.resize(required);
+			m_data = m_heapData.data();
+			m_size = m_heapData.size();
+#endif
+		}
+
+		~EncodeBuffer()
+		{
+#if LOG4CXX_HAS_THREAD_LOCAL
+			if (m_spare)
+				m_spare->inUse = false;
+#endif
+		}
+
+		EncodeBuffer(const EncodeBuffer&) = delete;
+		EncodeBuffer& operator=(const EncodeBuffer&) = delete;
+
+		char* data() { return m_data; }
+		size_t size() const { return m_size; }
+
+	private:
+		char m_stackData[StackSize];
+		char* m_data;
+		size_t m_size;
+#ifdef LOG4CXX_MULTI_PROCESS
+		std::vector<char> m_heapData;
+#endif
+#if LOG4CXX_HAS_THREAD_LOCAL
+		struct Spare
+		{
+			std::vector<char> data;
+			bool inUse = false;
+		};
+		Spare* m_spare = nullptr;
+
+		static Spare& getSpare()
+		{
+			thread_local Spare spare;
+			return spare;
+		}
+#endif
+};
+
+} // namespace
+
 OutputStreamWriter::OutputStreamWriter(OutputStreamPtr& out1)
 	: m_priv(std::make_unique<OutputStreamWriterPrivate>(out1))
 {
@@ -87,35 +168,30 @@ void OutputStreamWriter::write(const LogString& str, Pool& p)
 	}
 	else
 	{
-		enum { BUFSIZE = 1024 };
-		char stackData[BUFSIZE];
-		char* rawbuf = stackData;
-		size_t bufSize = BUFSIZE;
-#ifdef LOG4CXX_MULTI_PROCESS
-		std::vector<char> heapData;
-		// Ensure the logging event is a single write system call to keep events from each process separate
-		if (bufSize < str.length() * 2)
-		{
-			heapData.resize(bufSize = str.length() * 2);
-			rawbuf = heapData.data();
-		}
-#endif
-		ByteBuffer buf(rawbuf, bufSize);
+		// Encode the whole event in a single pass where possible
+		// so it is passed to the output stream in one write
+		EncodeBuffer storage(str.length());
+		ByteBuffer buf(storage.data(), storage.size());
 		m_priv->enc->reset();
 		LogString::const_iterator iter = str.begin();
 
 		while (iter != str.end())
 		{
+			auto start = iter;
 			CharsetEncoder::encode(m_priv->enc, str, iter, buf);
-			buf.flip();
-			m_priv->out->write(buf, p);
-			buf.clear();
+			// Write the partially encoded event only when the buffer has insufficient space
+			if (iter != str.end() && (iter == start || buf.remaining() < 64))
+			{
+				buf.flip();
+				m_priv->out->write(buf, p);
+				buf.clear();
+			}
 		}
 
-		CharsetEncoder::encode(m_priv->enc, str, iter, buf);
 		m_priv->enc->flush(buf);
 		buf.flip();
-		m_priv->out->write(buf, p);
+		if (0 < buf.remaining())
+			m_priv->out->write(buf, p);
 	}
 }
 
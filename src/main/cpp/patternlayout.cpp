@@ -48,6 +48,9 @@
 #include <log4cxx/pattern/propertiespatternconverter.h>
 #include <log4cxx/pattern/throwableinformationpatternconverter.h>
 #include <log4cxx/pattern/threadusernamepatternconverter.h>
+#include <log4cxx/spi/loggingevent.h>
+#include <log4cxx/level.h>
+#include <limits.h>
 
 
 using namespace LOG4CXX_NS;
@@ -71,14 +74,48 @@ struct PatternLayout::PatternLayoutPrivate
 	LogString conversionPattern;
 
 	/**
-	 * Pattern converters.
+	 * A segment of the compiled conversion pattern.
 	 */
-	LoggingEventPatternConverterList patternConverters;
+	struct FormatStep
+	{
+		enum Kind
+		{
+			Literal,
+			Message,
+			LineSeparator,
+			Level,
+			Logger,
+			Thread,
+			Date,
+			Converter
+		};
+		Kind kind;
+
+		/**
+		 * The text of a Literal step.
+		 */
+		LogString literal;
+
+		/**
+		 * The converter of a Date or Converter step.
+		 */
+		LoggingEventPatternConverterPtr converter;
+
+		/**
+		 * Field width and alignment, null when the field is neither padded nor truncated.
+		 */
+		FormattingInfoPtr field;
+	};
+
+	/**
+	 * The conversion pattern as a sequence of steps.
+	 */
+	std::vector<FormatStep> steps;
 
 	/**
-	 * Field widths and alignment corresponding to pattern converters.
+	 * Append to \c steps the step that performs \c converter with \c field.
 	 */
-	FormattingInfoList patternFields;
+	void addStep(const LoggingEventPatternConverterPtr& converter, const FormattingInfoPtr& field);
 
 	LogString m_fatalColor = LOG4CXX_STR("\\x1B[35m"); //magenta
 	LogString m_errorColor = LOG4CXX_STR("\\x1B[31m"); //red
@@ -123,19 +160,80 @@ void PatternLayout::format(LogString& output,
 	Pool& pool) const
 {
 	output.reserve(m_priv->expectedPatternLength + event->getMessage().size());
-	std::vector<FormattingInfoPtr>::const_iterator formatterIter =
-		m_priv->patternFields.begin();
-
-	for (std::vector<LoggingEventPatternConverterPtr>::const_iterator
-		converterIter = m_priv->patternConverters.begin();
-		converterIter != m_priv->patternConverters.end();
-		converterIter++, formatterIter++)
+	using Step = PatternLayoutPrivate::FormatStep;
+	for (auto& step : m_priv->steps)
 	{
 		int startField = (int)output.length();
-		(*converterIter)->format(event, output, pool);
-		(*formatterIter)->format(startField, output);
+		switch (step.kind)
+		{
+		case Step::Literal:
+			output.append(step.literal);
+			break;
+		case Step::Message:
+			output.append(event->getRenderedMessage());
+			break;
+		case Step::LineSeparator:
+			output.append(LOG4CXX_EOL);
+			break;
+		case Step::Level:
+			output.append(event->getLevel()->toString());
+			break;
+		case Step::Logger:
+			output.append(event->getLoggerName());
+			break;
+		case Step::Thread:
+			output.append(event->getThreadName());
+			break;
+		case Step::Date:
+			static_cast<DatePatternConverter*>(step.converter.get())->DatePatternConverter::format(event, output, pool);
+			break;
+		default:
+			step.converter->format(event, output, pool);
+			break;
+		}
+		if (step.field)
+			step.field->format(startField, output);
 	}
+}
 
+void PatternLayout::PatternLayoutPrivate::addStep
+	( const LoggingEventPatternConverterPtr& converter
+	, const FormattingInfoPtr&               field
+	)
+{
+	FormatStep step{ FormatStep::Converter, LogString(), converter, field };
+	if (0 == field->getMinLength() && INT_MAX == field->getMaxLength())
+		step.field.reset();
+	auto& type = converter->getClass();
+	if (&type == &LiteralPatternConverter::getStaticClass())
+	{
+		step.kind = FormatStep::Literal;
+		Pool p;
+		converter->format(LoggingEventPtr(), step.literal, p);
+		step.converter.reset();
+		if (!step.field && !this->steps.empty()
+			&& FormatStep::Literal == this->steps.back().kind
+			&& !this->steps.back().field)
+		{
+			this->steps.back().literal.append(step.literal);
+			return;
+		}
+	}
+	else if (&type == &DatePatternConverter::getStaticClass())
+		step.kind = FormatStep::Date;
+	else if (&type == &LevelPatternConverter::getStaticClass())
+		step.kind = FormatStep::Level;
+	else if (&type == &ThreadPatternConverter::getStaticClass())
+		step.kind = FormatStep::Thread;
+	else if (&type == &LineSeparatorPatternConverter::getStaticClass())
+		step.kind = FormatStep::LineSeparator;
+	else if (converter == MessagePatternConverter::newInstance(OptionsList()))
+		step.kind = FormatStep::Message; // not quoted
+	else if (converter == LoggerPatternConverter::newInstance(OptionsList()))
+		step.kind = FormatStep::Logger; // not abbreviated
+	if (FormatStep::Converter != step.kind && FormatStep::Date != step.kind)
+		step.converter.reset();
+	this->steps.push_back(std::move(step));
 }
 
 void PatternLayout::setOption(const LogString& option, const LogString& value)
@@ -187,24 +285,26 @@ void PatternLayout::activateOptions(Pool&)
 		pat = LOG4CXX_STR("%m%n");
 	}
 
-	m_priv->patternConverters.erase(m_priv->patternConverters.begin(), m_priv->patternConverters.end());
-	m_priv->patternFields.erase(m_priv->patternFields.begin(), m_priv->patternFields.end());
+	m_priv->steps.clear();
 	std::vector<PatternConverterPtr> converters;
+	FormattingInfoList fields;
 	PatternParser::parse(pat,
 		converters,
-		m_priv->patternFields,
+		fields,
 		getFormatSpecifiers());
 
 	//
 	//   strip out any pattern converters that don't handle LoggingEvents
+	//   and merge adjacent literals
 	//
-	//
+	auto fieldIter = fields.begin();
 	for (auto const& converterItem : converters)
 	{
 		if (auto eventConverter = LOG4CXX_NS::cast<LoggingEventPatternConverter>(converterItem))
 		{
-			m_priv->patternConverters.push_back(eventConverter);
+			m_priv->addStep(eventConverter, *fieldIter);
 		}
+		++fieldIter;
 	}
 	m_priv->expectedPatternLength = getFormattedEventCharacterCount() * 2;
 }
@@ -26,6 +26,7 @@
 #include <log4cxx/rolling/timebasedrollingpolicy.h>
 #include <log4cxx/rolling/sizebasedtriggeringpolicy.h>
 #include <log4cxx/helpers/transcoder.h>
+#include <log4cxx/helpers/date.h>
 #include <log4cxx/private/rollingfileappender_priv.h>
 #include <mutex>
 
@@ -38,6 +39,50 @@ using namespace LOG4CXX_NS::spi;
 
 IMPLEMENT_LOG4CXX_OBJECT(RollingFileAppender)
 
+namespace
+{
+
+/**
+ * A rollover of a file that was moved aside while
+ * a previous rollover's asynchronous action was in progress.
+ */
+class DeferredRolloverAction : public Action
+{
+	public:
+		DeferredRolloverAction(const RollingPolicyPtr& policy1, const LogString& fileName1, bool append1)
+			: policy(policy1)
+			, fileName(fileName1)
+			, append(append1)
+		{
+		}
+
+		bool execute(Pool& p) const override
+		{
+			auto rollover1 = policy->rollover(fileName, append, p);
+			if (!rollover1)
+				throw IOException(LOG4CXX_STR("Unable to roll over [") + fileName + LOG4CXX_STR("]"));
+			if (auto syncAction = rollover1->getSynchronous())
+			{
+				if (!syncAction->execute(p))
+					throw IOException(LOG4CXX_STR("Unable to rename [") + fileName + LOG4CXX_STR("]"));
+			}
+			File file;
+			file.setPath(fileName);
+			if (file.exists(p) && 0 == file.length(p)) // Empty files are not renamed
+				file.deleteFile(p);
+			if (auto asyncAction = rollover1->getAsynchronous())
+				asyncAction->execute(p);
+			return true;
+		}
+
+	private:
+		RollingPolicyPtr policy;
+		LogString fileName;
+		bool append;
+};
+
+} // namespace
+
 
 /**
  * Construct a new instance.
@@ -52,6 +97,98 @@ RollingFileAppender::RollingFileAppender( std::unique_ptr<RollingFileAppenderPri
 {
 }
 
+RollingFileAppender::RollingFileAppenderPriv::~RollingFileAppenderPriv()
+{
+	stopAsyncActions();
+}
+
+size_t RollingFileAppender::RollingFileAppenderPriv::getActiveFileLength(const LogString& fileName, Pool& p)
+{
+	return File().setPath(fileName).length(p);
+}
+
+void RollingFileAppender::RollingFileAppenderPriv::addAsyncAction
+	( const ActionPtr&             action
+	, const LogString&             fileName
+	, const spi::ErrorHandlerPtr& errorHandler
+	)
+{
+	std::lock_guard<std::mutex> lock(this->actionMutex);
+	this->pendingActions.push_back(PendingAction{ action, fileName, errorHandler });
+	if (!this->actionThread.joinable())
+	{
+		this->stopActionThread = false;
+		this->actionThread = ThreadUtility::instance()->createThread
+			( LOG4CXX_STR("RollingFileAppender")
+			, &RollingFileAppenderPriv::executeAsyncActions
+			, this
+			);
+	}
+	this->actionChanged.notify_all();
+}
+
+bool RollingFileAppender::RollingFileAppenderPriv::hasAsyncActions()
+{
+	std::lock_guard<std::mutex> lock(this->actionMutex);
+	return !this->pendingActions.empty();
+}
+
+void RollingFileAppender::RollingFileAppenderPriv::waitForAsyncActions()
+{
+	std::unique_lock<std::mutex> lock(this->actionMutex);
+	this->actionChanged.wait(lock, [this]() -> bool
+		{ return this->pendingActions.empty(); });
+}
+
+void RollingFileAppender::RollingFileAppenderPriv::stopAsyncActions()
+{
+	{
+		std::lock_guard<std::mutex> lock(this->actionMutex);
+		this->stopActionThread = true;
+		this->actionChanged.notify_all();
+	}
+	if (this->actionThread.joinable())
+		this->actionThread.join();
+}
+
+void RollingFileAppender::RollingFileAppenderPriv::executeAsyncActions()
+{
+	std::unique_lock<std::mutex> lock(this->actionMutex);
+	for (;;)
+	{
+		this->actionChanged.wait(lock, [this]() -> bool
+			{ return this->stopActionThread || !this->pendingActions.empty(); });
+		if (this->pendingActions.empty())
+			break;
+		auto item = this->pendingActions.front();
+		lock.unlock();
+		try
+		{
+			Pool p;
+			item.action->execute(p);
+		}
+		catch (std::exception& ex)
+		{
+			LogString msg(LOG4CXX_STR("Rollover of ["));
+			msg.append(item.fileName);
+			msg.append(LOG4CXX_STR("] failed"));
+			if (item.errorHandler)
+				item.errorHandler->error(msg, ex, 0);
+		}
+		catch (...)
+		{
+			LogString msg(LOG4CXX_STR("Rollover of ["));
+			msg.append(item.fileName);
+			msg.append(LOG4CXX_STR("] failed"));
+			if (item.errorHandler)
+				item.errorHandler->error(msg);
+		}
+		lock.lock();
+		this->pendingActions.pop_front();
+		this->actionChanged.notify_all();
+	}
+}
+
 void RollingFileAppender::setOption(const LogString& option, const LogString& value)
 {
 	if (StringHelper::equalsIgnoreCase(option,
@@ -213,6 +350,7 @@ void RollingFileAppender::activateOptions(Pool& p)
 
 		try
 		{
+			_priv->waitForAsyncActions();
 			RolloverDescriptionPtr rollover1 =
 				_priv->rollingPolicy->initialize(getFile(), getAppend(), p);
 
@@ -228,14 +366,11 @@ void RollingFileAppender::activateOptions(Pool& p)
 				_priv->fileName = rollover1->getActiveFileName();
 				_priv->fileAppend = rollover1->getAppend();
 
-				//
-				//  async action not yet implemented
-				//
 				ActionPtr asyncAction(rollover1->getAsynchronous());
 
 				if (asyncAction != NULL)
 				{
-					asyncAction->execute(p);
+					_priv->addAsyncAction(asyncAction, getFile(), _priv->errorHandler);
 				}
 			}
 
@@ -294,6 +429,39 @@ bool RollingFileAppender::rolloverInternal(Pool& p)
 		{
 				try
 				{
+					// A FixedWindowRollingPolicy renames the files that the previous
+					// rollover's compression may still be using,
+					// so move the active file aside and queue this rollover behind it
+					if (_priv->hasAsyncActions()
+						&& LOG4CXX_NS::cast<FixedWindowRollingPolicy>(_priv->rollingPolicy))
+					{
+						// The name must not match a file left by a rollover
+						// that was still queued when a previous process ended
+						LogString pendingFile;
+						do
+						{
+							pendingFile = getFile();
+							pendingFile.append(LOG4CXX_STR(".rollover"));
+							StringHelper::toString((int64_t) Date::currentTime(), p, pendingFile);
+							pendingFile.append(1, logchar(0x2D) /* '-' */);
+							StringHelper::toString(++_priv->deferredRolloverCount, p, pendingFile);
+						} while (File().setPath(pendingFile).exists(p));
+						closeWriter();
+						if (File().setPath(getFile()).renameTo(File().setPath(pendingFile), p))
+						{
+							_priv->addAsyncAction
+								( std::make_shared<DeferredRolloverAction>(_priv->rollingPolicy, pendingFile, getAppend())
+								, getFile()
+								, _priv->errorHandler
+								);
+							_priv->fileLength = 0;
+							setFileInternal(getFile(), getAppend(), _priv->bufferedIO, _priv->bufferSize, p);
+							return true;
+						}
+						// The file could not be moved aside, so wait for its archived files to be free
+						_priv->waitForAsyncActions();
+					}
+
 					RolloverDescriptionPtr rollover1(_priv->rollingPolicy->rollover(this->getFile(), this->getAppend(), p));
 
 					if (rollover1 != NULL)
@@ -327,7 +495,7 @@ bool RollingFileAppender::rolloverInternal(Pool& p)
 								appendToExisting = rollover1->getAppend();
 								if (appendToExisting)
 								{
-									_priv->fileLength = File().setPath(rollover1->getActiveFileName()).length(p);
+									_priv->fileLength = _priv->getActiveFileLength(rollover1->getActiveFileName(), p);
 								}
 								else
 								{
@@ -338,17 +506,7 @@ bool RollingFileAppender::rolloverInternal(Pool& p)
 
 								if (asyncAction != NULL)
 								{
-									try
-									{
-										asyncAction->execute(p);
-									}
-									catch (std::exception& ex)
-									{
-										LogString msg(LOG4CXX_STR("Rollover of ["));
-										msg.append(getFile());
-										msg.append(LOG4CXX_STR("] failed"));
-										_priv->errorHandler->error(msg, ex, 0);
-									}
+									_priv->addAsyncAction(asyncAction, getFile(), _priv->errorHandler);
 								}
 							}
 							setFileInternal(rollover1->getActiveFileName(), appendToExisting, _priv->bufferedIO, _priv->bufferSize, p);
@@ -359,8 +517,9 @@ bool RollingFileAppender::rolloverInternal(Pool& p)
 							setFileInternal(rollover1->getActiveFileName());
 							// Call activateOptions to create any intermediate directories(if required)
 							FileAppender::activateOptionsInternal(p);
-							OutputStreamPtr os(new FileOutputStream(
-									rollover1->getActiveFileName(), rollover1->getAppend()));
+							OutputStreamPtr os = _priv->createOutputStream(
+									rollover1->getActiveFileName(), rollover1->getAppend());
+							os = _priv->createGroupCommitStream(os, _priv->bufferSize);
 							WriterPtr newWriter(createWriter(os));
 							setWriterInternal(newWriter);
 
@@ -387,7 +546,7 @@ bool RollingFileAppender::rolloverInternal(Pool& p)
 							{
 								if (rollover1->getAppend())
 								{
-									_priv->fileLength = File().setPath(rollover1->getActiveFileName()).length(p);
+									_priv->fileLength = _priv->getActiveFileLength(rollover1->getActiveFileName(), p);
 								}
 								else
 								{
@@ -398,7 +557,7 @@ bool RollingFileAppender::rolloverInternal(Pool& p)
 
 								if (asyncAction != NULL)
 								{
-									asyncAction->execute(p);
+									_priv->addAsyncAction(asyncAction, getFile(), _priv->errorHandler);
 								}
 							}
 
@@ -491,6 +650,7 @@ void RollingFileAppender::setTriggeringPolicy(const TriggeringPolicyPtr& policy)
 void RollingFileAppender::close()
 {
 	FileAppender::close();
+	_priv->stopAsyncActions();
 }
 
 namespace LOG4CXX_NS
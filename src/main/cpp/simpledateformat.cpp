@@ -28,6 +28,8 @@
 #endif
 #include <log4cxx/private/log4cxx_private.h>
 #include <log4cxx/helpers/pool.h>
+#include <atomic>
+#include <mutex>
 
 using namespace LOG4CXX_NS;
 using namespace LOG4CXX_NS::helpers;
@@ -94,7 +96,6 @@ class PatternToken
 			const apr_time_exp_t& date,
 			LOG4CXX_NS::helpers::Pool& p) const = 0;
 
-	protected:
 
 		static void incrementMonth(tm& time, apr_time_exp_t& aprtime)
 		{
@@ -627,7 +628,345 @@ class RFC822TimeZoneToken : public PatternToken
 };
 
 
+/**
+ * A component of a pattern that contains only numeric, month name and literal specifiers.
+ */
+struct NumericField
+{
+	enum Kind
+	{
+		Literal,
+		Year,
+		Month,
+		AbbreviatedMonthName,
+		FullMonthName,
+		WeekInYear,
+		WeekInMonth,
+		DayInYear,
+		DayInMonth,
+		MilitaryHour,
+		MilitaryHourFromOne,
+		Hour,
+		Minute,
+		Second,
+		Millisecond,
+		Microsecond
+	};
+
+	Kind kind;
+	int width; //!< The minimum number of digits or the number of literal characters
+	logchar ch; //!< The literal character
+};
+
+typedef std::vector<NumericField> NumericFieldList;
+
+/**
+ * The localized month names used by a NumericFieldList,
+ * abbreviated names first, then full names.
+ */
+typedef std::vector<LogString> MonthNameList;
 
+/**
+ * Append \c value to \c s using at least \c width digits.
+ */
+void appendNumber(LogString& s, int value, int width)
+{
+	static const char digitPairs[] =
+		"0001020304050607080910111213141516171819"
+		"2021222324252627282930313233343536373839"
+		"4041424344454647484950515253545556575859"
+		"6061626364656667686970717273747576777879"
+		"8081828384858687888990919293949596979899";
+	logchar digits[12];
+	logchar* const end = digits + sizeof(digits) / sizeof(digits[0]);
+	logchar* start = end;
+	unsigned int remaining = value < 0 ? 0u - (unsigned int)value : (unsigned int)value;
+
+	while (100 <= remaining)
+	{
+		const char* pair = &digitPairs[(remaining % 100) * 2];
+		*--start = pair[1];
+		*--start = pair[0];
+		remaining /= 100;
+	}
+
+	if (10 <= remaining)
+	{
+		const char* pair = &digitPairs[remaining * 2];
+		*--start = pair[1];
+		*--start = pair[0];
+	}
+	else
+	{
+		*--start = (logchar) (0x30 + remaining);
+	}
+
+	if (value < 0)
+	{
+		*--start = 0x2D; // '-'
+	}
+
+	int digitCount = (int) (end - start);
+
+	if (digitCount < width)
+	{
+		s.append(width - digitCount, (logchar) 0x30 /* '0' */);
+	}
+
+	s.append(start, end);
+}
+
+/**
+ * Append the field of \c spec to \c fields,
+ * adding the month names of \c locale to \c monthNames when \c spec is a month name.
+ *
+ * @returns false if \c spec is not a numeric, month name or literal specifier.
+ */
+bool addNumericField(logchar spec, int repeat, const std::locale* locale, NumericFieldList& fields, MonthNameList& monthNames)
+{
+	NumericField field{NumericField::Literal, repeat, spec};
+
+	switch (spec)
+	{
+		case 0x79: // 'y'
+			field.kind = NumericField::Year;
+			break;
+
+		case 0x4D: // 'M'
+			if (repeat <= 2)
+			{
+				field.kind = NumericField::Month;
+				break;
+			}
+
+			if (monthNames.empty())
+			{
+				MonthNameList fullNames(12);
+				monthNames.resize(12);
+				PatternToken::renderFacet(locale, PatternToken::incrementMonth, 'b', 0x62, "%b", monthNames);
+				PatternToken::renderFacet(locale, PatternToken::incrementMonth, 'B', 0x42, "%B", fullNames);
+				monthNames.insert(monthNames.end(), fullNames.begin(), fullNames.end());
+			}
+
+			field.kind = repeat <= 3 ? NumericField::AbbreviatedMonthName : NumericField::FullMonthName;
+			break;
+
+		case 0x77: // 'w'
+			field.kind = NumericField::WeekInYear;
+			break;
+
+		case 0x57: // 'W'
+			field.kind = NumericField::WeekInMonth;
+			break;
+
+		case 0x44: // 'D'
+			field.kind = NumericField::DayInYear;
+			break;
+
+		case 0x64: // 'd'
+			field.kind = NumericField::DayInMonth;
+			break;
+
+		case 0x48: // 'H'
+			field.kind = NumericField::MilitaryHour;
+			break;
+
+		case 0x6B: // 'k'
+			field.kind = NumericField::MilitaryHourFromOne;
+			break;
+
+		case 0x4B: // 'K'
+		case 0x68: // 'h'
+			field.kind = NumericField::Hour;
+			break;
+
+		case 0x6D: // 'm'
+			field.kind = NumericField::Minute;
+			break;
+
+		case 0x73: // 's'
+			field.kind = NumericField::Second;
+			break;
+
+		case 0x53: // 'S'
+			field.kind = repeat == 6 ? NumericField::Microsecond : NumericField::Millisecond;
+			break;
+
+		case 0x47: // 'G'
+		case 0x46: // 'F'
+		case 0x45: // 'E'
+		case 0x61: // 'a'
+		case 0x7A: // 'z'
+		case 0x5A: // 'Z'
+			return false;
+
+		default:
+			break;
+	}
+
+	fields.push_back(field);
+	return true;
+}
+
+/**
+ * Convert \c fmt to a list of numeric, month name and literal fields.
+ *
+ * @returns false if \c fmt contains a specifier that is not numeric, a month name or literal.
+ */
+bool compileNumericPattern(const LogString& fmt, const std::locale* locale, NumericFieldList& fields, MonthNameList& monthNames)
+{
+	if (fmt.empty())
+	{
+		return false;
+	}
+
+	LogString::const_iterator iter = fmt.begin();
+	int repeat = 1;
+	logchar prevChar = *iter;
+
+	for (iter++; iter != fmt.end(); iter++)
+	{
+		if (*iter == prevChar)
+		{
+			repeat++;
+		}
+		else
+		{
+			if (!addNumericField(prevChar, repeat, locale, fields, monthNames))
+			{
+				return false;
+			}
+
+			prevChar = *iter;
+			repeat = 1;
+		}
+	}
+
+	return addNumericField(prevChar, repeat, locale, fields, monthNames);
+}
+
+/**
+ * Append the value of each of \c fields in \c tm to \c s.
+ *
+ * Produces the same text as the equivalent PatternToken list.
+ */
+void formatNumeric(LogString& s, const apr_time_exp_t& tm, const NumericFieldList& fields, const MonthNameList& monthNames)
+{
+	for (auto& field : fields)
+	{
+		switch (field.kind)
+		{
+			case NumericField::Literal:
+				s.append(field.width, field.ch);
+				break;
+
+			case NumericField::Year:
+				appendNumber(s, 1900 + tm.tm_year, field.width);
+				break;
+
+			case NumericField::Month:
+				appendNumber(s, tm.tm_mon + 1, field.width);
+				break;
+
+			case NumericField::AbbreviatedMonthName:
+				s.append(monthNames[tm.tm_mon]);
+				break;
+
+			case NumericField::FullMonthName:
+				s.append(monthNames[12 + tm.tm_mon]);
+				break;
+
+			case NumericField::WeekInYear:
+				appendNumber(s, tm.tm_yday / 7, field.width);
+				break;
+
+			case NumericField::WeekInMonth:
+				appendNumber(s, tm.tm_mday / 7, field.width);
+				break;
+
+			case NumericField::DayInYear:
+				appendNumber(s, tm.tm_yday, field.width);
+				break;
+
+			case NumericField::DayInMonth:
+				appendNumber(s, tm.tm_mday, field.width);
+				break;
+
+			case NumericField::MilitaryHour:
+				appendNumber(s, tm.tm_hour, field.width);
+				break;
+
+			case NumericField::MilitaryHourFromOne:
+				appendNumber(s, tm.tm_hour + 1, field.width);
+				break;
+
+			case NumericField::Hour:
+				appendNumber(s, tm.tm_hour % 12, field.width);
+				break;
+
+			case NumericField::Minute:
+				appendNumber(s, tm.tm_min, field.width);
+				break;
+
+			case NumericField::Second:
+				appendNumber(s, tm.tm_sec, field.width);
+				break;
+
+			case NumericField::Millisecond:
+				appendNumber(s, tm.tm_usec / 1000, field.width);
+				break;
+
+			case NumericField::Microsecond:
+				appendNumber(s, tm.tm_usec, field.width);
+				break;
+		}
+	}
+}
+
+/**
+ * The exploded time at the start of a quarter hour in local time.
+ *
+ * Time zone offsets change on a quarter hour boundary,
+ * so only the minute, second and microsecond vary within the quarter hour.
+ */
+struct QuarterHour
+{
+	enum : log4cxx_time_t { Duration = 15 * 60 * 1000000LL };
+
+	/**
+	 * The SimpleDateFormat instance identifier.
+	 */
+	uint64_t id = 0;
+
+	/**
+	 * The SimpleDateFormat generation when this was initialized.
+	 */
+	unsigned generation = 0;
+
+	/**
+	 * The first time in the quarter hour.
+	 */
+	log4cxx_time_t begin = 0;
+
+	/**
+	 * The time following the quarter hour, or \c begin when there is no value.
+	 */
+	log4cxx_time_t end = 0;
+
+	/**
+	 * The components of \c begin.
+	 */
+	apr_time_exp_t exploded;
+
+	void reset(uint64_t newId, unsigned newGeneration)
+	{
+		this->id = newId;
+		this->generation = newGeneration;
+		this->begin = this->end = 0;
+	}
+};
+
+std::atomic<uint64_t> nextInstanceId{ 1 };
 
 }
 }
@@ -789,7 +1128,10 @@ void SimpleDateFormat::parsePattern( const LogString& fmt, const std::locale* lo
 
 struct SimpleDateFormat::SimpleDateFormatPrivate{
 	SimpleDateFormatPrivate() :
-		timeZone(TimeZone::getDefault())
+		timeZone(TimeZone::getDefault()),
+		isNumeric(false),
+		id(nextInstanceId++),
+		generation(0)
 	{}
 
 	/**
@@ -801,6 +1143,106 @@ struct SimpleDateFormat::SimpleDateFormatPrivate{
 	 * List of tokens.
 	 */
 	PatternTokenList pattern;
+
+	/**
+	 * Does the pattern contain only numeric, month name and literal specifiers?
+	 */
+	bool isNumeric;
+
+	/**
+	 * The pattern components when isNumeric is true.
+	 */
+	NumericFieldList numericPattern;
+
+	/**
+	 * The month names used by numericPattern.
+	 */
+	MonthNameList monthNames;
+
+	/**
+	 * Identifies the cached quarter hour of this instance.
+	 */
+	const uint64_t id;
+
+	/**
+	 * Incremented when the cached quarter hour becomes invalid.
+	 */
+	std::atomic<unsigned> generation;
+
+#if LOG4CXX_HAS_THREAD_LOCAL
+	enum { ThreadCacheCount = 8 };
+
+	/**
+	 * The cached quarter hour of this instance used by the calling thread.
+	 */
+	QuarterHour& getQuarterHour() const
+	{
+		thread_local QuarterHour quarterHours[ThreadCacheCount];
+		auto& result = quarterHours[this->id % ThreadCacheCount];
+		auto currentGeneration = this->generation.load(std::memory_order_acquire);
+		if (result.id != this->id || result.generation != currentGeneration)
+			result.reset(this->id, currentGeneration);
+		return result;
+	}
+#else
+	/**
+	 * Serializes use of sharedQuarterHour.
+	 */
+	mutable std::mutex mutex;
+
+	/**
+	 * The cached quarter hour of this instance.
+	 */
+	mutable QuarterHour sharedQuarterHour;
+
+	QuarterHour& getQuarterHour() const
+	{
+		auto currentGeneration = this->generation.load(std::memory_order_acquire);
+		if (sharedQuarterHour.id != this->id || sharedQuarterHour.generation != currentGeneration)
+			sharedQuarterHour.reset(this->id, currentGeneration);
+		return sharedQuarterHour;
+	}
+#endif
+
+	/**
+	 * Put the components of \c time into \c result,
+	 * reusing the components of the previous quarter hour converted on this thread.
+	 */
+	apr_status_t explode(apr_time_exp_t* result, log4cxx_time_t time) const
+	{
+#if !LOG4CXX_HAS_THREAD_LOCAL
+		std::lock_guard<std::mutex> lock(this->mutex);
+#endif
+		auto& quarterHour = getQuarterHour();
+		if (quarterHour.begin <= time && time < quarterHour.end)
+		{
+			auto elapsed = time - quarterHour.begin;
+			*result = quarterHour.exploded;
+			result->tm_usec = (apr_int32_t) (elapsed % 1000000);
+			elapsed /= 1000000;
+			result->tm_sec = (apr_int32_t) (elapsed % 60);
+			result->tm_min += (apr_int32_t) (elapsed / 60);
+			return APR_SUCCESS;
+		}
+		apr_status_t stat = this->timeZone->explode(result, time);
+		if (stat == APR_SUCCESS)
+		{
+			auto begin = time - ((log4cxx_time_t) (result->tm_min % 15) * 60 + result->tm_sec) * 1000000 - result->tm_usec;
+			// Only reuse the components when the offset does not change within the quarter hour
+			apr_time_exp_t last;
+			if (this->timeZone->explode(&last, begin + QuarterHour::Duration - 1) == APR_SUCCESS
+				&& last.tm_gmtoff == result->tm_gmtoff)
+			{
+				quarterHour.begin = begin;
+				quarterHour.end = begin + QuarterHour::Duration;
+				quarterHour.exploded = *result;
+				quarterHour.exploded.tm_min -= result->tm_min % 15;
+				quarterHour.exploded.tm_sec = 0;
+				quarterHour.exploded.tm_usec = 0;
+			}
+		}
+		return stat;
+	}
 };
 
 SimpleDateFormat::SimpleDateFormat( const LogString& fmt ) : m_priv(std::make_unique<SimpleDateFormatPrivate>())
@@ -808,8 +1250,10 @@ SimpleDateFormat::SimpleDateFormat( const LogString& fmt ) : m_priv(std::make_un
 #if LOG4CXX_HAS_STD_LOCALE
 	std::locale defaultLocale;
 	parsePattern( fmt, & defaultLocale, m_priv->pattern );
+	m_priv->isNumeric = compileNumericPattern( fmt, & defaultLocale, m_priv->numericPattern, m_priv->monthNames );
 #else
 	parsePattern( fmt, NULL, m_priv->pattern );
+	m_priv->isNumeric = compileNumericPattern( fmt, NULL, m_priv->numericPattern, m_priv->monthNames );
 #endif
 
 	for (auto const& item : m_priv->pattern)
@@ -821,6 +1265,7 @@ SimpleDateFormat::SimpleDateFormat( const LogString& fmt ) : m_priv(std::make_un
 SimpleDateFormat::SimpleDateFormat( const LogString& fmt, const std::locale* locale ) : m_priv(std::make_unique<SimpleDateFormatPrivate>())
 {
 	parsePattern( fmt, locale, m_priv->pattern );
+	m_priv->isNumeric = compileNumericPattern( fmt, locale, m_priv->numericPattern, m_priv->monthNames );
 
 	for (auto const& item : m_priv->pattern)
 	{
@@ -841,18 +1286,31 @@ SimpleDateFormat::~SimpleDateFormat()
 void SimpleDateFormat::format( LogString& s, log4cxx_time_t time, Pool& p ) const
 {
 	apr_time_exp_t exploded;
-	apr_status_t stat = m_priv->timeZone->explode( & exploded, time );
+	apr_status_t stat = m_priv->explode( & exploded, time );
 
 	if ( stat == APR_SUCCESS )
 	{
-		for ( PatternTokenList::const_iterator iter = m_priv->pattern.begin(); iter != m_priv->pattern.end(); iter++ )
+		if ( m_priv->isNumeric )
 		{
-			( * iter )->format( s, exploded, p );
+			formatNumeric( s, exploded, m_priv->numericPattern, m_priv->monthNames );
+		}
+		else
+		{
+			for ( PatternTokenList::const_iterator iter = m_priv->pattern.begin(); iter != m_priv->pattern.end(); iter++ )
+			{
+				( * iter )->format( s, exploded, p );
+			}
 		}
 	}
 }
 
+bool SimpleDateFormat::isCompiled() const
+{
+	return m_priv->isNumeric;
+}
+
 void SimpleDateFormat::setTimeZone( const TimeZonePtr& zone )
 {
 	m_priv->timeZone = zone;
+	++m_priv->generation;
 }
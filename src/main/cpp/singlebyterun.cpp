@@ -0,0 +1,172 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <log4cxx/private/singlebyterun.h>
+#include <type_traits>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#define LOG4CXX_SINGLE_BYTE_RUN_USING_SSE2 1
+	#include <emmintrin.h>
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+	#endif
+#else
+	#define LOG4CXX_SINGLE_BYTE_RUN_USING_SSE2 0
+#endif
+
+using namespace LOG4CXX_NS;
+using namespace LOG4CXX_NS::helpers;
+
+namespace
+{
+
+#if LOG4CXX_SINGLE_BYTE_RUN_USING_SSE2
+/**
+ * The index of the least significant bit set in \c mask, which must not be zero.
+ */
+inline int firstBit(unsigned int mask)
+{
+#if defined(_MSC_VER)
+	unsigned long index;
+	_BitScanForward(&index, mask);
+	return int(index);
+#else
+	return __builtin_ctz(mask);
+#endif
+}
+
+/**
+ * A mask with a bit set for each byte of \c block in a character that is not less than \c limit.
+ */
+template <class CharType>
+inline unsigned int exceedsMask(__m128i block, unsigned int limit)
+{
+	const __m128i zero = _mm_setzero_si128();
+	__m128i highBits;
+	__m128i isBelow;
+	if (sizeof(CharType) == 1)
+	{
+		highBits = _mm_set1_epi8(static_cast<char>(~(limit - 1)));
+		isBelow = _mm_cmpeq_epi8(_mm_and_si128(block, highBits), zero);
+	}
+	else if (sizeof(CharType) == 2)
+	{
+		highBits = _mm_set1_epi16(static_cast<short>(~(limit - 1)));
+		isBelow = _mm_cmpeq_epi16(_mm_and_si128(block, highBits), zero);
+	}
+	else
+	{
+		highBits = _mm_set1_epi32(static_cast<int>(~(limit - 1)));
+		isBelow = _mm_cmpeq_epi32(_mm_and_si128(block, highBits), zero);
+	}
+	return ~static_cast<unsigned int>(_mm_movemask_epi8(isBelow)) & 0xFFFF;
+}
+#endif
+
+/**
+ * The number of characters at the start of [\c begin, \c end) with a value less than \c limit.
+ */
+template <class CharType>
+size_t lengthBelow(const CharType* begin, const CharType* end, unsigned int limit)
+{
+	auto p = begin;
+#if LOG4CXX_SINGLE_BYTE_RUN_USING_SSE2
+	const int perBlock = 16 / sizeof(CharType);
+	for (; perBlock <= end - p; p += perBlock)
+	{
+		auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+		if (auto mask = exceedsMask<CharType>(block, limit))
+			return (p - begin) + firstBit(mask) / sizeof(CharType);
+	}
+#endif
+	for (; p < end; ++p)
+	{
+		if (limit <= static_cast<unsigned int>(static_cast<typename std::make_unsigned<CharType>::type>(*p)))
+			break;
+	}
+	return p - begin;
+}
+
+} // namespace
+
+size_t SingleByteRun::length(const char* begin, const char* end, unsigned int limit)
+{
+	if (0xFF < limit)
+		return end - begin;
+	return lengthBelow(begin, end, limit);
+}
+
+size_t SingleByteRun::length(const wchar_t* begin, const wchar_t* end, unsigned int limit)
+{
+	return lengthBelow(begin, end, limit);
+}
+
+void SingleByteRun::copy(const char* begin, const char* end, wchar_t* dst)
+{
+	auto p = begin;
+#if LOG4CXX_SINGLE_BYTE_RUN_USING_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	for (; 16 <= end - p; p += 16)
+	{
+		auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+		auto low = _mm_unpacklo_epi8(block, zero);
+		auto high = _mm_unpackhi_epi8(block, zero);
+		auto out = reinterpret_cast<__m128i*>(dst);
+		if (sizeof(wchar_t) == 2)
+		{
+			_mm_storeu_si128(out, low);
+			_mm_storeu_si128(out + 1, high);
+		}
+		else
+		{
+			_mm_storeu_si128(out, _mm_unpacklo_epi16(low, zero));
+			_mm_storeu_si128(out + 1, _mm_unpackhi_epi16(low, zero));
+			_mm_storeu_si128(out + 2, _mm_unpacklo_epi16(high, zero));
+			_mm_storeu_si128(out + 3, _mm_unpackhi_epi16(high, zero));
+		}
+		dst += 16;
+	}
+#endif
+	for (; p < end; ++p, ++dst)
+		*dst = static_cast<wchar_t>(static_cast<unsigned char>(*p));
+}
+
+void SingleByteRun::copy(const wchar_t* begin, const wchar_t* end, char* dst)
+{
+	auto p = begin;
+#if LOG4CXX_SINGLE_BYTE_RUN_USING_SSE2
+	for (; 16 <= end - p; p += 16)
+	{
+		auto in = reinterpret_cast<const __m128i*>(p);
+		__m128i low;
+		__m128i high;
+		if (sizeof(wchar_t) == 2)
+		{
+			low = _mm_loadu_si128(in);
+			high = _mm_loadu_si128(in + 1);
+		}
+		else
+		{
+			low = _mm_packs_epi32(_mm_loadu_si128(in), _mm_loadu_si128(in + 1));
+			high = _mm_packs_epi32(_mm_loadu_si128(in + 2), _mm_loadu_si128(in + 3));
+		}
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm_packus_epi16(low, high));
+		dst += 16;
+	}
+#endif
+	for (; p < end; ++p, ++dst)
+		*dst = static_cast<char>(*p);
+}
@@ -71,6 +71,9 @@ void SocketAppenderSkeleton::close()
 {
 	_priv->stopMonitor();
 	cleanUp(_priv->pool);
+	// The sending thread may call fireConnector, so it is stopped without holding the mutex
+	if (auto sender = _priv->getSender())
+		sender->close();
 }
 
 void SocketAppenderSkeleton::connect(Pool& p)
@@ -84,6 +87,27 @@ void SocketAppenderSkeleton::connect(Pool& p)
 	{
 		cleanUp(p);
 
+		BufferedSocketPtr newSender;
+		if (0 < _priv->bufferSize)
+		{
+			newSender = std::make_shared<BufferedSocket>(_priv->address, _priv->port, _priv->bufferSize
+				, std::bind(&SocketAppenderSkeleton::fireConnector, this));
+		}
+		BufferedSocketPtr oldSender;
+		{
+			std::lock_guard<std::recursive_mutex> lock(_priv->mutex);
+			oldSender = std::move(_priv->sender);
+			_priv->sender = newSender;
+		}
+		// The sending thread may call fireConnector, so it is stopped without holding the mutex
+		if (oldSender)
+			oldSender->close();
+		if (newSender)
+		{
+			SocketPtr socket = newSender;
+			setSocket(socket, p);
+		}
+
 		try
 		{
 			if (LogLog::isDebugEnabled())
@@ -95,7 +119,10 @@ void SocketAppenderSkeleton::connect(Pool& p)
 				LogLog::debug(msg);
 			}
 			SocketPtr socket = Socket::create(_priv->address, _priv->port);
-			setSocket(socket, p);
+			if (newSender)
+				newSender->setConnection(socket);
+			else
+				setSocket(socket, p);
 		}
 		catch (SocketException& e)
 		{
@@ -128,6 +155,10 @@ void SocketAppenderSkeleton::setOption(const LogString& option, const LogString&
 	{
 		setReconnectionDelay(OptionConverter::toInt(value, getDefaultDelay()));
 	}
+	else if (StringHelper::equalsIgnoreCase(option, LOG4CXX_STR("BUFFERSIZE"), LOG4CXX_STR("buffersize")))
+	{
+		setBufferSize(OptionConverter::toFileSize(value, 0));
+	}
 	else
 	{
 		AppenderSkeleton::setOption(option, value);
@@ -189,7 +220,10 @@ void SocketAppenderSkeleton::retryConnect()
 				LogLog::debug(msg);
 			}
 			socket = Socket::create(_priv->address, _priv->port);
-			setSocket(socket, p);
+			if (auto sender = _priv->getSender())
+				sender->setConnection(socket);
+			else
+				setSocket(socket, p);
 			if (LogLog::isDebugEnabled())
 			{
 				LogString msg(LOG4CXX_STR("Connection established to [")
@@ -298,3 +332,25 @@ int SocketAppenderSkeleton::getReconnectionDelay() const
 {
 	return _priv->reconnectionDelay;
 }
+
+void SocketAppenderSkeleton::setBufferSize(int newValue)
+{
+	_priv->bufferSize = newValue;
+}
+
+int SocketAppenderSkeleton::getBufferSize() const
+{
+	return _priv->bufferSize;
+}
+
+size_t SocketAppenderSkeleton::getQueuedByteCount() const
+{
+	auto sender = _priv->getSender();
+	return sender ? sender->getQueuedByteCount() : 0;
+}
+
+size_t SocketAppenderSkeleton::getDiscardedByteCount() const
+{
+	auto sender = _priv->getSender();
+	return sender ? sender->getDiscardedByteCount() : 0;
+}
@@ -23,11 +23,13 @@
 #include <log4cxx/level.h>
 #include <log4cxx/helpers/transcoder.h>
 #include <log4cxx/helpers/optionconverter.h>
+#include <log4cxx/helpers/threadutility.h>
 #if !defined(LOG4CXX)
 	#define LOG4CXX 1
 #endif
 #include <apr_strings.h>
 #include <log4cxx/private/syslogappender_priv.h>
+#include <log4cxx/private/formatbuffer.h>
 
 #define LOG_UNDEF -1
 
@@ -59,6 +61,8 @@ SyslogAppender::SyslogAppender(const LayoutPtr& layout1,
 {
 	this->initSyslogFacilityStr();
 	setSyslogHost(syslogHost1);
+	Pool p;
+	activateOptions(p);
 }
 
 SyslogAppender::~SyslogAppender()
@@ -70,9 +74,19 @@ SyslogAppender::~SyslogAppender()
 void SyslogAppender::close()
 {
 	_priv->closed = true;
+	_priv->removeBatchTask();
 
 	if (_priv->sw)
 	{
+		try
+		{
+			_priv->sw->close();
+		}
+		catch (std::exception& e)
+		{
+			_priv->errorHandler->error(LOG4CXX_STR("Unable to send held syslog messages"), e, 0);
+		}
+		_priv->reportDiscarded();
 		_priv->sw = nullptr;
 	}
 }
@@ -278,11 +292,18 @@ void SyslogAppender::append(const spi::LoggingEventPtr& event, Pool& p)
 		return;
 	}
 
-	LogString msg;
-	std::string encoded;
+	// The options may have been set without calling activateOptions()
+	if (!_priv->sw && _priv->requiresWriter())
+	{
+		_priv->createWriter();
+	}
+
+	FormatBuffer buffer;
+	auto& msg = buffer.str();
 	_priv->layout->format(msg, event, p);
 
-	Transcoder::encode(msg, encoded);
+	// A stream transport has no message size limit
+	bool isStream = _priv->sw && SyslogWriter::TCP == _priv->protocol;
 
 	// Split up the message if it is over maxMessageLength in size.
 	// According to RFC 3164, the max message length is 1024, however
@@ -291,7 +312,7 @@ void SyslogAppender::append(const spi::LoggingEventPtr& event, Pool& p)
 	// to indicate how far through the message we are
 	std::vector<LogString> packets;
 
-	if ( msg.size() > _priv->maxMessageLength )
+	if ( !isStream && msg.size() > _priv->maxMessageLength )
 	{
 		LogString::iterator start = msg.begin();
 
@@ -320,10 +341,6 @@ void SyslogAppender::append(const spi::LoggingEventPtr& event, Pool& p)
 			++current;
 		}
 	}
-	else
-	{
-		packets.push_back( msg );
-	}
 
 	// On the local host, we can directly use the system function 'syslog'
 	// if it is available
@@ -331,6 +348,13 @@ void SyslogAppender::append(const spi::LoggingEventPtr& event, Pool& p)
 
 	if (_priv->sw == 0)
 	{
+		if (packets.empty())
+		{
+			// use of "%s" to avoid a security hole
+			LOG4CXX_ENCODE_CHAR(msgStr, msg);
+			::syslog(_priv->syslogFacility | event->getLevel()->getSyslogEquivalent(),
+				"%s", msgStr.c_str());
+		}
 		for (auto const& item : packets)
 		{
 			// use of "%s" to avoid a security hole
@@ -352,24 +376,39 @@ void SyslogAppender::append(const spi::LoggingEventPtr& event, Pool& p)
 		return;
 	}
 
-	for (auto const& item : packets)
+	FormatBuffer headerBuffer;
+	auto& sbuf = headerBuffer.str();
+	sbuf.append(1, 0x3C /* '<' */);
+	StringHelper::toString((_priv->syslogFacility | event->getLevel()->getSyslogEquivalent()), p, sbuf);
+	sbuf.append(1, (logchar) 0x3E /* '>' */);
+
+	if (_priv->facilityPrinting)
+	{
+		sbuf.append(_priv->facilityStr);
+	}
+
+	if (packets.empty())
+	{
+		sbuf.append(msg);
+		_priv->sw->write(sbuf);
+	}
+	else
 	{
-		LogString sbuf(1, 0x3C /* '<' */);
-		StringHelper::toString((_priv->syslogFacility | event->getLevel()->getSyslogEquivalent()), p, sbuf);
-		sbuf.append(1, (logchar) 0x3E /* '>' */);
+		auto headerSize = sbuf.size();
 
-		if (_priv->facilityPrinting)
+		for (auto const& item : packets)
 		{
-			sbuf.append(_priv->facilityStr);
+			sbuf.erase(headerSize);
+			sbuf.append(item);
+			_priv->sw->write(sbuf);
 		}
-
-		sbuf.append(item);
-		_priv->sw->write(sbuf);
 	}
+	_priv->reportDiscarded();
 }
 
 void SyslogAppender::activateOptions(Pool&)
 {
+	_priv->createWriter();
 }
 
 void SyslogAppender::setOption(const LogString& option, const LogString& value)
@@ -386,6 +425,26 @@ void SyslogAppender::setOption(const LogString& option, const LogString& value)
 	{
 		setMaxMessageLength(OptionConverter::toInt(value, 1024));
 	}
+	else if (StringHelper::equalsIgnoreCase(option, LOG4CXX_STR("PROTOCOL"), LOG4CXX_STR("protocol")))
+	{
+		setProtocol(value);
+	}
+	else if (StringHelper::equalsIgnoreCase(option, LOG4CXX_STR("BATCHSIZE"), LOG4CXX_STR("batchsize")))
+	{
+		setBatchSize(OptionConverter::toInt(value, 1));
+	}
+	else if (StringHelper::equalsIgnoreCase(option, LOG4CXX_STR("BATCHMILLISECONDS"), LOG4CXX_STR("batchmilliseconds")))
+	{
+		setBatchMilliseconds(OptionConverter::toInt(value, 1000));
+	}
+	else if (StringHelper::equalsIgnoreCase(option, LOG4CXX_STR("RECONNECTIONDELAY"), LOG4CXX_STR("reconnectiondelay")))
+	{
+		setReconnectionDelay(OptionConverter::toInt(value, 1000));
+	}
+	else if (StringHelper::equalsIgnoreCase(option, LOG4CXX_STR("MAXRECONNECTIONDELAY"), LOG4CXX_STR("maxreconnectiondelay")))
+	{
+		setMaxReconnectionDelay(OptionConverter::toInt(value, 30000));
+	}
 	else
 	{
 		AppenderSkeleton::setOption(option, value);
@@ -394,11 +453,6 @@ void SyslogAppender::setOption(const LogString& option, const LogString& value)
 
 void SyslogAppender::setSyslogHost(const LogString& syslogHost1)
 {
-	if (_priv->sw != 0)
-	{
-		_priv->sw = nullptr;
-	}
-
 	LogString slHost = syslogHost1;
 	int slHostPort = -1;
 
@@ -415,23 +469,101 @@ void SyslogAppender::setSyslogHost(const LogString& syslogHost1)
 	// On the local host, we can directly use the system function 'syslog'
 	// if it is available (cf. append)
 #if LOG4CXX_HAVE_SYSLOG
-
-	if (syslogHost1 != LOG4CXX_STR("localhost") && syslogHost1 != LOG4CXX_STR("127.0.0.1")
-		&& !syslogHost1.empty())
+	_priv->useSystemSyslog = syslogHost1 == LOG4CXX_STR("localhost")
+		|| syslogHost1 == LOG4CXX_STR("127.0.0.1")
+		|| syslogHost1.empty();
 #endif
+
+	_priv->syslogHost = slHost;
+	_priv->syslogHostPort = slHostPort;
+
+	// Replace a writer that sends to the previous host
+	if (_priv->sw)
+	{
+		_priv->createWriter();
+	}
+}
+
+void SyslogAppender::SyslogAppenderPriv::createWriter()
+{
+	removeBatchTask();
+
+	if (this->sw)
 	{
-		if (slHostPort >= 0)
+		try
 		{
-			_priv->sw = std::make_unique<SyslogWriter>(slHost, slHostPort);
+			this->sw->close();
 		}
-		else
+		catch (std::exception& e)
 		{
-			_priv->sw = std::make_unique<SyslogWriter>(slHost);
+			LogLog::warn(LOG4CXX_STR("Unable to send held syslog messages"), e);
 		}
+		reportDiscarded();
+		this->sw = nullptr;
 	}
 
-	_priv->syslogHost = slHost;
-	_priv->syslogHostPort = slHostPort;
+	if (!requiresWriter())
+	{
+		return;
+	}
+
+	int port = 0 <= this->syslogHostPort ? this->syslogHostPort : SYSLOG_PORT;
+
+	if (SyslogWriter::UDP == this->protocol && this->batchSize <= 1)
+	{
+		this->sw = std::make_shared<SyslogWriter>(this->syslogHost, port);
+		return;
+	}
+
+	this->sw = std::make_shared<SyslogWriter>(this->syslogHost, port, this->protocol, this->batchSize);
+	this->sw->setReconnectionDelay(this->reconnectionDelay, this->maxReconnectionDelay);
+
+	// A TCP connection is (re)opened by the periodic task, not the logging thread
+	bool isBatching = 1 < this->batchSize && 0 < this->batchMilliseconds;
+	if (isBatching || SyslogWriter::TCP == this->protocol)
+	{
+		std::weak_ptr<SyslogWriter> weakWriter(this->sw);
+		auto taskManager = ThreadUtility::instancePtr();
+		taskManager->value().addPeriodicTask(batchTaskName()
+			, [weakWriter]()
+			{
+				if (auto writer = weakWriter.lock())
+				{
+					try
+					{
+						writer->flush();
+					}
+					catch (std::exception& e)
+					{
+						LogLog::warn(LOG4CXX_STR("Unable to send held syslog messages"), e);
+					}
+				}
+			}
+			, std::chrono::milliseconds(isBatching ? this->batchMilliseconds : 1000)
+			);
+		this->batchTaskManager = taskManager;
+	}
+}
+
+void SyslogAppender::SyslogAppenderPriv::reportDiscarded()
+{
+	if (auto count = this->sw->takeDiscardedCount())
+	{
+		Pool p;
+		LogString msg;
+		StringHelper::toString(count, p, msg);
+		msg += LOG4CXX_STR(" syslog messages were discarded by the appender named \"");
+		msg += this->name;
+		msg += LOG4CXX_STR("\".");
+		this->errorHandler->error(msg);
+	}
+}
+
+void SyslogAppender::SyslogAppenderPriv::removeBatchTask()
+{
+	if (auto p = this->batchTaskManager.lock())
+		p->value().removePeriodicTask(batchTaskName());
+	this->batchTaskManager.reset();
 }
 
 
@@ -484,3 +616,65 @@ int SyslogAppender::getMaxMessageLength() const
 	return _priv->maxMessageLength;
 }
 
+void SyslogAppender::setProtocol(const LogString& newValue)
+{
+	if (StringHelper::equalsIgnoreCase(newValue, LOG4CXX_STR("TCP"), LOG4CXX_STR("tcp")))
+	{
+		_priv->protocol = SyslogWriter::TCP;
+	}
+	else if (StringHelper::equalsIgnoreCase(newValue, LOG4CXX_STR("UDP"), LOG4CXX_STR("udp")))
+	{
+		_priv->protocol = SyslogWriter::UDP;
+	}
+	else
+	{
+		LogLog::error(LOG4CXX_STR("[") + newValue +
+			LOG4CXX_STR("] is an unknown syslog protocol. Defaulting to [UDP]."));
+		_priv->protocol = SyslogWriter::UDP;
+	}
+}
+
+LogString SyslogAppender::getProtocol() const
+{
+	return SyslogWriter::TCP == _priv->protocol ? LOG4CXX_STR("TCP") : LOG4CXX_STR("UDP");
+}
+
+void SyslogAppender::setBatchSize(int newValue)
+{
+	_priv->batchSize = newValue;
+}
+
+int SyslogAppender::getBatchSize() const
+{
+	return _priv->batchSize;
+}
+
+void SyslogAppender::setBatchMilliseconds(int newValue)
+{
+	_priv->batchMilliseconds = newValue;
+}
+
+int SyslogAppender::getBatchMilliseconds() const
+{
+	return _priv->batchMilliseconds;
+}
+
+void SyslogAppender::setReconnectionDelay(int newValue)
+{
+	_priv->reconnectionDelay = newValue;
+}
+
+int SyslogAppender::getReconnectionDelay() const
+{
+	return _priv->reconnectionDelay;
+}
+
+void SyslogAppender::setMaxReconnectionDelay(int newValue)
+{
+	_priv->maxReconnectionDelay = newValue;
+}
+
+int SyslogAppender::getMaxReconnectionDelay() const
+{
+	return _priv->maxReconnectionDelay;
+}
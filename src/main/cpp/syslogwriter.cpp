@@ -21,21 +21,124 @@
 #include <log4cxx/helpers/inetaddress.h>
 #include <log4cxx/helpers/datagramsocket.h>
 #include <log4cxx/helpers/datagrampacket.h>
+#include <log4cxx/helpers/socket.h>
+#include <log4cxx/helpers/bytebuffer.h>
 #include <log4cxx/helpers/transcoder.h>
+#include <log4cxx/private/aprdatagramsocket.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
 
 using namespace LOG4CXX_NS;
 using namespace LOG4CXX_NS::helpers;
 
 struct SyslogWriter::SyslogWriterPrivate {
-	SyslogWriterPrivate(const LogString& syslogHost1, int syslogHostPort1)
-		: syslogHost(syslogHost1), syslogHostPort(syslogHostPort1){}
+	SyslogWriterPrivate(const LogString& syslogHost1, int syslogHostPort1, Protocol protocol1 = UDP, int batchSize1 = 1)
+		: syslogHost(syslogHost1), syslogHostPort(syslogHostPort1)
+		, protocol(protocol1), batchSize(0 < batchSize1 ? batchSize1 : 1){}
 
 	LogString syslogHost;
 	int syslogHostPort;
 	InetAddressPtr address;
 	DatagramSocketPtr ds;
+	Protocol protocol;
+	size_t batchSize;
+	std::mutex mutex;
+
+	/**
+	The connected socket that sends batches of UDP datagrams.
+	*/
+	std::unique_ptr<APRDatagramSocket> batchSocket;
+
+	/**
+	The datagrams waiting to be sent.
+	The strings are retained between batches so their storage is reused.
+	*/
+	std::vector<std::string> datagrams;
+	size_t datagramCount{ 0 };
+
+	/**
+	The TCP connection.
+	*/
+	SocketPtr stream;
+
+	/**
+	The octet counted messages waiting to be sent.
+	While there is no connection, messages are held here until it is reopened.
+	*/
+	std::string frames;
+	size_t frameCount{ 0 };
+
+	/**
+	The maximum size of \c frames. Further messages are discarded.
+	*/
+	static constexpr size_t maxHeldBytes = 1024 * 1024;
+
+	/**
+	The number of messages discarded since takeDiscardedCount() was last called.
+	*/
+	std::atomic<size_t> discardedCount{ 0 };
+
+	/**
+	A TCP connection is not (re)opened before this time.
+	*/
+	std::chrono::steady_clock::time_point nextConnectTime;
+
+	/**
+	Is a TCP connection being opened?
+	*/
+	bool connecting{ false };
+
+	/**
+	The delay after the first failed connection attempt.
+	*/
+	std::chrono::milliseconds initialReconnectionDelay{ 1000 };
+
+	/**
+	The delay doubles after each failed connection attempt up to this value.
+	*/
+	std::chrono::milliseconds maxReconnectionDelay{ 30000 };
+
+	/**
+	The delay after the next failed connection attempt.
+	*/
+	std::chrono::milliseconds reconnectionDelay{ 1000 };
+
+	/**
+	Serializes the sending of frames, which is done without holding \c mutex.
+	*/
+	std::mutex sendMutex;
+
+	/**
+	The frames being sent.
+	*/
+	std::string sending;
+
+	void connectIfDue(bool force);
+	void sendDatagrams();
+	void sendFrames(bool wait);
 };
 
+namespace
+{
+/**
+The position after the octet counted frame starting at \c start in \c frames.
+*/
+size_t frameEnd(const std::string& frames, size_t start)
+{
+	size_t length = 0;
+	auto pos = start;
+	while (pos < frames.size() && '0' <= frames[pos] && frames[pos] <= '9')
+	{
+		length = length * 10 + (frames[pos] - '0');
+		++pos;
+	}
+	return pos + 1 + length;
+}
+}
+
 SyslogWriter::SyslogWriter(const LogString& syslogHost1, int syslogHostPort1)
 	: m_priv(std::make_unique<SyslogWriterPrivate>(syslogHost1, syslogHostPort1))
 {
@@ -60,11 +163,104 @@ SyslogWriter::SyslogWriter(const LogString& syslogHost1, int syslogHostPort1)
 	}
 }
 
-SyslogWriter::~SyslogWriter(){}
+SyslogWriter::SyslogWriter(const LogString& syslogHost1, int syslogHostPort1, Protocol protocol1, int batchSize1)
+	: m_priv(std::make_unique<SyslogWriterPrivate>(syslogHost1, syslogHostPort1, protocol1, batchSize1))
+{
+	try
+	{
+		m_priv->address = InetAddress::getByName(syslogHost1);
+	}
+	catch (UnknownHostException& e)
+	{
+		LogLog::error(((LogString) LOG4CXX_STR("Could not find ")) + syslogHost1 +
+			LOG4CXX_STR(". All logging will FAIL."), e);
+		return;
+	}
+
+	// A TCP connection is opened by flush()
+	if (UDP == m_priv->protocol && 1 < m_priv->batchSize)
+	{
+		try
+		{
+			auto socket = std::make_unique<APRDatagramSocket>();
+			socket->connect(m_priv->address, m_priv->syslogHostPort);
+			m_priv->batchSocket = std::move(socket);
+		}
+		catch (SocketException& e)
+		{
+			LogLog::error(((LogString) LOG4CXX_STR("Could not instantiate DatagramSocket to ")) + syslogHost1 +
+				LOG4CXX_STR(". All logging will FAIL."), e);
+		}
+	}
+	else if (UDP == m_priv->protocol)
+	{
+		try
+		{
+			m_priv->ds = DatagramSocket::create();
+		}
+		catch (SocketException& e)
+		{
+			LogLog::error(((LogString) LOG4CXX_STR("Could not instantiate DatagramSocket to ")) + syslogHost1 +
+				LOG4CXX_STR(". All logging will FAIL."), e);
+		}
+	}
+}
+
+SyslogWriter::~SyslogWriter()
+{
+	try
+	{
+		flush();
+	}
+	catch (std::exception& e)
+	{
+		LogLog::warn(LOG4CXX_STR("Unable to send pending syslog messages"), e);
+	}
+}
 
 void SyslogWriter::write(const LogString& source)
 {
-	if (m_priv->ds != 0 && m_priv->address != 0)
+	if (TCP == m_priv->protocol)
+	{
+		LOG4CXX_ENCODE_CHAR(data, source);
+		// RFC 6587 octet counting: MSG-LEN SP SYSLOG-MSG
+		auto length = std::to_string(data.size());
+		bool isBatchComplete;
+		{
+			std::lock_guard<std::mutex> lock(m_priv->mutex);
+			if (SyslogWriterPrivate::maxHeldBytes < m_priv->frames.size() + length.size() + 1 + data.size())
+			{
+				++m_priv->discardedCount;
+				return;
+			}
+			m_priv->frames += length;
+			m_priv->frames += ' ';
+			m_priv->frames += data;
+			++m_priv->frameCount;
+			isBatchComplete = m_priv->stream && m_priv->batchSize <= m_priv->frameCount;
+		}
+		if (isBatchComplete)
+		{
+			// Do not wait for a send in progress on another thread
+			m_priv->sendFrames(false);
+		}
+	}
+	else if (m_priv->batchSocket)
+	{
+		std::lock_guard<std::mutex> lock(m_priv->mutex);
+		if (m_priv->datagrams.size() <= m_priv->datagramCount)
+		{
+			m_priv->datagrams.resize(m_priv->datagramCount + 1);
+		}
+		auto& data = m_priv->datagrams[m_priv->datagramCount];
+		data.clear();
+		Transcoder::encode(source, data);
+		if (m_priv->batchSize <= ++m_priv->datagramCount)
+		{
+			m_priv->sendDatagrams();
+		}
+	}
+	else if (m_priv->ds != 0 && m_priv->address != 0)
 	{
 		LOG4CXX_ENCODE_CHAR(data, source);
 
@@ -75,3 +271,138 @@ void SyslogWriter::write(const LogString& source)
 		m_priv->ds->send(packet);
 	}
 }
+
+void SyslogWriter::flush()
+{
+	if (TCP == m_priv->protocol)
+	{
+		m_priv->connectIfDue(false);
+		m_priv->sendFrames(true);
+	}
+	std::lock_guard<std::mutex> lock(m_priv->mutex);
+	if (0 < m_priv->datagramCount)
+	{
+		m_priv->sendDatagrams();
+	}
+}
+
+void SyslogWriter::close()
+{
+	if (TCP == m_priv->protocol)
+	{
+		// Make a final attempt regardless of the reconnection delay
+		m_priv->connectIfDue(true);
+	}
+	flush();
+	std::lock_guard<std::mutex> lock(m_priv->mutex);
+	m_priv->discardedCount += m_priv->frameCount;
+	m_priv->frames.clear();
+	m_priv->frameCount = 0;
+}
+
+size_t SyslogWriter::takeDiscardedCount()
+{
+	return m_priv->discardedCount.exchange(0);
+}
+
+void SyslogWriter::setReconnectionDelay(int initialMilliseconds, int maximumMilliseconds)
+{
+	std::lock_guard<std::mutex> lock(m_priv->mutex);
+	m_priv->initialReconnectionDelay = std::chrono::milliseconds(std::max(initialMilliseconds, 0));
+	m_priv->maxReconnectionDelay = std::max(m_priv->initialReconnectionDelay, std::chrono::milliseconds(maximumMilliseconds));
+	m_priv->reconnectionDelay = m_priv->initialReconnectionDelay;
+}
+
+void SyslogWriter::SyslogWriterPrivate::connectIfDue(bool force)
+{
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+		if (this->stream || !this->address || this->connecting
+			|| (!force && std::chrono::steady_clock::now() < this->nextConnectTime))
+		{
+			return;
+		}
+		// Prevent concurrent attempts
+		this->connecting = true;
+	}
+	try
+	{
+		auto newStream = Socket::create(this->address, this->syslogHostPort);
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->stream = std::move(newStream);
+		this->reconnectionDelay = this->initialReconnectionDelay;
+		this->connecting = false;
+	}
+	catch (SocketException& e)
+	{
+		{
+			std::lock_guard<std::mutex> lock(this->mutex);
+			this->nextConnectTime = std::chrono::steady_clock::now() + this->reconnectionDelay;
+			this->reconnectionDelay = std::min(2 * this->reconnectionDelay, this->maxReconnectionDelay);
+			this->connecting = false;
+		}
+		LogLog::error(((LogString) LOG4CXX_STR("Could not connect to ")) + this->syslogHost +
+			LOG4CXX_STR(". Messages will be held until the connection is reopened."), e);
+	}
+}
+
+void SyslogWriter::SyslogWriterPrivate::sendDatagrams()
+{
+	auto count = this->datagramCount;
+	this->datagramCount = 0;
+	this->batchSocket->send(this->datagrams.data(), count);
+}
+
+void SyslogWriter::SyslogWriterPrivate::sendFrames(bool wait)
+{
+	std::unique_lock<std::mutex> sendLock(this->sendMutex, std::defer_lock);
+	if (wait)
+		sendLock.lock();
+	else if (!sendLock.try_lock())
+		return;
+	SocketPtr currentStream;
+	{
+		std::lock_guard<std::mutex> lock(this->mutex);
+		if (!this->stream || 0 == this->frameCount)
+		{
+			return;
+		}
+		currentStream = this->stream;
+		this->sending.swap(this->frames);
+		this->frameCount = 0;
+	}
+	ByteBuffer buf(&this->sending[0], this->sending.size());
+	try
+	{
+		currentStream->write(buf);
+		this->sending.clear();
+	}
+	catch (SocketException& e)
+	{
+		// Drop the frames that were completely written
+		size_t unsentStart = 0;
+		for (auto end = frameEnd(this->sending, 0); end <= buf.position(); end = frameEnd(this->sending, end))
+		{
+			unsentStart = end;
+		}
+		this->sending.erase(0, unsentStart);
+		size_t unsentCount = 0;
+		for (size_t pos = 0; pos < this->sending.size(); pos = frameEnd(this->sending, pos))
+		{
+			++unsentCount;
+		}
+		LogLog::error(((LogString) LOG4CXX_STR("Could not send to ")) + this->syslogHost, e);
+
+		// Keep the remaining messages so they are sent when the connection is reopened
+		std::lock_guard<std::mutex> lock(this->mutex);
+		this->sending += this->frames;
+		this->frames.swap(this->sending);
+		this->sending.clear();
+		this->frameCount += unsentCount;
+		if (this->stream == currentStream)
+		{
+			this->stream.reset();
+			this->nextConnectTime = std::chrono::steady_clock::now() + this->reconnectionDelay;
+		}
+	}
+}
@@ -24,6 +24,10 @@
 #include <log4cxx/helpers/bytebuffer.h>
 #include <log4cxx/helpers/threadutility.h>
 #include <log4cxx/private/appenderskeleton_priv.h>
+#include <log4cxx/private/formatbuffer.h>
+#include <log4cxx/private/bufferedsocket.h>
+#include <log4cxx/private/aprsocket.h>
+#include <apr_network_io.h>
 #include <mutex>
 #include <thread>
 #include <vector>
@@ -36,9 +40,31 @@ using namespace LOG4CXX_NS;
 using namespace LOG4CXX_NS::helpers;
 using namespace LOG4CXX_NS::net;
 
-typedef helpers::SocketPtr Connection;
+namespace
+{
+/**
+A connected client.
+*/
+struct Connection
+{
+	/**
+	Sends the client output on a dedicated thread.
+	*/
+	BufferedSocketPtr sender;
+
+	/**
+	The number of discarded bytes the client has been told about.
+	*/
+	size_t reportedDiscardCount{ 0 };
+};
 LOG4CXX_LIST_DEF(ConnectionList, Connection);
 
+/**
+The microseconds a client may accept no output before it is disconnected.
+*/
+const apr_interval_time_t SEND_TIMEOUT = 10 * APR_USEC_PER_SEC;
+} // namespace
+
 IMPLEMENT_LOG4CXX_OBJECT(TelnetAppender)
 
 struct TelnetAppender::TelnetAppenderPriv : public AppenderSkeletonPrivate
@@ -65,6 +91,11 @@ struct TelnetAppender::TelnetAppenderPriv : public AppenderSkeletonPrivate
 	std::thread sh;
 	size_t activeConnections;
 
+	/**
+	The maximum number of bytes held for each client.
+	*/
+	int bufferSize{ 64 * 1024 };
+
 #if LOG4CXX_EVENTS_AT_EXIT
 	helpers::AtExitRegistry::Raii atExitRegistryRaii;
 #endif
@@ -135,6 +166,10 @@ void TelnetAppender::setOption(const LogString& option,
 	{
 		setEncoding(value);
 	}
+	else if (StringHelper::equalsIgnoreCase(option, LOG4CXX_STR("BUFFERSIZE"), LOG4CXX_STR("buffersize")))
+	{
+		setBufferSize(OptionConverter::toFileSize(value, 64 * 1024));
+	}
 	else
 	{
 		AppenderSkeleton::setOption(option, value);
@@ -158,17 +193,19 @@ void TelnetAppender::setEncoding(const LogString& value)
 void TelnetAppender::close()
 {
 	_priv->stopAcceptingConnections();
-	std::lock_guard<std::recursive_mutex> lock(_priv->mutex);
-	SocketPtr nullSocket;
-	for (auto& item : _priv->connections)
+	ConnectionList closing;
 	{
-		if (item)
-		{
-			item->close();
-			item = nullSocket;
-		}
+		std::lock_guard<std::recursive_mutex> lock(_priv->mutex);
+		closing.resize(_priv->connections.size());
+		closing.swap(_priv->connections);
+		_priv->activeConnections = 0;
+	}
+	// Wait for each client's pending output without blocking logging threads
+	for (auto& item : closing)
+	{
+		if (item.sender)
+			item.sender->close();
 	}
-	_priv->activeConnections = 0;
 }
 
 
@@ -176,23 +213,43 @@ void TelnetAppender::write(ByteBuffer& buf)
 {
 	for (auto& item :_priv->connections)
 	{
-		if (item)
+		if (!item.sender)
+			;
+		else if (item.sender->isConnected())
 		{
-			try
-			{
-				ByteBuffer b(buf.current(), buf.remaining());
-				item->write(b);
-			}
-			catch (Exception&)
-			{
-				// The client has closed the connection, remove it from our list:
-				item.reset();
-				_priv->activeConnections--;
-			}
+			ByteBuffer b(buf.current(), buf.remaining());
+			item.sender->write(b);
+		}
+		else
+		{
+			// The client has closed the connection, remove it from our list:
+			item.sender->close();
+			item.sender.reset();
+			_priv->activeConnections--;
 		}
 	}
 }
 
+void TelnetAppender::reportDiscards(Pool& p)
+{
+	for (auto& item :_priv->connections)
+	{
+		if (!item.sender)
+			continue;
+		auto discardCount = item.sender->getDiscardedByteCount();
+		if (discardCount == item.reportedDiscardCount)
+			continue;
+		LogString msg;
+		StringHelper::toString(discardCount - item.reportedDiscardCount, p, msg);
+		msg += LOG4CXX_STR(" bytes of logging output were discarded.\r\n");
+		// Wait until the client has caught up
+		if (static_cast<size_t>(_priv->bufferSize) < item.sender->getQueuedByteCount() + msg.size())
+			continue;
+		writeStatus(item.sender, msg, p);
+		item.reportedDiscardCount = discardCount;
+	}
+}
+
 void TelnetAppender::writeStatus(const SocketPtr& socket, const LogString& msg, Pool& p)
 {
 	size_t bytesSize = msg.size() * 2;
@@ -216,7 +273,8 @@ void TelnetAppender::append(const spi::LoggingEventPtr& event, Pool& p)
 
 	if (count > 0)
 	{
-		LogString msg;
+		FormatBuffer buffer;
+		auto& msg = buffer.str();
 		if (_priv->layout)
 			_priv->layout->format(msg, event, p);
 		else
@@ -230,6 +288,8 @@ void TelnetAppender::append(const spi::LoggingEventPtr& event, Pool& p)
 
 		std::lock_guard<std::recursive_mutex> lock(_priv->mutex);
 
+		reportDiscards(p);
+
 		while (msgIter != msg.end())
 		{
 			log4cxx_status_t stat = _priv->encoder->encode(msg, msgIter, buf);
@@ -284,13 +344,20 @@ void TelnetAppender::acceptConnections()
 				//
 				//   find unoccupied connection
 				//
+				if (auto aprSocket = std::dynamic_pointer_cast<APRSocket>(newClient))
+					apr_socket_timeout_set(aprSocket->getSocketPtr(), SEND_TIMEOUT);
+
 				std::lock_guard<std::recursive_mutex> lock(_priv->mutex);
+				auto sender = std::make_shared<BufferedSocket>(newClient->getInetAddress(), newClient->getPort()
+					, _priv->bufferSize, std::function<void()>());
+				sender->setConnection(newClient);
 
 				for (auto& item : _priv->connections)
 				{
-					if (!item)
+					if (!item.sender)
 					{
-						item = newClient;
+						item.sender = sender;
+						item.reportedDiscardCount = 0;
 						_priv->activeConnections++;
 
 						break;
@@ -301,7 +368,7 @@ void TelnetAppender::acceptConnections()
 				LogString oss(LOG4CXX_STR("TelnetAppender v1.0 ("));
 				StringHelper::toString((int) count + 1, p, oss);
 				oss += LOG4CXX_STR(" active connections)\r\n\r\n");
-				writeStatus(newClient, oss, p);
+				writeStatus(sender, oss, p);
 			}
 		}
 		catch (InterruptedIOException&)
@@ -343,19 +410,37 @@ int TelnetAppender::getMaxConnections() const
 
 void TelnetAppender::setMaxConnections(int newValue)
 {
-	std::lock_guard<std::recursive_mutex> lock(_priv->mutex);
-	if (_priv->connections.size() < newValue)
-		_priv->connections.resize(newValue);
-	else while (newValue < _priv->connections.size())
+	ConnectionList closing;
 	{
-		auto item = _priv->connections.back();
-		_priv->connections.pop_back();
-		if (item)
+		std::lock_guard<std::recursive_mutex> lock(_priv->mutex);
+		auto newSize = static_cast<size_t>(newValue);
+		if (_priv->connections.size() < newSize)
+			_priv->connections.resize(newSize);
+		else while (newSize < _priv->connections.size())
 		{
-			item->close();
-			--_priv->activeConnections;
+			auto& item = _priv->connections.back();
+			if (item.sender)
+			{
+				closing.push_back(item);
+				--_priv->activeConnections;
+			}
+			_priv->connections.pop_back();
 		}
 	}
+	// Wait for each removed client's pending output without blocking logging threads
+	for (auto& item : closing)
+		item.sender->close();
+}
+
+int TelnetAppender::getBufferSize() const
+{
+	return _priv->bufferSize;
+}
+
+void TelnetAppender::setBufferSize(int newValue)
+{
+	std::lock_guard<std::recursive_mutex> lock(_priv->mutex);
+	_priv->bufferSize = newValue;
 }
 
 bool TelnetAppender::requiresLayout() const
@@ -45,6 +45,11 @@ struct ThreadSpecificData::ThreadSpecificDataPrivate{
 	NDC::Stack ndcStack;
 	MDC::Map mdcMap;
 
+	/**
+	 *  A copy of mdcMap that is discarded when mdcMap may have changed.
+	 */
+	MapPtr mdcCopy;
+
 	std::shared_ptr<NamePair> pNamePair;
 
 #if !LOG4CXX_LOGCHAR_IS_UNICHAR && !LOG4CXX_LOGCHAR_IS_WCHAR
@@ -151,10 +156,23 @@ NDC::Stack& ThreadSpecificData::getStack()
 }
 
 MDC::Map& ThreadSpecificData::getMap()
+{
+	m_priv->mdcCopy.reset(); // The caller may change the map
+	return m_priv->mdcMap;
+}
+
+const MDC::Map& ThreadSpecificData::getMap() const
 {
 	return m_priv->mdcMap;
 }
 
+auto ThreadSpecificData::getMapCopy() -> MapPtr
+{
+	if (!m_priv->mdcCopy)
+		m_priv->mdcCopy = std::make_shared<const MDC::Map>(m_priv->mdcMap);
+	return m_priv->mdcCopy;
+}
+
 auto ThreadSpecificData::getNames() -> NamePairPtr
 {
 	auto p = getCurrentData();
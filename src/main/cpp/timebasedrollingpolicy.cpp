@@ -113,6 +113,7 @@ struct TimeBasedRollingPolicy::TimeBasedRollingPolicyPrivate{
 
 		bool multiprocess = false;
 		bool throwIOExceptionOnForkFailure = true;
+		int compressionLevel = -1;
 };
 
 
@@ -455,6 +456,7 @@ RolloverDescriptionPtr TimeBasedRollingPolicy::rollover(
 		GZCompressActionPtr comp = std::make_shared<GZCompressAction>(
 					File().setPath(lastBaseName), File().setPath(m_priv->lastFileName), true);
 		comp->setThrowIOExceptionOnForkFailure(m_priv->throwIOExceptionOnForkFailure);
+		comp->setCompressionLevel(m_priv->compressionLevel);
 		compressAction = comp;
 	}
 
@@ -463,6 +465,7 @@ RolloverDescriptionPtr TimeBasedRollingPolicy::rollover(
 		ZipCompressActionPtr comp = std::make_shared<ZipCompressAction>(
 					File().setPath(lastBaseName), File().setPath(m_priv->lastFileName), true);
 		comp->setThrowIOExceptionOnForkFailure(m_priv->throwIOExceptionOnForkFailure);
+		comp->setCompressionLevel(m_priv->compressionLevel);
 		compressAction = comp;
 	}
 
@@ -541,6 +544,20 @@ void TimeBasedRollingPolicy::setOption(const LogString& option,
 	{
 		m_priv->throwIOExceptionOnForkFailure = OptionConverter::toBoolean(value, true);
 	}
+	else if (StringHelper::equalsIgnoreCase(option,
+			LOG4CXX_STR("COMPRESSIONLEVEL"),
+			LOG4CXX_STR("compressionlevel")))
+	{
+		int level = OptionConverter::toInt(value, -2);
+		if (level < -1 || 9 < level)
+		{
+			LogLog::warn(LOG4CXX_STR("Invalid CompressionLevel [") + value + LOG4CXX_STR("]"));
+		}
+		else
+		{
+			m_priv->compressionLevel = level;
+		}
+	}
 	else
 	{
 		RollingPolicyBase::setOption(option, value);
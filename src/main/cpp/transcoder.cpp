@@ -31,6 +31,7 @@
 	#define LOG4CXX 1
 #endif
 #include <log4cxx/private/log4cxx_private.h>
+#include <log4cxx/private/singlebyterun.h>
 
 #if LOG4CXX_CFSTRING_API
 	#include <CoreFoundation/CFString.h>
@@ -46,6 +47,13 @@ void Transcoder::decodeUTF8(const std::string& src, LogString& dst)
 
 	while (iter != src.end())
 	{
+		SingleByteRun::append(src, iter, dst);
+
+		if (iter == src.end())
+		{
+			break;
+		}
+
 		unsigned int sv = decode(src, iter);
 
 		if (sv != 0xFFFF)
@@ -69,6 +77,13 @@ void Transcoder::encodeUTF8(const LogString& src, std::string& dst)
 
 	while (iter != src.end())
 	{
+		SingleByteRun::append(src, iter, dst);
+
+		if (iter == src.end())
+		{
+			break;
+		}
+
 		unsigned int sv = decode(src, iter);
 
 		if (sv != 0xFFFF)
@@ -320,14 +335,7 @@ void Transcoder::decode(const std::string& src, LogString& dst)
 	dst.reserve(dst.size() + src.size());
 	std::string::const_iterator iter = src.begin();
 #if !LOG4CXX_CHARSET_EBCDIC
-
-	for (;
-		iter != src.end() && ((unsigned char) *iter) < 0x80;
-		iter++)
-	{
-		dst.append(1, *iter);
-	}
-
+	SingleByteRun::append(src, iter, dst);
 #endif
 
 	if (iter != src.end())
@@ -374,14 +382,7 @@ void Transcoder::encode(const LogString& src, std::string& dst)
 	dst.reserve(dst.size() + src.size());
 	LogString::const_iterator iter = src.begin();
 #if !LOG4CXX_CHARSET_EBCDIC
-
-	for (;
-		iter != src.end() && ((unsigned int) *iter) < 0x80;
-		iter++)
-	{
-		dst.append(1, *iter);
-	}
-
+	SingleByteRun::append(src, iter, dst);
 #endif
 
 	if (iter != src.end())
@@ -488,6 +489,13 @@ void Transcoder::decode(const std::wstring& src, LogString& dst)
 
 	while (i != src.end())
 	{
+		SingleByteRun::append(src, i, dst);
+
+		if (i == src.end())
+		{
+			break;
+		}
+
 		unsigned int cp = decode(src, i);
 
 		if (cp != 0xFFFF)
@@ -512,6 +520,13 @@ void Transcoder::encode(const LogString& src, std::wstring& dst)
 
 	for (LogString::const_iterator i = src.begin(); i != src.end();)
 	{
+		SingleByteRun::append(src, i, dst);
+
+		if (i == src.end())
+		{
+			break;
+		}
+
 		unsigned int cp = Transcoder::decode(src, i);
 
 		if (cp != 0xFFFF)
@@ -18,6 +18,7 @@
 #include <log4cxx/logstring.h>
 #include <log4cxx/helpers/transform.h>
 #include <log4cxx/helpers/widelife.h>
+#include <log4cxx/private/characterscanner.h>
 
 using namespace LOG4CXX_NS;
 using namespace LOG4CXX_NS::helpers;
@@ -35,9 +36,9 @@ void Transform::appendEscapingTags(
 		return;
 	}
 
-	logchar specials[] = { 0x22 /* " */, 0x26 /* & */, 0x3C /* < */, 0x3E /* > */, 0x00 };
+	static const CharacterScanner specials{ 0x22 /* " */, 0x26 /* & */, 0x3C /* < */, 0x3E /* > */ };
 	size_t start = 0;
-	size_t special = input.find_first_of(specials, start);
+	size_t special = specials.find(input, start);
 
 	while (special != LogString::npos)
 	{
@@ -70,15 +71,7 @@ void Transform::appendEscapingTags(
 		}
 
 		start = special + 1;
-
-		if (special < input.size())
-		{
-			special = input.find_first_of(specials, start);
-		}
-		else
-		{
-			special = LogString::npos;
-		}
+		special = specials.find(input, start);
 	}
 
 	if (start < input.size())
@@ -90,8 +83,8 @@ void Transform::appendEscapingTags(
 void Transform::appendEscapingCDATA(
 	LogString& buf, const LogString& input)
 {
-	static const WideLife<LogString> CDATA_END(LOG4CXX_STR("]]>"));
 	static const WideLife<LogString> CDATA_EMBEDED_END(LOG4CXX_STR("]]>]]&gt;<![CDATA["));
+	static const CharacterScanner bracket{ 0x5D /* ] */ };
 
 	const LogString::size_type CDATA_END_LEN = 3;
 
@@ -101,29 +94,22 @@ void Transform::appendEscapingCDATA(
 		return;
 	}
 
-	LogString::size_type end = input.find(CDATA_END);
-
-	if (end == LogString::npos)
-	{
-		buf.append(input);
-		return;
-	}
-
 	LogString::size_type start = 0;
 
+	LogString::size_type end = bracket.find(input, start);
+
 	while (end != LogString::npos)
 	{
-		buf.append(input, start, end - start);
-		buf.append(CDATA_EMBEDED_END);
-		start = end + CDATA_END_LEN;
-
-		if (start < input.length())
+		if (input.compare(end, CDATA_END_LEN, LOG4CXX_STR("]]>")) == 0)
 		{
-			end = input.find(CDATA_END, start);
+			buf.append(input, start, end - start);
+			buf.append(CDATA_EMBEDED_END);
+			start = end + CDATA_END_LEN;
+			end = bracket.find(input, start);
 		}
 		else
 		{
-			return;
+			end = bracket.find(input, end + 1);
 		}
 	}
 
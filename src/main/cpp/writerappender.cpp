@@ -21,6 +21,7 @@
 #include <log4cxx/helpers/stringhelper.h>
 #include <log4cxx/private/appenderskeleton_priv.h>
 #include <log4cxx/private/writerappender_priv.h>
+#include <log4cxx/private/formatbuffer.h>
 #include <mutex>
 
 using namespace LOG4CXX_NS;
@@ -228,7 +229,8 @@ void WriterAppender::setEncoding(const LogString& enc)
 
 void WriterAppender::subAppend(const spi::LoggingEventPtr& event, Pool& p)
 {
-	LogString msg;
+	FormatBuffer buffer;
+	auto& msg = buffer.str();
 	_priv->layout->format(msg, event, p);
 
 	if (_priv->writer != NULL)
@@ -28,6 +28,7 @@
 #include <log4cxx/helpers/socketoutputstream.h>
 #include <log4cxx/private/appenderskeleton_priv.h>
 #include <log4cxx/private/socketappenderskeleton_priv.h>
+#include <log4cxx/private/formatbuffer.h>
 
 using namespace LOG4CXX_NS;
 using namespace LOG4CXX_NS::helpers;
@@ -125,7 +126,8 @@ void XMLSocketAppender::append(const spi::LoggingEventPtr& event, LOG4CXX_NS::he
 {
 	if (_priv->writer)
 	{
-		LogString output;
+		FormatBuffer buffer;
+		auto& output = buffer.str();
 		_priv->layout->format(output, event, p);
 
 		try
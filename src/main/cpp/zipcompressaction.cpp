@@ -22,6 +22,10 @@
 #include <log4cxx/helpers/transcoder.h>
 #include <log4cxx/private/action_priv.h>
 #include <log4cxx/helpers/loglog.h>
+#if LOG4CXX_HAS_ZLIB
+#include <log4cxx/private/deflatefile.h>
+#include <apr_time.h>
+#endif
 
 using namespace LOG4CXX_NS;
 using namespace LOG4CXX_NS::rolling;
@@ -37,11 +41,41 @@ struct ZipCompressAction::ZipCompressActionPrivate : public ActionPrivate
 		source(toRename), destination(renameTo), deleteSource(deleteSource) {}
 
 	const File source;
-	const File destination;
+	File destination;
 	bool deleteSource;
 	bool throwIOExceptionOnForkFailure = true;
+	int compressionLevel = -1;
 };
 
+#if LOG4CXX_HAS_ZLIB
+namespace
+{
+
+void putUInt16(std::string& buf, uint32_t value)
+{
+	buf += char(value & 0xFF);
+	buf += char((value >> 8) & 0xFF);
+}
+
+void putUInt32(std::string& buf, uint32_t value)
+{
+	putUInt16(buf, value & 0xFFFF);
+	putUInt16(buf, value >> 16);
+}
+
+void writeAll(apr_file_t* file, const std::string& buf)
+{
+	apr_status_t stat = apr_file_write_full(file, buf.data(), buf.size(), NULL);
+
+	if (stat != APR_SUCCESS)
+	{
+		throw IOException(stat);
+	}
+}
+
+} // namespace
+#endif
+
 IMPLEMENT_LOG4CXX_OBJECT(ZipCompressAction)
 
 ZipCompressAction::ZipCompressAction(const File& src,
@@ -59,6 +93,128 @@ bool ZipCompressAction::execute(LOG4CXX_NS::helpers::Pool& p) const
 		return false;
 	}
 
+#if LOG4CXX_HAS_ZLIB
+	apr_file_t* in;
+	apr_status_t stat = priv->source.open(&in, APR_FOPEN_READ, APR_OS_DEFAULT, p);
+
+	if (stat != APR_SUCCESS)
+	{
+		throw IOException(priv->source.getName(), stat);
+	}
+
+	apr_file_t* out;
+	apr_int32_t flags = APR_FOPEN_WRITE | APR_FOPEN_CREATE | APR_FOPEN_TRUNCATE;
+	stat = priv->destination.open(&out, flags, APR_OS_DEFAULT, p);
+
+	if (stat != APR_SUCCESS)
+	{
+		throw IOException(priv->destination.getName(), stat);
+	}
+
+	priv->destination.setAutoDelete(true);
+
+	// The entry name is the source path without any leading separators (as zip would store it)
+	std::string entryName = Transcoder::encode(priv->source.getPath(), p);
+	for (auto& c : entryName)
+	{
+		if ('\\' == c)
+			c = '/';
+	}
+	entryName.erase(0, entryName.find_first_not_of('/'));
+
+	apr_time_exp_t modified;
+	apr_time_exp_lt(&modified, priv->source.lastModified(p));
+	// MS-DOS dates can only represent the years 1980 to 2107
+	if (modified.tm_year < 80)
+	{
+		modified.tm_year = 80;
+		modified.tm_mon = 0;
+		modified.tm_mday = 1;
+		modified.tm_hour = modified.tm_min = modified.tm_sec = 0;
+	}
+	else if (207 < modified.tm_year)
+	{
+		modified.tm_year = 207;
+		modified.tm_mon = 11;
+		modified.tm_mday = 31;
+		modified.tm_hour = 23;
+		modified.tm_min = modified.tm_sec = 59;
+	}
+	uint32_t dosTime = (modified.tm_hour << 11) | (modified.tm_min << 5) | (modified.tm_sec / 2);
+	uint32_t dosDate = ((modified.tm_year - 80) << 9) | ((modified.tm_mon + 1) << 5) | modified.tm_mday;
+	const uint32_t version = 20; // 2.0, deflate compression
+	const uint32_t flagBits = 0x0008; // CRC and sizes follow the compressed data
+	const uint32_t deflateMethod = 8;
+
+	std::string header;
+	putUInt32(header, 0x04034b50); // local file header signature
+	putUInt16(header, version);
+	putUInt16(header, flagBits);
+	putUInt16(header, deflateMethod);
+	putUInt16(header, dosTime);
+	putUInt16(header, dosDate);
+	putUInt32(header, 0); // CRC-32
+	putUInt32(header, 0); // compressed size
+	putUInt32(header, 0); // uncompressed size
+	putUInt16(header, (uint32_t)entryName.size());
+	putUInt16(header, 0); // extra field length
+	header += entryName;
+	writeAll(out, header);
+
+	auto summary = deflateFile(in, out, priv->compressionLevel);
+	if (0xFFFFFFFF <= summary.inputSize || 0xFFFFFFFF <= summary.outputSize)
+	{
+		throw IOException(LOG4CXX_STR("zip64 format is not supported"));
+	}
+
+	std::string trailer;
+	putUInt32(trailer, 0x08074b50); // data descriptor signature
+	putUInt32(trailer, summary.crc);
+	putUInt32(trailer, (uint32_t)summary.outputSize);
+	putUInt32(trailer, (uint32_t)summary.inputSize);
+
+	uint32_t directoryOffset = (uint32_t)(header.size() + summary.outputSize + trailer.size());
+	size_t directoryStart = trailer.size();
+	putUInt32(trailer, 0x02014b50); // central directory file header signature
+	putUInt16(trailer, version);
+	putUInt16(trailer, version);
+	putUInt16(trailer, flagBits);
+	putUInt16(trailer, deflateMethod);
+	putUInt16(trailer, dosTime);
+	putUInt16(trailer, dosDate);
+	putUInt32(trailer, summary.crc);
+	putUInt32(trailer, (uint32_t)summary.outputSize);
+	putUInt32(trailer, (uint32_t)summary.inputSize);
+	putUInt16(trailer, (uint32_t)entryName.size());
+	putUInt16(trailer, 0); // extra field length
+	putUInt16(trailer, 0); // comment length
+	putUInt16(trailer, 0); // disk number
+	putUInt16(trailer, 0); // internal attributes
+	putUInt32(trailer, 0); // external attributes
+	putUInt32(trailer, 0); // local file header offset
+	trailer += entryName;
+	uint32_t directorySize = (uint32_t)(trailer.size() - directoryStart);
+
+	putUInt32(trailer, 0x06054b50); // end of central directory signature
+	putUInt16(trailer, 0); // disk number
+	putUInt16(trailer, 0); // central directory disk number
+	putUInt16(trailer, 1); // entries on this disk
+	putUInt16(trailer, 1); // total entries
+	putUInt32(trailer, directorySize);
+	putUInt32(trailer, directoryOffset);
+	putUInt16(trailer, 0); // comment length
+	writeAll(out, trailer);
+
+	stat = apr_file_close(out);
+
+	if (stat != APR_SUCCESS)
+	{
+		throw IOException(stat);
+	}
+
+	apr_file_close(in);
+	priv->destination.setAutoDelete(false);
+#else
 	apr_pool_t* aprpool = p.getAPRPool();
 	apr_procattr_t* attr;
 	apr_status_t stat = apr_procattr_create(&attr, aprpool);
@@ -139,6 +295,7 @@ bool ZipCompressAction::execute(LOG4CXX_NS::helpers::Pool& p) const
 	{
 		throw IOException(exitCode);
 	}
+#endif
 
 	if (priv->deleteSource)
 	{
@@ -151,3 +308,7 @@ bool ZipCompressAction::execute(LOG4CXX_NS::helpers::Pool& p) const
 void ZipCompressAction::setThrowIOExceptionOnForkFailure(bool throwIO){
 	priv->throwIOExceptionOnForkFailure = throwIO;
 }
+
+void ZipCompressAction::setCompressionLevel(int level){
+	priv->compressionLevel = level;
+}
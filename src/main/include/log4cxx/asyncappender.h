@@ -55,6 +55,31 @@ The output may contain one <i>Discarded</i> message per logger name,
 the logging event of the highest level for each logger
 whose events have been discarded.
 
+The <b>OverflowPolicy</b> property provides finer control
+of events that arrive when the bounded buffer is full.
+Using <b>DropOldest</b>, <b>DropBelowThreshold</b> or <b>SpillToDisk</b>,
+the logging thread is never blocked and
+overflowing events are held (in memory or in <b>SpillFile</b>)
+until the background thread has forwarded the content of the bounded buffer.
+Using <b>DropBelowThreshold</b> or <b>SpillToDisk</b>,
+events at or above the <b>OverflowThreshold</b> level are never discarded.
+Memory use is bounded: once <b>BufferSize</b> overflowing events are held in memory
+(twice that while <b>SpillToDisk</b> is writing to <b>SpillFile</b>),
+the logging thread waits as it does using <b>Block</b>.
+This also applies when <b>SpillFile</b> is empty or cannot be written.
+
+By default, the background thread forwards each event
+to the attached appenders in turn,
+so a slow appender delays the others.
+When <b>DispatcherPerAppender</b> is true,
+each attached appender has its own queue (of up to <b>BufferSize</b> events)
+and its own thread.
+Each appender receives events in the order they were logged.
+Using OverflowPolicy::Block, a slow appender will delay the others
+only when its queue is full.
+Using any other policy, events that do not fit in an appender's queue
+are discarded (for that appender) with a <i>Discarded</i> summary.
+
 To determine whether the application produces logging events faster
 than the background thread is able to process, enable [Log4cxx internal debugging](internal-debugging.html).
 The AsyncAppender will output a histogram of queue length frequencies when closed.
@@ -70,6 +95,18 @@ class LOG4CXX_EXPORT AsyncAppender :
 		struct AsyncAppenderPriv;
 
 	public:
+		/**
+		 * The action taken when an event arrives and the bounded buffer is full.
+		 */
+		enum class OverflowPolicy
+		{
+			Block,              //!< Wait for a free slot (the default)
+			Discard,            //!< Discard the event, adding it to the <i>Discarded</i> summary
+			DropOldest,         //!< Hold up to <b>BufferSize</b> overflowing events in memory, discarding the oldest of these
+			DropBelowThreshold, //!< Discard the event when its level is below <b>OverflowThreshold</b>, otherwise hold up to <b>BufferSize</b> events in memory before blocking
+			SpillToDisk         //!< Hold up to <b>BufferSize</b> overflowing events in memory, moving any more to <b>SpillFile</b> on a background thread, blocking when that is not possible
+		};
+
 		DECLARE_LOG4CXX_OBJECT(AsyncAppender)
 		BEGIN_LOG4CXX_CAST_MAP()
 		LOG4CXX_CAST_ENTRY(AsyncAppender)
@@ -176,6 +213,10 @@ class LOG4CXX_EXPORT AsyncAppender :
 		 * Sets whether appender should wait if there is no
 		 * space available in the event buffer or immediately return.
 		 *
+		 * Setting \c value to true selects OverflowPolicy::Block.
+		 * Setting \c value to false selects OverflowPolicy::Discard
+		 * when the current policy is OverflowPolicy::Block.
+		 *
 		 * @param value true if appender should wait until available space in buffer.
 		 */
 		void setBlocking(bool value);
@@ -189,6 +230,62 @@ class LOG4CXX_EXPORT AsyncAppender :
 		 */
 		bool getBlocking() const;
 
+		/**
+		 * Use \c value as the action taken when an event arrives and the bounded buffer is full.
+		 */
+		void setOverflowPolicy(OverflowPolicy value);
+
+		/**
+		 * The action taken when an event arrives and the bounded buffer is full.
+		 * @return the current value of the <b>OverflowPolicy</b> option.
+		 */
+		OverflowPolicy getOverflowPolicy() const;
+
+		/**
+		 * Do not discard events at or above \c level
+		 * when using OverflowPolicy::DropBelowThreshold.
+		 * \c level must be above Level::getAll().
+		 */
+		void setOverflowThreshold(const LevelPtr& level);
+
+		/**
+		 * The lowest level of event that is never discarded
+		 * when using OverflowPolicy::DropBelowThreshold.
+		 * @return the current value of the <b>OverflowThreshold</b> option.
+		 */
+		LevelPtr getOverflowThreshold() const;
+
+		/**
+		 * Use \c path as the file that holds overflowing events
+		 * when using OverflowPolicy::SpillToDisk.
+		 *
+		 * The file is deleted whenever all spilled events have been forwarded
+		 * and when this appender is closed.
+		 * If \c path is empty or the file cannot be written,
+		 * up to <b>BufferSize</b> overflowing events are held in memory,
+		 * after which logging threads wait for the dispatch thread.
+		 */
+		void setSpillFile(const LogString& path);
+
+		/**
+		 * The file that holds overflowing events
+		 * when using OverflowPolicy::SpillToDisk.
+		 * @return the current value of the <b>SpillFile</b> option.
+		 */
+		LogString getSpillFile() const;
+
+		/**
+		 * Use a separate queue and thread for each attached appender when \c value is true.
+		 * Must be set before the first event is appended.
+		 */
+		void setDispatcherPerAppender(bool value);
+
+		/**
+		 * Does each attached appender have its own queue and thread?
+		 * @return the current value of the <b>DispatcherPerAppender</b> option.
+		 */
+		bool getDispatcherPerAppender() const;
+
 
 		/**
 		\copybrief AppenderSkeleton::setOption()
@@ -198,6 +295,10 @@ class LOG4CXX_EXPORT AsyncAppender :
 		LocationInfo | True,False | False
 		BufferSize | int  | 128
 		Blocking | True,False | True
+		OverflowPolicy | Block,Discard,DropOldest,DropBelowThreshold,SpillToDisk | Block
+		OverflowThreshold | Trace,Debug,Info,Warn,Error,Fatal | Warn
+		SpillFile | {any} | -
+		DispatcherPerAppender | True,False | False
 
 		\sa AppenderSkeleton::setOption()
 		 */
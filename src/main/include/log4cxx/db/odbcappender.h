@@ -55,6 +55,8 @@ The ODBCAppender sends log events to a database.
 <p>Each append call adds the spi::LoggingEvent to a buffer.
 When the buffer is full, values are extracted from each spi::LoggingEvent
 and the sql insert statement executed.
+Where the ODBC driver supports arrays of parameter values,
+the statement is executed once for the whole buffer.
 
 The SQL insert statement pattern must be provided
 either in the Log4cxx configuration file
@@ -72,6 +74,12 @@ The following <b>param</b> elements are optional:
   Delay executing the sql until this many logging events are available.
   One by default, meaning an sql statement is executed
   whenever a logging event is appended.
+- <b>BackgroundFlush</b> -
+  When true, a full buffer is inserted by a dedicated thread
+  so logging requests do not wait for the database.
+  Up to eight buffers of logging events are held for that thread,
+  after which logging events are discarded.
+  False by default.
 - <b>ColumnMapping</b> -
   One element for each "?" in the <b>sql</b> statement
   in a sequence corresponding to the columns in the insert statement.
@@ -162,6 +170,7 @@ class LOG4CXX_EXPORT ODBCAppender : public AppenderSkeleton
 		Supported options | Supported values | Default value
 		:-------------- | :----------------: | :---------------:
 		BufferSize | {int} | 1
+		BackgroundFlush | True,False | False
 		ConnectionString | {any} | -
 		URL | {any} | -
 		DSN | {any} | -
@@ -264,6 +273,17 @@ class LOG4CXX_EXPORT ODBCAppender : public AppenderSkeleton
 		const LogString& getPassword() const;
 
 		size_t getBufferSize() const;
+
+		/**
+		* Use a dedicated thread to insert logging events when \c newValue is true.
+		* Takes effect when activateOptions() is called.
+		*/
+		void setBackgroundFlush(bool newValue);
+
+		/**
+		* Are logging events inserted by a dedicated thread?
+		*/
+		bool getBackgroundFlush() const;
 	private:
 		ODBCAppender(const ODBCAppender&);
 		ODBCAppender& operator=(const ODBCAppender&);
@@ -0,0 +1,233 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _LOG4CXX_DEFERRED_FORMAT_H
+#define _LOG4CXX_DEFERRED_FORMAT_H
+
+#include <log4cxx/spi/deferredmessage.h>
+#include <log4cxx/helpers/transcoder.h>
+#if LOG4CXX_USING_STD_FORMAT
+#include <format>
+#else
+#include <fmt/format.h>
+#endif
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+namespace LOG4CXX_NS
+{
+
+namespace spi
+{
+/**
+A message defined by a format string literal and copies of the argument values.
+
+Argument types must not require more than the default new alignment
+because DeferredMessage provides only the non-aligned allocation functions.
+*/
+template <class... Args>
+class FormatMessage : public DeferredMessage
+{
+	public:
+		static_assert(alignof(std::tuple<Args...>) <= alignof(std::max_align_t)
+			, "DeferredMessage::operator new does not support over-aligned argument types");
+
+		FormatMessage(::LOG4CXX_FORMAT_NS::string_view fmt, Args... values)
+			: m_format(fmt)
+			, m_args(std::move(values)...)
+		{
+		}
+
+		/**
+		 * Append the formatted text to \c output.
+		 * When the values cannot be formatted, the format string and the reason are appended
+		 * and the exception is rethrown so it can be reported.
+		 */
+		void format(LogString& output) const override
+		{
+			std::string text;
+			try
+			{
+				text = std::apply([this](const Args&... args)
+					{
+						return ::LOG4CXX_FORMAT_NS::vformat(m_format, ::LOG4CXX_FORMAT_NS::make_format_args(args...));
+					}, m_args);
+			}
+			catch (::LOG4CXX_FORMAT_NS::format_error& ex)
+			{
+				text.assign(m_format.data(), m_format.size());
+				text += " [format error: ";
+				text += ex.what();
+				text += "]";
+				helpers::Transcoder::decode(text, output);
+				throw;
+			}
+			helpers::Transcoder::decode(text, output);
+		}
+
+	private:
+		::LOG4CXX_FORMAT_NS::string_view m_format;
+		std::tuple<Args...> m_args;
+};
+
+/**
+The type that holds a copy of a \c T argument value.
+Character pointers and string views are held as a std::string
+so the referenced characters need not outlive the logging request.
+*/
+template <class T, class D = typename std::decay<T>::type>
+using DeferredValue = typename std::conditional
+	< std::is_same<D, char*>::value
+	|| std::is_same<D, const char*>::value
+	|| std::is_same<D, std::string_view>::value
+	|| std::is_same<D, ::LOG4CXX_FORMAT_NS::string_view>::value
+	, std::string
+	, D
+	>::type;
+
+/**
+A message defined by \c fmt and decay-copies of \c args.
+
+\c fmt is checked against the argument types at compile time where the compiler supports it.
+It must be a string literal, or otherwise remain valid until the message is formatted.
+*/
+template <class... Args>
+DeferredMessageUniquePtr makeFormatMessage(::LOG4CXX_FORMAT_NS::format_string<Args...> fmt, Args&&... args)
+{
+#if LOG4CXX_USING_STD_FORMAT
+	::LOG4CXX_FORMAT_NS::string_view text = fmt.get();
+#else
+	::LOG4CXX_FORMAT_NS::string_view text = fmt;
+#endif
+	return DeferredMessageUniquePtr(new FormatMessage<DeferredValue<Args>...>(text, DeferredValue<Args>(std::forward<Args>(args))...));
+}
+
+} // namespace spi
+} // namespace log4cxx
+
+/** @addtogroup LoggingMacros Logging macros
+@{
+*/
+
+/**
+Add a new logging event, containing a message defined by \c fmt and <code>...</code>,
+to attached appender(s) if this logger is enabled for \c level events.
+
+Copies of the values in <code>...</code> are held by the logging event
+and the message text is produced when it is first required.
+When \c logger forwards events to an AsyncAppender,
+the text is normally produced on the AsyncAppender's background thread.
+Arguments that are trivially copyable are the least expensive.
+
+@param logger the logger to be used.
+@param level The logging event level.
+@param fmt a string literal defining the layout of the message.
+@param ... the variable parts of the message.
+*/
+#define LOG4CXX_DEFER_LOG_FMT(logger, level, fmt, ...) do { \
+		if (logger->isEnabledFor(level)) {\
+			logger->addEvent(level, ::LOG4CXX_NS::spi::makeFormatMessage(fmt LOG4CXX_FMT_VA_ARG(__VA_ARGS__) ), LOG4CXX_LOCATION); }} while (0)
+
+#if !defined(LOG4CXX_THRESHOLD) || LOG4CXX_THRESHOLD <= 5000
+/**
+Add a new logging event, containing a message defined by \c fmt and <code>...</code>,
+to attached appender(s) if \c logger is enabled for <code>TRACE</code> events.
+See ::LOG4CXX_DEFER_LOG_FMT.
+*/
+#define LOG4CXX_DEFER_TRACE_FMT(logger, fmt, ...) do { \
+		if (LOG4CXX_UNLIKELY(::LOG4CXX_NS::Logger::isTraceEnabledFor(logger))) {\
+			logger->addEvent(::LOG4CXX_NS::Level::getTrace(), ::LOG4CXX_NS::spi::makeFormatMessage(fmt LOG4CXX_FMT_VA_ARG(__VA_ARGS__) ), LOG4CXX_LOCATION); }} while (0)
+#else
+#define LOG4CXX_DEFER_TRACE_FMT(logger, fmt, ...)
+#endif
+
+#if !defined(LOG4CXX_THRESHOLD) || LOG4CXX_THRESHOLD <= 10000
+/**
+Add a new logging event, containing a message defined by \c fmt and <code>...</code>,
+to attached appender(s) if \c logger is enabled for <code>DEBUG</code> events.
+See ::LOG4CXX_DEFER_LOG_FMT.
+
+\usage
+~~~{.cpp}
+LOG4CXX_DEFER_DEBUG_FMT(m_log, "AddMesh: vertices {} triangles {}", vertexCount, triangleCount);
+~~~
+*/
+#define LOG4CXX_DEFER_DEBUG_FMT(logger, fmt, ...) do { \
+		if (LOG4CXX_UNLIKELY(::LOG4CXX_NS::Logger::isDebugEnabledFor(logger))) {\
+			logger->addEvent(::LOG4CXX_NS::Level::getDebug(), ::LOG4CXX_NS::spi::makeFormatMessage(fmt LOG4CXX_FMT_VA_ARG(__VA_ARGS__) ), LOG4CXX_LOCATION); }} while (0)
+#else
+#define LOG4CXX_DEFER_DEBUG_FMT(logger, fmt, ...)
+#endif
+
+#if !defined(LOG4CXX_THRESHOLD) || LOG4CXX_THRESHOLD <= 20000
+/**
+Add a new logging event, containing a message defined by \c fmt and <code>...</code>,
+to attached appender(s) if \c logger is enabled for <code>INFO</code> events.
+See ::LOG4CXX_DEFER_LOG_FMT.
+*/
+#define LOG4CXX_DEFER_INFO_FMT(logger, fmt, ...) do { \
+		if (::LOG4CXX_NS::Logger::isInfoEnabledFor(logger)) {\
+			logger->addEvent(::LOG4CXX_NS::Level::getInfo(), ::LOG4CXX_NS::spi::makeFormatMessage(fmt LOG4CXX_FMT_VA_ARG(__VA_ARGS__) ), LOG4CXX_LOCATION); }} while (0)
+#else
+#define LOG4CXX_DEFER_INFO_FMT(logger, fmt, ...)
+#endif
+
+#if !defined(LOG4CXX_THRESHOLD) || LOG4CXX_THRESHOLD <= 30000
+/**
+Add a new logging event, containing a message defined by \c fmt and <code>...</code>,
+to attached appender(s) if \c logger is enabled for <code>WARN</code> events.
+See ::LOG4CXX_DEFER_LOG_FMT.
+*/
+#define LOG4CXX_DEFER_WARN_FMT(logger, fmt, ...) do { \
+		if (::LOG4CXX_NS::Logger::isWarnEnabledFor(logger)) {\
+			logger->addEvent(::LOG4CXX_NS::Level::getWarn(), ::LOG4CXX_NS::spi::makeFormatMessage(fmt LOG4CXX_FMT_VA_ARG(__VA_ARGS__) ), LOG4CXX_LOCATION); }} while (0)
+#else
+#define LOG4CXX_DEFER_WARN_FMT(logger, fmt, ...)
+#endif
+
+#if !defined(LOG4CXX_THRESHOLD) || LOG4CXX_THRESHOLD <= 40000
+/**
+Add a new logging event, containing a message defined by \c fmt and <code>...</code>,
+to attached appender(s) if \c logger is enabled for <code>ERROR</code> events.
+See ::LOG4CXX_DEFER_LOG_FMT.
+*/
+#define LOG4CXX_DEFER_ERROR_FMT(logger, fmt, ...) do { \
+		if (::LOG4CXX_NS::Logger::isErrorEnabledFor(logger)) {\
+			logger->addEvent(::LOG4CXX_NS::Level::getError(), ::LOG4CXX_NS::spi::makeFormatMessage(fmt LOG4CXX_FMT_VA_ARG(__VA_ARGS__) ), LOG4CXX_LOCATION); }} while (0)
+#else
+#define LOG4CXX_DEFER_ERROR_FMT(logger, fmt, ...)
+#endif
+
+#if !defined(LOG4CXX_THRESHOLD) || LOG4CXX_THRESHOLD <= 50000
+/**
+Add a new logging event, containing a message defined by \c fmt and <code>...</code>,
+to attached appender(s) if \c logger is enabled for <code>FATAL</code> events.
+See ::LOG4CXX_DEFER_LOG_FMT.
+*/
+#define LOG4CXX_DEFER_FATAL_FMT(logger, fmt, ...) do { \
+		if (::LOG4CXX_NS::Logger::isFatalEnabledFor(logger)) {\
+			logger->addEvent(::LOG4CXX_NS::Level::getFatal(), ::LOG4CXX_NS::spi::makeFormatMessage(fmt LOG4CXX_FMT_VA_ARG(__VA_ARGS__) ), LOG4CXX_LOCATION); }} while (0)
+#else
+#define LOG4CXX_DEFER_FATAL_FMT(logger, fmt, ...)
+#endif
+
+/**@}*/
+
+#endif //_LOG4CXX_DEFERRED_FORMAT_H
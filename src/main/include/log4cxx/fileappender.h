@@ -38,6 +38,14 @@ class Pool;
 *  when <code>BufferedIO</code> option is set <code>true</code>.
 *  Use the <code>BufferedSeconds</code> option to control the frequency,
 *  using <code>0</code> to disable the background output buffer flush.
+*
+*  When the <code>GroupCommitMilliseconds</code> option is greater than zero,
+*  logging events are gathered into batches which are each written to the file
+*  with a single system call. A batch is written
+*  when it holds <code>BufferSize</code> bytes
+*  or after at most <code>GroupCommitMilliseconds</code>.
+*  If a periodic write fails, a warning is output
+*  and each subsequent event is written as it is appended.
 *  Refer to FileAppender::setOption() for more information.
 *
 */
@@ -136,6 +144,7 @@ class LOG4CXX_EXPORT FileAppender : public WriterAppender
 		BufferedSeconds | {any} | 5
 		ImmediateFlush | True,False | False
 		BufferSize | (\ref fileSz1 "1") | 8 KB
+		GroupCommitMilliseconds | {any} | 0
 
 		\anchor fileSz1 (1) An integer in the range 0 - 2^63.
 		 You can specify the value with the suffixes "KB", "MB" or "GB" so that the integer is
@@ -166,6 +175,13 @@ class LOG4CXX_EXPORT FileAppender : public WriterAppender
 		*/
 		int getBufferedSeconds() const;
 
+		/**
+		Get the maximum number of milliseconds a logging event is held
+		before it is written to the file.
+		Zero means group commit is not used.
+		*/
+		int getGroupCommitMilliseconds() const;
+
 		/**
 		Set file open mode to \c newValue.
 
@@ -210,6 +226,16 @@ class LOG4CXX_EXPORT FileAppender : public WriterAppender
 		*/
 		void setBufferedSeconds(int newValue);
 
+		/**
+		Write logging events in batches, holding each event for at most \c newValue milliseconds.
+		A batch is also written when it reaches the size of the output buffer.
+		Use zero (the default) to write each event when it is appended.
+
+		Note: #activateOptions must be called after an option is changed
+		to activate the new period.
+		*/
+		void setGroupCommitMilliseconds(int newValue);
+
 		/**
 		 *   Replaces double backslashes with single backslashes
 		 *   for compatibility with paths from earlier XML configurations files.
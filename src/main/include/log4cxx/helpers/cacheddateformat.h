@@ -24,6 +24,14 @@ namespace LOG4CXX_NS
 {
 namespace pattern
 {
+/**
+ * A DateFormat that reuses the result of the previous conversion
+ * when a time is within the same second.
+ *
+ * Each thread holds its own copy of the previous conversion,
+ * so an instance can be used concurrently without locking
+ * where the compiler supports thread local storage.
+ */
 class LOG4CXX_EXPORT CachedDateFormat : public LOG4CXX_NS::helpers::DateFormat
 {
 	public:
@@ -94,6 +94,14 @@ class LOG4CXX_EXPORT SimpleDateFormat : public DateFormat
 		 */
 		void setTimeZone(const TimeZonePtr& zone);
 
+		/**
+		 * Is the pattern formatted from a compiled list of fields?
+		 *
+		 * A pattern containing only numeric, month name and literal specifiers
+		 * is compiled when this is constructed.
+		 */
+		bool isCompiled() const;
+
 	private:
 		LOG4CXX_DECLARE_PRIVATE_MEMBER_PTR(SimpleDateFormatPrivate, m_priv)
 
@@ -29,15 +29,62 @@ namespace helpers
 /**
 SyslogWriter is a wrapper around the DatagramSocket class
 it writes text to the specified host on the port 514 (UNIX syslog)
+
+A SyslogWriter can instead hold messages until a batch is complete,
+sending a batch of UDP datagrams using a single system call where supported,
+or it can send messages over a TCP connection
+using the octet counting framing of RFC 6587 and RFC 5425.
 */
 class LOG4CXX_EXPORT SyslogWriter
 {
 	public:
 #define SYSLOG_PORT 514
+		/**
+		The transport used to send messages.
+		*/
+		enum Protocol
+		{
+			UDP, //!< One datagram per message
+			TCP  //!< A stream of octet counted messages
+		};
+
 		SyslogWriter(const LogString& syslogHost, int syslogHostPort = SYSLOG_PORT);
+
+		/**
+		A writer that sends messages to \c syslogHost using \c protocol,
+		holding up to \c batchSize messages until #flush is called.
+		*/
+		SyslogWriter(const LogString& syslogHost, int syslogHostPort, Protocol protocol, int batchSize);
 		~SyslogWriter();
 		void write(const LogString& string);
 
+		/**
+		Send any messages held by this writer,
+		first opening the TCP connection if it is not open
+		and the reconnection delay has elapsed since the last failed attempt.
+		*/
+		void flush();
+
+		/**
+		Send any messages held by this writer and discard those that could not be sent.
+		A TCP connection that is not open is attempted regardless of the reconnection delay.
+		*/
+		void close();
+
+		/**
+		Wait \c initialMilliseconds after a failed TCP connection attempt before the next attempt,
+		doubling the delay after each further failure up to \c maximumMilliseconds.
+		*/
+		void setReconnectionDelay(int initialMilliseconds, int maximumMilliseconds);
+
+		/**
+		The number of messages discarded since this method was last called.
+
+		A TCP writer holds up to 1 MiB of messages while the connection is unavailable.
+		Messages that do not fit are discarded.
+		*/
+		size_t takeDiscardedCount();
+
 	private:
 		LOG4CXX_DECLARE_PRIVATE_MEMBER_PTR(SyslogWriterPrivate, m_priv)
 };
@@ -68,10 +68,31 @@ class LOG4CXX_EXPORT ThreadSpecificData
 		NDC::Stack& getStack();
 
 		/**
-		 *  The mapped diagnostic context of the current thread
+		 *  The mapped diagnostic context of the current thread.
+		 *
+		 *  Calling this method discards the copy provided by getMapCopy(),
+		 *  as the caller may change the map.
+		 *  Complete any change before the next call to getMapCopy().
 		 */
 		MDC::Map& getMap();
 
+		/**
+		 *  The mapped diagnostic context of the current thread
+		 */
+		const MDC::Map& getMap() const;
+
+		/**
+		 *  A reference counted pointer to an immutable copy of a mapped diagnostic context.
+		 */
+		using MapPtr = std::shared_ptr<const MDC::Map>;
+
+		/**
+		 *  An immutable copy of the mapped diagnostic context of the current thread.
+		 *
+		 *  The same copy is provided until the mapped diagnostic context is changed.
+		 */
+		MapPtr getMapCopy();
+
 		/**
 		 *  A character outpur stream only assessable to the current thread
 		 */
@@ -34,6 +34,8 @@ class LoggerRepository;
 LOG4CXX_PTR_DEF(LoggerRepository);
 class LoggerFactory;
 LOG4CXX_PTR_DEF(LoggerFactory);
+class DeferredMessage;
+LOG4CXX_UNIQUE_PTR_DEF(DeferredMessage);
 }
 
 class Logger;
@@ -745,6 +747,17 @@ class LOG4CXX_EXPORT Logger
 		void addEventLS(const LevelPtr& level, LogString&& message
 			, const spi::LocationInfo& location = spi::LocationInfo::getLocationUnavailable()) const;
 
+		/**
+		Add a new logging event containing the text produced by \c message and \c location
+		to attached appender(s) without further checks.
+		The text is produced when it is first required.
+		@param level The logging event level.
+		@param message the values from which the message text is produced.
+		@param location location of the logging statement.
+		*/
+		void addEvent(const LevelPtr& level, spi::DeferredMessageUniquePtr&& message
+			, const spi::LocationInfo& location = spi::LocationInfo::getLocationUnavailable()) const;
+
 		/**
 		Add a new logging event containing \c message and \c location to attached appender(s)
 		without further checks.
@@ -124,6 +124,38 @@ class LOG4CXX_EXPORT SocketAppenderSkeleton : public AppenderSkeleton
 
 		void fireConnector();
 
+		/**
+		The <b>BufferSize</b> option takes a non-negative integer
+		representing the maximum number of bytes held for a dedicated sending thread.
+		When non-zero, logging output is copied to a buffer
+		and sent (many events at a time) by that thread,
+		so a slow or unreachable server never blocks the logging thread.
+		Output that does not fit in the buffer is discarded.
+		The default value of zero sends each event on the logging thread.
+
+		Takes effect when activateOptions() is called,
+		which stops any sending thread when the value is zero.
+		*/
+		void setBufferSize(int newValue);
+
+		/**
+		Returns value of the <b>BufferSize</b> option.
+		*/
+		int getBufferSize() const;
+
+		/**
+		The number of bytes held for the sending thread.
+		Always zero when the <b>BufferSize</b> option is zero.
+		*/
+		size_t getQueuedByteCount() const;
+
+		/**
+		The number of bytes discarded by the sending thread
+		because the buffer was full or the connection failed.
+		Always zero when the <b>BufferSize</b> option is zero.
+		*/
+		size_t getDiscardedByteCount() const;
+
 		/**
 		\copybrief AppenderSkeleton::setOption()
 
@@ -132,11 +164,15 @@ class LOG4CXX_EXPORT SocketAppenderSkeleton : public AppenderSkeleton
 		RemoteHost |  (\ref inetAddress "1") | -
 		Port | {int} | (\ref defaultPort "2")
 		LocationInfo | True,False | False
+		ReconnectionDelay | {int} | (\ref defaultDelay "3")
+		BufferSize | {int} | 0
 
 		\anchor inetAddress (1) A valid internet address.
 
 		\anchor defaultPort (2) Provided by the derived class.
 
+		\anchor defaultDelay (3) Provided by the derived class.
+
 		\sa AppenderSkeleton::setOption()
 		*/
 		void setOption(const LogString& option, const LogString& value) override;
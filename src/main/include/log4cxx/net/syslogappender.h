@@ -37,6 +37,22 @@ namespace net
  * When the message is too large for the current MaxMessageLength,
  * the packet number and total # will be appended to the end of the
  * message like this: (5/10)
+ *
+ * Where datagrams may be lost, set the Protocol option to TCP.
+ * Messages are then sent over a TCP connection
+ * using the octet counting framing of RFC 6587 (as used by RFC 5425)
+ * and are not split.
+ * The connection is opened (and reopened) on a background thread.
+ * After a failed attempt, the next attempt waits ReconnectionDelay milliseconds,
+ * doubling after each further failure up to MaxReconnectionDelay milliseconds.
+ * While it is unavailable, up to 1 MiB of messages are held and then sent;
+ * the number of further messages discarded is reported to the error handler.
+ * A final connection attempt is made when the appender is closed.
+ *
+ * To reduce the system calls required at high logging rates,
+ * set the BatchSize option to the number of messages held before they are sent.
+ * A batch of UDP datagrams is sent using a single system call where supported.
+ * Held messages are also sent every BatchMilliseconds and when the appender is closed.
  */
 class LOG4CXX_EXPORT SyslogAppender : public AppenderSkeleton
 {
@@ -78,7 +94,7 @@ class LOG4CXX_EXPORT SyslogAppender : public AppenderSkeleton
 		/**
 		\copybrief AppenderSkeleton::activateOptions()
 
-		No action is performed in this implementation.
+		Connects to the syslog host using the current Protocol and BatchSize values.
 		*/
 		void activateOptions(helpers::Pool& p) override;
 
@@ -90,6 +106,11 @@ class LOG4CXX_EXPORT SyslogAppender : public AppenderSkeleton
 		SysLogHost |  (\ref sysLogAddress "1") | -
 		Facility | (\ref facility "2") | -
 		MaxMessageLength | {int} | 1024
+		Protocol | UDP,TCP | UDP
+		BatchSize | {int} | 1
+		BatchMilliseconds | {int} | 1000
+		ReconnectionDelay | {int} | 1000
+		MaxReconnectionDelay | {int} | 30000
 
 		\anchor sysLogAddress (1) A valid internet address, optionally with the port number as a suffix after a ':'.
 
@@ -113,6 +134,10 @@ class LOG4CXX_EXPORT SyslogAppender : public AppenderSkeleton
 		where log output should go.
 		<b>WARNING</b> If the SyslogHost is not set, then this appender
 		will fail.
+
+		The writer is created when activateOptions() is called
+		or, if that has not been called, by the first logging event.
+		Changing the host replaces an existing writer.
 		*/
 		void setSyslogHost(const LogString& syslogHost);
 
@@ -152,6 +177,75 @@ class LOG4CXX_EXPORT SyslogAppender : public AppenderSkeleton
 
 		int getMaxMessageLength() const;
 
+		/**
+		Use \c newValue (UDP or TCP) to send messages.
+		This is the <b>Protocol</b> option.
+		A TCP connection is used by messages sent to the local host
+		instead of the system function 'syslog'.
+
+		Takes effect when activateOptions() is called.
+		*/
+		void setProtocol(const LogString& newValue);
+
+		/**
+		Returns the value of the <b>Protocol</b> option.
+		*/
+		LogString getProtocol() const;
+
+		/**
+		Hold up to \c newValue messages before sending them.
+		This is the <b>BatchSize</b> option.
+
+		Takes effect when activateOptions() is called.
+		*/
+		void setBatchSize(int newValue);
+
+		/**
+		Returns the value of the <b>BatchSize</b> option.
+		*/
+		int getBatchSize() const;
+
+		/**
+		Send held messages every \c newValue milliseconds.
+		This is the <b>BatchMilliseconds</b> option.
+		Zero disables the periodic sending of held messages.
+
+		Takes effect when activateOptions() is called.
+		*/
+		void setBatchMilliseconds(int newValue);
+
+		/**
+		Returns the value of the <b>BatchMilliseconds</b> option.
+		*/
+		int getBatchMilliseconds() const;
+
+		/**
+		Wait \c newValue milliseconds after a failed TCP connection attempt before the next attempt.
+		The delay doubles after each further failure up to the <b>MaxReconnectionDelay</b> value.
+		This is the <b>ReconnectionDelay</b> option.
+
+		Takes effect when activateOptions() is called.
+		*/
+		void setReconnectionDelay(int newValue);
+
+		/**
+		Returns the value of the <b>ReconnectionDelay</b> option.
+		*/
+		int getReconnectionDelay() const;
+
+		/**
+		Wait no more than \c newValue milliseconds between TCP connection attempts.
+		This is the <b>MaxReconnectionDelay</b> option.
+
+		Takes effect when activateOptions() is called.
+		*/
+		void setMaxReconnectionDelay(int newValue);
+
+		/**
+		Returns the value of the <b>MaxReconnectionDelay</b> option.
+		*/
+		int getMaxReconnectionDelay() const;
+
 	protected:
 		void initSyslogFacilityStr();
 
@@ -42,6 +42,13 @@ especially when monitoring a servlet remotely.
 
 If no layout is provided, the log message only is sent to attached client(s).
 
+Output is held in a separate bounded buffer for each client
+and sent by a thread dedicated to that client,
+so a slow client does not delay logging requests.
+Output that does not fit in a client's buffer is discarded
+and the client is told how many bytes were discarded once it has caught up.
+A client that accepts no output for 10 seconds is disconnected.
+
 See TelnetAppender::setOption() for the available options.
 
 */
@@ -96,6 +103,7 @@ class LOG4CXX_EXPORT TelnetAppender : public AppenderSkeleton
 		Port | {int} | 23
 		MaxConnections | {int} | 20
 		Encoding | C,UTF-8,UTF-16,UTF-16BE,UTF-16LE,646,US-ASCII,ISO646-US,ANSI_X3.4-1968,ISO-8859-1,ISO-LATIN-1 | UTF-8
+		BufferSize | {int} | 64KB
 
 		\sa AppenderSkeleton::setOption()
 		*/
@@ -125,6 +133,21 @@ class LOG4CXX_EXPORT TelnetAppender : public AppenderSkeleton
 		 */
 		void setMaxConnections(int newValue);
 
+		/**
+		The maximum number of bytes held for each client.
+
+		\sa setOption
+		 */
+		int getBufferSize() const;
+
+		/**
+		Hold up to \c newValue bytes for each client.
+		Takes effect for clients that connect after this call.
+
+		\sa setOption
+		 */
+		void setBufferSize(int newValue);
+
 
 		/** Shutdown this appender. */
 		void close() override;
@@ -141,6 +164,7 @@ class LOG4CXX_EXPORT TelnetAppender : public AppenderSkeleton
 
 		void write(helpers::ByteBuffer&);
 		void writeStatus(const helpers::SocketPtr& socket, const LogString& msg, helpers::Pool& p);
+		void reportDiscards(helpers::Pool& p);
 		void acceptConnections();
 
 		struct TelnetAppenderPriv;
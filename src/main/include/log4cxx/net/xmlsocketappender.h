@@ -71,6 +71,8 @@ network connection. However, if the network connection is slower
 then the rate of event production, then the client can only
 progress at the network rate. In particular, if the network link
 to the the server is down, the client will be blocked.
+Set the <b>BufferSize</b> option to send events on a dedicated thread
+so the client is never blocked (events are instead discarded when the buffer is full).
 @n @n On the other hand, if the network link is up, but the server
 is down, the client will not be blocked when making log requests
 but the log events will be lost due to server unavailability.
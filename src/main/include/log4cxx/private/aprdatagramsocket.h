@@ -18,6 +18,7 @@
 #define LOG4CXX_HELPERS_APRDATAGRAM_SOCKET_H
 
 #include <log4cxx/helpers/datagramsocket.h>
+#include <string>
 
 namespace LOG4CXX_NS
 {
@@ -49,6 +50,12 @@ class APRDatagramSocket : public DatagramSocket {
 
 	virtual void connect(InetAddressPtr address, int port) override;
 
+	/**
+	 * Sends the \c count datagrams starting at \c datagrams to the connected address,
+	 * using a single system call for many datagrams where supported.
+	 */
+	void send(const std::string* datagrams, size_t count);
+
     private:
 	void init();
 };
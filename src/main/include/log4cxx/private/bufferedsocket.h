@@ -0,0 +1,86 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LOG4CXX_HELPERS_BUFFERED_SOCKET_H
+#define LOG4CXX_HELPERS_BUFFERED_SOCKET_H
+
+#include <log4cxx/helpers/socket.h>
+#include <functional>
+
+namespace LOG4CXX_NS
+{
+namespace helpers
+{
+
+/**
+A Socket that copies the bytes written to a bounded buffer
+which is sent over a connection by a dedicated thread.
+
+A write never blocks.
+Bytes that do not fit in the buffer are discarded and counted.
+Bytes written while there is no connection are held until #setConnection is called
+or the buffer is full.
+When a send fails, the connection is discarded and \c onDisconnect is called
+on the sending thread.
+*/
+class BufferedSocket : public Socket
+{
+	public:
+		BufferedSocket(const InetAddressPtr& address, int port, size_t capacity, std::function<void()> onDisconnect);
+		~BufferedSocket();
+
+		/**
+		Copy the remaining bytes in \c buf to the buffer or discard them if there is insufficient space.
+		*/
+		size_t write(ByteBuffer& buf) override;
+
+		/**
+		Send the buffered bytes if there is a connection, then stop the sending thread.
+		*/
+		void close() override;
+
+		/**
+		Use \c connection to send the buffered bytes.
+		*/
+		void setConnection(const SocketPtr& connection);
+
+		/**
+		Is there a connection on which to send the buffered bytes?
+		*/
+		bool isConnected() const;
+
+		/**
+		The number of bytes written but not yet sent.
+		*/
+		size_t getQueuedByteCount() const;
+
+		/**
+		The number of bytes discarded because the buffer was full or a send failed.
+		*/
+		size_t getDiscardedByteCount() const;
+
+	private:
+		struct BufferedSocketPriv;
+		void run();
+};
+
+LOG4CXX_PTR_DEF(BufferedSocket);
+
+} // namespace helpers
+} // namespace log4cxx
+
+#endif /* LOG4CXX_HELPERS_BUFFERED_SOCKET_H */
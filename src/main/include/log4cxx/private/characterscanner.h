@@ -0,0 +1,70 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _LOG4CXX_CHARACTER_SCANNER_H
+#define _LOG4CXX_CHARACTER_SCANNER_H
+
+#include <log4cxx/logstring.h>
+#include <initializer_list>
+
+namespace LOG4CXX_NS
+{
+namespace helpers
+{
+
+/**
+ * Finds the next occurrence of any one of a few ASCII characters.
+ *
+ * When logchar is char and the target supports SSE2 (or AVX2),
+ * 16 (or 32) characters are compared in each step,
+ * so a layout can copy the text between special characters in bulk.
+ */
+class CharacterScanner
+{
+	public:
+		enum { MaxCount = 8 };
+
+		/**
+		 * A scanner for the (up to \c MaxCount) ASCII characters in \c specials.
+		 */
+		CharacterScanner(std::initializer_list<logchar> specials);
+
+		/**
+		 * The first character in [\c begin, \c end) that is special, or \c end if there is none.
+		 */
+		const logchar* find(const logchar* begin, const logchar* end) const;
+
+		/**
+		 * The index of the first special character in \c input at or after \c start,
+		 * or LogString::npos if there is none.
+		 */
+		LogString::size_type find(const LogString& input, LogString::size_type start) const
+		{
+			auto end = input.data() + input.size();
+			auto result = find(input.data() + start, end);
+			return result == end ? LogString::npos : LogString::size_type(result - input.data());
+		}
+
+	private:
+		logchar m_specials[MaxCount];
+		int m_count;
+};
+
+} // namespace helpers
+} // namespace LOG4CXX_NS
+
+#endif //_LOG4CXX_CHARACTER_SCANNER_H
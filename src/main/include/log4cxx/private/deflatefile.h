@@ -0,0 +1,62 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _LOG4CXX_DEFLATE_FILE_H
+#define _LOG4CXX_DEFLATE_FILE_H
+
+#include <log4cxx/log4cxx.h>
+#include <cstdint>
+
+struct apr_file_t;
+
+namespace LOG4CXX_NS
+{
+namespace rolling
+{
+
+/**
+ * The CRC-32 and sizes of the content compressed by deflateFile.
+ */
+struct DeflateSummary
+{
+	uint32_t crc;
+	uint64_t inputSize;
+	uint64_t outputSize;
+};
+
+/**
+ * Write to \c destination the remaining content of \c source
+ * compressed (in fixed size chunks) using \c level (1-9, or -1 for the zlib default).
+ *
+ * When \c gzipName is not null, the output is in gzip format
+ * with \c gzipName and \c modificationTime (in seconds) in the header.
+ * Otherwise the output is raw deflate data (as used in a zip file entry).
+ *
+ * @throws IOException if \c source cannot be read or \c destination cannot be written.
+ */
+DeflateSummary deflateFile
+	( apr_file_t* source
+	, apr_file_t* destination
+	, int         level
+	, const char* gzipName = nullptr
+	, uint32_t    modificationTime = 0
+	);
+
+} // namespace rolling
+} // namespace LOG4CXX_NS
+
+#endif // _LOG4CXX_DEFLATE_FILE_H
@@ -21,6 +21,7 @@
 #include <log4cxx/private/writerappender_priv.h>
 #include <log4cxx/fileappender.h>
 #include <log4cxx/helpers/threadutility.h>
+#include <log4cxx/helpers/outputstream.h>
 
 namespace LOG4CXX_NS
 {
@@ -73,6 +74,41 @@ struct FileAppender::FileAppenderPriv : public WriterAppender::WriterAppenderPri
 	Only used when <code>bufferedIO == true</code>.
 	*/
 	helpers::ThreadUtility::ManagerWeakPtr taskManager;
+
+	/**
+	The maximum number of milliseconds a logging event is held before it is written.
+	Zero disables group commit.
+	*/
+	int groupCommitMilliseconds{ 0 };
+
+	/**
+	Manages the periodic group commit.
+	*/
+	helpers::ThreadUtility::ManagerWeakPtr groupCommitTaskManager;
+
+	/**
+	The name of the periodic task that writes the pending logging events.
+	*/
+	LogString groupCommitTaskName() const
+	{
+		return this->name + LOG4CXX_STR(".GroupCommit");
+	}
+
+	/**
+	A new stream that writes to \c fileName, appending to any existing content if \c append is true.
+	*/
+	virtual helpers::OutputStreamPtr createOutputStream(const LogString& fileName, bool append);
+
+	/**
+	An output stream that writes logging events to \c out in batches of up to \c batchSize bytes
+	when group commit is enabled, otherwise \c out.
+	*/
+	helpers::OutputStreamPtr createGroupCommitStream(const helpers::OutputStreamPtr& out, size_t batchSize);
+
+	/**
+	Stop the periodic group commit.
+	*/
+	void removeGroupCommitTask();
 };
 
 }
@@ -0,0 +1,116 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _LOG4CXX_FORMAT_BUFFER_H
+#define _LOG4CXX_FORMAT_BUFFER_H
+
+#include <log4cxx/private/log4cxx_private.h>
+#include <log4cxx/logstring.h>
+#include <vector>
+
+namespace LOG4CXX_NS
+{
+namespace helpers
+{
+
+/**
+ * An empty LogString, reusing storage released by the current thread,
+ * into which a layout can format a logging event.
+ *
+ * Storage of up to \c MaxCapacity characters is held for reuse when this object is destroyed.
+ * Each thread holds up to \c MaxCount buffers, so nested logging requests
+ * (for example, from an appender that logs) each use their own buffer.
+ * Storage is released to the heap once the thread's spare storage has been destroyed
+ * (for example, when a thread_local object logs during thread termination).
+ */
+class FormatBuffer
+{
+	public:
+		enum { MaxCapacity = 16 * 1024, MaxCount = 4 };
+
+		FormatBuffer()
+		{
+#if LOG4CXX_HAS_THREAD_LOCAL
+			auto spare = getSpare();
+			if (spare && !spare->items.empty())
+			{
+				m_value.swap(spare->items.back());
+				spare->items.pop_back();
+			}
+#endif
+		}
+
+		~FormatBuffer()
+		{
+#if LOG4CXX_HAS_THREAD_LOCAL
+			auto spare = getSpare();
+			if (spare && m_value.capacity() <= MaxCapacity && spare->items.size() < MaxCount)
+			{
+				m_value.clear();
+				spare->items.push_back(std::move(m_value));
+			}
+#endif
+		}
+
+		FormatBuffer(const FormatBuffer&) = delete;
+		FormatBuffer& operator=(const FormatBuffer&) = delete;
+
+		/**
+		 * The buffer content.
+		 */
+		LogString& str() { return m_value; }
+
+	private:
+		LogString m_value;
+
+#if LOG4CXX_HAS_THREAD_LOCAL
+		struct Spare
+		{
+			std::vector<LogString> items;
+			~Spare()
+			{
+				isDestroyed() = true;
+			}
+		};
+
+		/**
+		 * Has the current thread's spare storage been destroyed?
+		 * Trivially destructible, so it remains usable during thread termination.
+		 */
+		static bool& isDestroyed()
+		{
+			thread_local bool destroyed = false;
+			return destroyed;
+		}
+
+		/**
+		 * The current thread's spare storage, or null if buffers must be released to the heap.
+		 */
+		static Spare* getSpare()
+		{
+			if (isDestroyed())
+				return nullptr;
+			thread_local Spare spare;
+			return &spare;
+		}
+#endif
+};
+
+} // namespace helpers
+} // namespace LOG4CXX_NS
+
+#endif //_LOG4CXX_FORMAT_BUFFER_H
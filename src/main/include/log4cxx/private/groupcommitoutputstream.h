@@ -0,0 +1,77 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _LOG4CXX_GROUP_COMMIT_OUTPUT_STREAM_H
+#define _LOG4CXX_GROUP_COMMIT_OUTPUT_STREAM_H
+
+#include <log4cxx/helpers/outputstream.h>
+#include <atomic>
+#include <mutex>
+#include <string>
+
+namespace LOG4CXX_NS
+{
+namespace helpers
+{
+
+/**
+ * An OutputStream that gathers the bytes of logging events
+ * and passes each batch to the wrapped stream in a single write.
+ *
+ * A batch is written when it reaches \c batchSize bytes or #commit is called,
+ * or on each write after #setCommitEachWrite.
+ * The wrapped stream is written without holding the lock used by #write,
+ * so logging events can be added to the next batch while the previous batch is written.
+ */
+class GroupCommitOutputStream : public OutputStream
+{
+	public:
+		GroupCommitOutputStream(const OutputStreamPtr& out, size_t batchSize);
+		~GroupCommitOutputStream();
+
+		void close(Pool& p) override;
+		void flush(Pool& p) override;
+		void write(ByteBuffer& buf, Pool& p) override;
+
+		/**
+		 * Write any pending bytes to the wrapped stream.
+		 */
+		void commit(Pool& p);
+
+		/**
+		 * Write each batch as soon as it is added to.
+		 * Used when periodic commits are no longer possible.
+		 */
+		void setCommitEachWrite();
+
+	private:
+		OutputStreamPtr m_out;
+		size_t m_batchSize;
+		std::mutex m_pendingMutex; //!< Guards m_pending
+		std::string m_pending;
+		std::mutex m_commitMutex; //!< Serializes writes to m_out
+		std::string m_committing;
+		bool m_closed;
+		std::atomic<bool> m_commitEachWrite;
+};
+
+LOG4CXX_PTR_DEF(GroupCommitOutputStream);
+
+} // namespace helpers
+} // namespace LOG4CXX_NS
+
+#endif //_LOG4CXX_GROUP_COMMIT_OUTPUT_STREAM_H
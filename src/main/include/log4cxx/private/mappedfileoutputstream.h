@@ -0,0 +1,106 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _LOG4CXX_MAPPED_FILE_OUTPUT_STREAM_H
+#define _LOG4CXX_MAPPED_FILE_OUTPUT_STREAM_H
+
+#include <log4cxx/helpers/outputstream.h>
+#include <log4cxx/helpers/pool.h>
+
+extern "C" {
+	struct apr_file_t;
+	struct apr_mmap_t;
+	struct apr_pool_t;
+}
+
+namespace LOG4CXX_NS
+{
+namespace helpers
+{
+
+/**
+ * An OutputStream that copies bytes into a memory mapped region of a file.
+ *
+ * The file is extended and the next region mapped
+ * each time \c mapSize bytes have been written,
+ * so there are no system calls for most writes.
+ * The disk space for each region is allocated before it is mapped,
+ * so a full disk results in an IOException rather than a SIGBUS signal.
+ * The file is truncated to the length of the written bytes when closed.
+ *
+ * When appending, trailing zero bytes in the last region
+ * (left by a process that ended before truncating the file) are overwritten.
+ *
+ * The caller must serialize access to this object.
+ */
+class MappedFileOutputStream : public OutputStream
+{
+	public:
+		MappedFileOutputStream(const LogString& fileName, bool append, size_t mapSize);
+		~MappedFileOutputStream();
+
+		void close(Pool& p) override;
+		void flush(Pool& p) override;
+		void write(ByteBuffer& buf, Pool& p) override;
+
+		/**
+		 * The size of each mapped region, a multiple of 64 KB.
+		 */
+		size_t getMapSize() const { return m_mapSize; }
+
+		/**
+		 * The number of bytes in the file, excluding the unused part of the mapped region.
+		 */
+		size_t getLength() const { return m_length; }
+
+		/**
+		 * The path provided to the constructor.
+		 */
+		const LogString& getFileName() const { return m_fileName; }
+
+	private:
+		/**
+		 * Extend the file and map the \c m_mapSize bytes at \c offset.
+		 */
+		void map(size_t offset);
+
+		/**
+		 * Allocate disk space for the \c m_mapSize bytes at \c offset.
+		 */
+		void allocate(size_t offset);
+
+		/**
+		 * Release the current mapped region.
+		 */
+		void unmap();
+
+		LogString m_fileName;
+		Pool m_pool;
+		apr_file_t* m_file;
+		apr_pool_t* m_mapPool; //!< Cleared when the region is released
+		apr_mmap_t* m_map;
+		size_t m_mapSize;
+		size_t m_mapOffset; //!< The file position of the start of the mapped region
+		size_t m_length; //!< The number of bytes in the file
+};
+
+LOG4CXX_PTR_DEF(MappedFileOutputStream);
+
+} // namespace helpers
+} // namespace LOG4CXX_NS
+
+#endif //_LOG4CXX_MAPPED_FILE_OUTPUT_STREAM_H
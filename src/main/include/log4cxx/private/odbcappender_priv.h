@@ -38,11 +38,15 @@
 	typedef int64_t SQLLEN;
 	typedef long SQLINTEGER;
 	typedef short SQLSMALLINT;
+	typedef unsigned short SQLUSMALLINT;
 #endif
 
 #if LOG4CXX_EVENTS_AT_EXIT
 #include <log4cxx/private/atexitregistry.h>
 #endif
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 
 namespace LOG4CXX_NS
 {
@@ -121,15 +125,77 @@ struct ODBCAppender::ODBCAppenderPriv : public AppenderSkeleton::AppenderSkeleto
 		ConverterPtr converter;
 		SQLSMALLINT  paramType;
 		SQLULEN      paramMaxCharCount;
-		SQLPOINTER   paramValue;
-		SQLINTEGER   paramValueSize;
-		SQLLEN       strLen_or_Ind;
+		SQLPOINTER   paramValue;     //!< The value in the first row
+		SQLINTEGER   paramValueSize; //!< The bytes used by each row
+		std::vector<char>   storage; //!< The values for rowCapacity rows
+		std::vector<SQLLEN> strLen_or_Ind; //!< The length/indicator for each row
 	};
 	std::vector<LogString>   mappedName;
 	std::vector<DataBinding> parameterValue;
+
+	/**
+	* The number of rows inserted by a single execution of the prepared statement.
+	* One when the driver does not support arrays of parameter values.
+	*/
+	size_t rowCapacity{ 1 };
+
+	/**
+	* The number of rows inserted by the next execution of the prepared statement.
+	*/
+	size_t rowCount{ 1 };
+
+	/**
+	* The status of each row after an execution of the prepared statement.
+	*/
+	std::vector<SQLUSMALLINT> paramStatus;
+
+	/**
+	* The number of rows processed by the last execution of the prepared statement.
+	*/
+	SQLULEN paramsProcessed{ 0 };
+
+	/**
+	* Insert events on flushThread?
+	*/
+	bool backgroundFlush{ false };
+
+	/**
+	* Inserts the pendingEvents when backgroundFlush is true.
+	*/
+	std::thread flushThread;
+	std::mutex flushMutex;
+	std::condition_variable flushRequested;
+	std::vector<spi::LoggingEventPtr> pendingEvents;
+	bool stopFlushing{ false };
+
+	/**
+	* Has the discarding of events been reported?
+	*/
+	bool discarding{ false };
+
 #if LOG4CXX_HAVE_ODBC
 	void setPreparedStatement(SQLHDBC con, helpers::Pool& p);
-	void setParameterValues(const spi::LoggingEventPtr& event, helpers::Pool& p);
+	void setParameterValues(const spi::LoggingEventPtr& event, size_t row, helpers::Pool& p);
+
+	/**
+	* Insert \c events using as few executions of the prepared statement as possible.
+	*/
+	void insertRows(ODBCAppender* owner, const std::vector<spi::LoggingEventPtr>& events, helpers::Pool& p);
+
+	/**
+	* Pass the buffered events to flushThread.
+	*/
+	void queueBuffer();
+
+	/**
+	* The flushThread main loop.
+	*/
+	void flushPending(ODBCAppender* owner);
+
+	/**
+	* Insert any pending events then stop flushThread.
+	*/
+	void stopFlushThread();
 #endif
 
 #if LOG4CXX_EVENTS_AT_EXIT
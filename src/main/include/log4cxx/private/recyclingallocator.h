@@ -0,0 +1,164 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _LOG4CXX_RECYCLING_ALLOCATOR_H
+#define _LOG4CXX_RECYCLING_ALLOCATOR_H
+
+#include <log4cxx/private/log4cxx_private.h>
+#include <new>
+#include <cstddef>
+
+namespace LOG4CXX_NS
+{
+namespace helpers
+{
+
+/**
+ * Memory blocks of \c Size bytes that are held for reuse by the current thread.
+ *
+ * A block released by a thread is available only to that thread.
+ * Up to \c MaxCount blocks are held by each thread,
+ * additional blocks are returned to the heap.
+ */
+template <std::size_t Size, std::size_t MaxCount = 64>
+class RecycledBlocks
+{
+	public:
+		/**
+		 * A block of at least \c Size bytes, reusing a previously released block if available.
+		 */
+		static void* allocate()
+		{
+#if LOG4CXX_HAS_THREAD_LOCAL
+			if (auto list = getList())
+			{
+				if (auto block = list->head)
+				{
+					list->head = block->next;
+					--list->count;
+					return block;
+				}
+			}
+#endif
+			return ::operator new(Size < sizeof(Block) ? sizeof(Block) : Size);
+		}
+
+		/**
+		 * Hold \c p (provided by allocate) for reuse by the current thread.
+		 */
+		static void deallocate(void* p)
+		{
+#if LOG4CXX_HAS_THREAD_LOCAL
+			auto list = getList();
+			if (list && list->count < MaxCount)
+			{
+				auto block = static_cast<Block*>(p);
+				block->next = list->head;
+				list->head = block;
+				++list->count;
+				return;
+			}
+#endif
+			::operator delete(p);
+		}
+
+	private:
+		struct Block
+		{
+			Block* next;
+		};
+#if LOG4CXX_HAS_THREAD_LOCAL
+		struct List
+		{
+			Block* head{nullptr};
+			std::size_t count{0};
+			~List()
+			{
+				isDestroyed() = true;
+				while (auto block = this->head)
+				{
+					this->head = block->next;
+					::operator delete(block);
+				}
+			}
+		};
+
+		/**
+		 * Has the current thread's list been destroyed?
+		 * Trivially destructible, so it remains usable during thread termination.
+		 */
+		static bool& isDestroyed()
+		{
+			thread_local bool destroyed = false;
+			return destroyed;
+		}
+
+		/**
+		 * The current thread's list, or null if blocks must be returned to the heap.
+		 */
+		static List* getList()
+		{
+			if (isDestroyed())
+				return nullptr;
+			thread_local List list;
+			return &list;
+		}
+#endif
+};
+
+/**
+ * A standard library compatible allocator that reuses single object blocks released by the current thread.
+ *
+ * Suitable for std::allocate_shared.
+ */
+template <typename T>
+class RecyclingAllocator
+{
+	public:
+		using value_type = T;
+
+		RecyclingAllocator() = default;
+
+		template <typename U>
+		RecyclingAllocator(const RecyclingAllocator<U>&) {}
+
+		T* allocate(std::size_t n)
+		{
+			if (1 == n)
+				return static_cast<T*>(RecycledBlocks<sizeof(T)>::allocate());
+			return static_cast<T*>(::operator new(n * sizeof(T)));
+		}
+
+		void deallocate(T* p, std::size_t n)
+		{
+			if (1 == n)
+				RecycledBlocks<sizeof(T)>::deallocate(p);
+			else
+				::operator delete(p);
+		}
+
+		template <typename U>
+		bool operator==(const RecyclingAllocator<U>&) const { return true; }
+
+		template <typename U>
+		bool operator!=(const RecyclingAllocator<U>&) const { return false; }
+};
+
+} // namespace helpers
+} // namespace LOG4CXX_NS
+
+#endif //_LOG4CXX_RECYCLING_ALLOCATOR_H
@@ -19,6 +19,9 @@
 #define _LOG4CXX_ROLLING_FILEAPPENDER_PRIV_H
 
 #include <log4cxx/private/fileappender_priv.h>
+#include <log4cxx/rolling/action.h>
+#include <condition_variable>
+#include <deque>
 
 namespace LOG4CXX_NS
 {
@@ -32,6 +35,13 @@ struct RollingFileAppender::RollingFileAppenderPriv : public FileAppenderPriv
 		FileAppenderPriv(),
 		fileLength(0) {}
 
+	~RollingFileAppenderPriv();
+
+	/**
+	 * The number of bytes logged to \c fileName.
+	 */
+	virtual size_t getActiveFileLength(const LogString& fileName, helpers::Pool& p);
+
 	/**
 	 * Triggering policy.
 	 */
@@ -51,6 +61,73 @@ struct RollingFileAppender::RollingFileAppenderPriv : public FileAppenderPriv
 	 *  save the loggingevent
 	 */
 	spi::LoggingEventPtr _event;
+
+	/**
+	 * An asynchronous rollover action and where to report a failure.
+	 */
+	struct PendingAction
+	{
+		ActionPtr action;
+		LogString fileName;
+		spi::ErrorHandlerPtr errorHandler;
+	};
+
+	/**
+	 * Asynchronous rollover actions in the order they are to be executed.
+	 * The front action is removed when it has completed.
+	 */
+	std::deque<PendingAction> pendingActions;
+
+	/**
+	 * Used to synchronize access to pendingActions and stopActionThread.
+	 */
+	std::mutex actionMutex;
+
+	/**
+	 * Signalled when an action is added to or removed from pendingActions.
+	 */
+	std::condition_variable actionChanged;
+
+	/**
+	 * Executes the actions in pendingActions.
+	 */
+	std::thread actionThread;
+
+	/**
+	 * Should actionThread exit when pendingActions is empty?
+	 */
+	bool stopActionThread = false;
+
+	/**
+	 * Used with the current time to name the file moved aside by a queued rollover.
+	 */
+	int deferredRolloverCount = 0;
+
+	/**
+	 * Execute \c action on actionThread after any previously added actions,
+	 * reporting a failure to \c errorHandler.
+	 */
+	void addAsyncAction(const ActionPtr& action, const LogString& fileName, const spi::ErrorHandlerPtr& errorHandler);
+
+	/**
+	 * Are any previously added actions yet to complete?
+	 */
+	bool hasAsyncActions();
+
+	/**
+	 * Wait until all previously added actions have completed.
+	 */
+	void waitForAsyncActions();
+
+	/**
+	 * Complete all previously added actions and terminate actionThread.
+	 */
+	void stopAsyncActions();
+
+	/**
+	 * The actionThread main loop.
+	 */
+	void executeAsyncActions();
 };
 
 } // namespace rolling
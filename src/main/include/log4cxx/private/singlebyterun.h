@@ -0,0 +1,99 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _LOG4CXX_SINGLE_BYTE_RUN_H
+#define _LOG4CXX_SINGLE_BYTE_RUN_H
+
+#include <log4cxx/logstring.h>
+#include <algorithm>
+
+namespace LOG4CXX_NS
+{
+namespace helpers
+{
+
+/**
+ * Bulk operations on a sequence of characters that each have a single byte encoding,
+ * so a transcoder can copy text between multibyte characters without decoding each character.
+ *
+ * When the target supports SSE2, char and wchar_t sequences are processed 16 bytes at a time.
+ */
+class SingleByteRun
+{
+	public:
+		/**
+		 * The number of characters at the start of [\c begin, \c end)
+		 * with a value less than \c limit (0x80 or 0x100).
+		 */
+		static size_t length(const char* begin, const char* end, unsigned int limit);
+		static size_t length(const wchar_t* begin, const wchar_t* end, unsigned int limit);
+
+		template <class CharType>
+		static size_t length(const CharType* begin, const CharType* end, unsigned int limit)
+		{
+			auto p = begin;
+			while (p < end && static_cast<unsigned int>(*p) < limit)
+				++p;
+			return p - begin;
+		}
+
+		/**
+		 * Store each character of [\c begin, \c end) in \c dst.
+		 * Each character must have a value less than 0x100.
+		 */
+		static void copy(const char* begin, const char* end, wchar_t* dst);
+		static void copy(const wchar_t* begin, const wchar_t* end, char* dst);
+
+		template <class FromType, class ToType>
+		static void copy(const FromType* begin, const FromType* end, ToType* dst)
+		{
+			std::transform(begin, end, dst, [](FromType ch) { return static_cast<ToType>(static_cast<unsigned char>(ch)); });
+		}
+
+		/**
+		 * Append each character of [\c begin, \c end) to \c dst.
+		 * Each character must have a value less than 0x100.
+		 */
+		template <class FromType, class String>
+		static void append(const FromType* begin, const FromType* end, String& dst)
+		{
+			if (begin < end)
+			{
+				auto offset = dst.size();
+				dst.resize(offset + (end - begin));
+				copy(begin, end, &dst[offset]);
+			}
+		}
+
+		/**
+		 * Append the characters at \c iter with a value less than \c limit to \c dst
+		 * and move \c iter past them.
+		 */
+		template <class FromString, class String>
+		static void append(const FromString& src, typename FromString::const_iterator& iter, String& dst, unsigned int limit = 0x80)
+		{
+			auto begin = src.data() + (iter - src.begin());
+			auto count = length(begin, src.data() + src.size(), limit);
+			append(begin, begin + count, dst);
+			iter += count;
+		}
+};
+
+} // namespace helpers
+} // namespace LOG4CXX_NS
+
+#endif //_LOG4CXX_SINGLE_BYTE_RUN_H
@@ -21,6 +21,7 @@
 #include <log4cxx/private/appenderskeleton_priv.h>
 #include <log4cxx/helpers/inetaddress.h>
 #include <log4cxx/helpers/threadutility.h>
+#include <log4cxx/private/bufferedsocket.h>
 
 namespace LOG4CXX_NS
 {
@@ -88,6 +89,24 @@ struct SocketAppenderSkeleton::SocketAppenderSkeletonPriv : public AppenderSkele
 	The reconnection task name.
 	*/
 	LogString taskName;
+
+	/**
+	The maximum number of bytes held for the sending thread.
+	Zero sends on the logging thread.
+	*/
+	int bufferSize{ 0 };
+
+	/**
+	Holds the bytes written by the derived class when bufferSize is not zero.
+	Modified only while holding \c mutex.
+	*/
+	helpers::BufferedSocketPtr sender;
+
+	helpers::BufferedSocketPtr getSender() const
+	{
+		std::lock_guard<std::recursive_mutex> lock(this->mutex);
+		return this->sender;
+	}
 };
 
 } // namespace net
@@ -16,6 +16,7 @@
  */
 
 #include <log4cxx/helpers/syslogwriter.h>
+#include <log4cxx/helpers/threadutility.h>
 
 #include "appenderskeleton_priv.h"
 
@@ -87,10 +88,71 @@ struct SyslogAppender::SyslogAppenderPriv : public AppenderSkeleton::AppenderSke
 	int syslogFacility; // Have LOG_USER as default
 	LogString facilityStr;
 	bool facilityPrinting;
-	std::unique_ptr<helpers::SyslogWriter> sw;
+	std::shared_ptr<helpers::SyslogWriter> sw;
 	LogString syslogHost;
-	int syslogHostPort;
+	int syslogHostPort{ -1 };
 	int maxMessageLength;
+
+	/**
+	Send UDP messages using the system function 'syslog'.
+	*/
+	bool useSystemSyslog{ LOG4CXX_HAVE_SYSLOG != 0 };
+
+	helpers::SyslogWriter::Protocol protocol{ helpers::SyslogWriter::UDP };
+
+	/**
+	The number of messages held before they are sent.
+	*/
+	int batchSize{ 1 };
+
+	/**
+	The maximum time (in milliseconds) a message is held before it is sent.
+	*/
+	int batchMilliseconds{ 1000 };
+
+	/**
+	The delay (in milliseconds) after the first failed TCP connection attempt.
+	*/
+	int reconnectionDelay{ 1000 };
+
+	/**
+	The limit (in milliseconds) of the doubling delay between TCP connection attempts.
+	*/
+	int maxReconnectionDelay{ 30000 };
+
+	/**
+	Manages the periodic sending of held messages.
+	*/
+	helpers::ThreadUtility::ManagerWeakPtr batchTaskManager;
+
+	/**
+	The name of the periodic task that sends held messages.
+	*/
+	LogString batchTaskName() const
+	{
+		return this->name + LOG4CXX_STR(".SyslogBatch");
+	}
+
+	/**
+	Are messages sent using a SyslogWriter?
+	*/
+	bool requiresWriter() const
+	{
+		return !this->syslogHost.empty()
+			&& !(this->useSystemSyslog && helpers::SyslogWriter::UDP == this->protocol);
+	}
+
+	/**
+	Replace the writer using the current option values.
+	*/
+	void createWriter();
+
+	void removeBatchTask();
+
+	/**
+	Use the error handler to report messages the writer could not send.
+	*/
+	void reportDiscarded();
 };
 
 }
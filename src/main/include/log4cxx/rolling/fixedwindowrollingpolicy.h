@@ -107,6 +107,7 @@ class LOG4CXX_EXPORT FixedWindowRollingPolicy : public RollingPolicyBase
 		MinIndex | 1-12 | 1
 		MaxIndex | 1-12 | 7
 		ThrowIOExceptionOnForkFailure | True,False | True
+		CompressionLevel | -1,0-9 | -1
 
 		\sa RollingPolicyBase::setOption()
 		*/
@@ -63,6 +63,17 @@ class GZCompressAction : public Action
 		 */
 		void setThrowIOExceptionOnForkFailure(bool throwIO);
 
+		/**
+		 * Use \c level (0 stores without compression, 1 is fastest, 9 gives the smallest file) when compressing.
+		 * The default (-1) uses the zlib default level, which is currently 6.
+		 *
+		 * Has no effect when log4cxx is built without zlib,
+		 * in which case compression is performed by a <code>gzip</code> process.
+		 *
+		 * @param level
+		 */
+		void setCompressionLevel(int level);
+
 	private:
 		GZCompressAction(const GZCompressAction&);
 		GZCompressAction& operator=(const GZCompressAction&);
@@ -0,0 +1,95 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if !defined(LOG4CXX_ROLLING_MAPPED_FILE_APPENDER_H)
+#define LOG4CXX_ROLLING_MAPPED_FILE_APPENDER_H
+
+#include <log4cxx/rolling/rollingfileappender.h>
+
+namespace LOG4CXX_NS
+{
+namespace rolling
+{
+
+/**
+ * A RollingFileAppender that copies logging events into a memory mapped region of the log file.
+ *
+ * The log file is extended and the next region is mapped
+ * each time <code>MapSize</code> bytes have been written,
+ * so most logging events are written without a system call.
+ * The file is truncated to the length of the logged content
+ * when it is closed or rolled over.
+ *
+ * The operating system writes modified pages to the file,
+ * so logging events are not lost if the process terminates abnormally.
+ * However, when the process terminates abnormally the file is not truncated,
+ * so the log file will end with up to <code>MapSize</code> null bytes.
+ *
+ * Any rolling and triggering policy used with RollingFileAppender can be used,
+ * for example SizeBasedTriggeringPolicy or TimeBasedRollingPolicy.
+ */
+class LOG4CXX_EXPORT MappedFileAppender : public RollingFileAppender
+{
+		DECLARE_LOG4CXX_OBJECT(MappedFileAppender)
+		BEGIN_LOG4CXX_CAST_MAP()
+		LOG4CXX_CAST_ENTRY(MappedFileAppender)
+		LOG4CXX_CAST_ENTRY_CHAIN(RollingFileAppender)
+		END_LOG4CXX_CAST_MAP()
+	protected:
+		struct MappedFileAppenderPriv;
+
+	public:
+		MappedFileAppender();
+
+		/**
+		\copybrief RollingFileAppender::setOption()
+
+		Supported options | Supported values | Default value
+		:-------------- | :----------------: | :---------------:
+		MapSize | (\ref mapSz "1") | 4 MB
+
+		\anchor mapSz (1) An integer in the range 0 - 2^63.
+		 You can specify the value with the suffixes "KB", "MB" or "GB" so that the integer is
+		 interpreted being expressed respectively in kilobytes, megabytes
+		 or gigabytes. For example, the value "10KB" will be interpreted as 10240.
+		 The value is rounded up to a multiple of 64 KB.
+
+		\sa RollingFileAppender::setOption()
+		*/
+		void setOption(const LogString& option, const LogString& value) override;
+
+		/**
+		The number of bytes by which the log file is extended.
+		*/
+		size_t getMapSize() const;
+
+		/**
+		Extend the log file by \c newValue bytes (rounded up to a multiple of 64 KB)
+		each time the mapped region is full.
+
+		Note: #activateOptions must be called after this option is changed
+		to use the new size.
+		*/
+		void setMapSize(size_t newValue);
+};
+
+LOG4CXX_PTR_DEF(MappedFileAppender);
+
+}
+}
+
+#endif
@@ -68,6 +68,11 @@ namespace rolling
  * automatic compression of the archived files. See
  * {@link TimeBasedRollingPolicy} for more details.
  *
+ * <p>Compression of an archived file is performed by a background thread,
+ * so the thread that triggers a rollover is not delayed.
+ * When the previous rollover's compression is still in progress,
+ * a FixedWindowRollingPolicy rollover moves the active file aside
+ * and renames the archived files on the background thread once that compression completes.
  *
  * Note: Do *not* set the option <code>Append</code> to <code>false</code>.
  * Rolling over files is only relevant when you are appending.
@@ -204,6 +204,7 @@ class LOG4CXX_EXPORT TimeBasedRollingPolicy : public virtual RollingPolicyBase,
 		Supported options | Supported values | Default value
 		:-------------- | :----------------: | :---------------:
 		ThrowIOExceptionOnForkFailure | True,False | True
+		CompressionLevel | -1,0-9 | -1
 
 		\sa RollingPolicyBase::setOption()
 		 */
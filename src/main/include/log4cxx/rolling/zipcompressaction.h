@@ -62,6 +62,17 @@ class ZipCompressAction : public Action
 		 */
 		void setThrowIOExceptionOnForkFailure(bool throwIO);
 
+		/**
+		 * Use \c level (0 stores without compression, 1 is fastest, 9 gives the smallest file) when compressing.
+		 * The default (-1) uses the zlib default level, which is currently 6.
+		 *
+		 * Has no effect when log4cxx is built without zlib,
+		 * in which case compression is performed by a <code>zip</code> process.
+		 *
+		 * @param level
+		 */
+		void setCompressionLevel(int level);
+
 	private:
 		ZipCompressAction(const ZipCompressAction&);
 		ZipCompressAction& operator=(const ZipCompressAction&);
@@ -0,0 +1,223 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _LOG4CXX_SPI_CALLSITE_H
+#define _LOG4CXX_SPI_CALLSITE_H
+
+#include <log4cxx/logger.h>
+#include <atomic>
+#include <cstdint>
+
+namespace LOG4CXX_NS
+{
+
+namespace spi
+{
+/**
+The enabled state of a logging request at one location in the source code.
+
+The state is computed when the request is first evaluated and
+reused until the configuration changes or a different logger is used.
+Any change to a logger level, a repository threshold or the repository configuration
+increments a process wide generation number which invalidates the state held by every CallSite.
+
+A CallSite can be enabled or disabled regardless of logger levels
+using #setEnabled.
+
+Use the LOG4CXX_SITE_XXXX macros (for example ::LOG4CXX_SITE_DEBUG)
+rather than this class.
+*/
+class LOG4CXX_EXPORT CallSite
+{
+	public:
+		/**
+		 * A logging request in \c fileName at \c lineNumber.
+		 * \c fileName must remain valid for the life of this object.
+		 */
+		constexpr CallSite(const char* fileName, int lineNumber)
+			: m_fileName(fileName)
+			, m_lineNumber(lineNumber)
+			, m_generation(nullptr)
+			, m_logger(nullptr)
+			, m_state(0)
+		{
+		}
+
+		/**
+		 * Is a request of level \c level using \c logger enabled at this location?
+		 *
+		 * The state is recomputed when \c logger differs from the logger of the previous call.
+		 */
+		bool isEnabled(const LoggerPtr& logger, int level)
+		{
+			auto state = m_state.load(std::memory_order_acquire);
+			auto cachedLogger = m_logger.load(std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_acquire);
+			auto generation = m_generation.load(std::memory_order_relaxed);
+			if (generation
+				&& cachedLogger == logger.get()
+				&& (state & ~(SequenceMask | Enabled)) == ((uint64_t)generation->load(std::memory_order_acquire) << GenerationShift | Valid)
+				&& state == m_state.load(std::memory_order_relaxed))
+				return 0 != (state & Enabled);
+			return refresh(logger, level);
+		}
+
+		/**
+		 * Invalidate the state held by every CallSite.
+		 *
+		 * Call this after any change that may alter whether a logging request is enabled.
+		 */
+		static void invalidateAll();
+
+		/**
+		 * Use \c enabled as the state of requests at \c lineNumber in \c fileName
+		 * regardless of logger levels.
+		 *
+		 * \c fileName may omit any number of leading directories.
+		 */
+		static void setEnabled(const std::string& fileName, int lineNumber, bool enabled);
+
+		/**
+		 * Use logger levels to determine the state of all requests.
+		 */
+		static void removeAllOverrides();
+
+	private:
+		enum : uint64_t
+		{ Enabled = 1
+		, Valid = 2
+		, Updating = 4 //!< Set while m_logger and m_state are being changed
+		, SequenceStep = 8
+		, SequenceMask = 0xFFFFFFF8 //!< Incremented by each change to m_logger and m_state
+		, GenerationShift = 32
+		};
+
+		/**
+		 * Compute and store the state of this location.
+		 */
+		bool refresh(const LoggerPtr& logger, int level);
+
+		const char* m_fileName;
+		int m_lineNumber;
+		/**
+		 * The number of changes that may have altered whether a logging request is enabled.
+		 * Held in the library, not this object, so it is shared by every module.
+		 */
+		std::atomic<const std::atomic<unsigned>*> m_generation;
+		std::atomic<const Logger*> m_logger; //!< The logger used to compute m_state
+		std::atomic<uint64_t> m_state; //!< The generation in the upper 32 bits plus sequence, Updating, Valid and Enabled bits
+};
+
+}  // namespace spi
+} // namespace log4cxx
+
+/** @addtogroup LoggingMacros Logging macros
+@{
+*/
+
+/**
+Add a new logging event containing \c message to attached appender(s)
+if requests at this location are enabled for \c level events.
+
+The enabled state is cached for this location
+and recomputed only after a configuration change
+or when \c logger differs from the logger used by the previous execution.
+
+@param logger the logger to be used.
+@param level the integer value of the logging event level, for example <code>Level::DEBUG_INT</code>.
+@param message a valid r-value expression of an <code>operator<<(std::ostream&. ...)</code> overload.
+*/
+#define LOG4CXX_SITE_LOG(logger, level, message) do { \
+		static ::LOG4CXX_NS::spi::CallSite site_(__FILE__, __LINE__); \
+		if (LOG4CXX_UNLIKELY(site_.isEnabled(logger, level))) {\
+			::LOG4CXX_NS::helpers::MessageBuffer oss_; \
+			logger->addEvent(::LOG4CXX_NS::Level::toLevel(level), oss_.extract_str(oss_ << message), LOG4CXX_LOCATION); }} while (0)
+
+#if !defined(LOG4CXX_THRESHOLD) || LOG4CXX_THRESHOLD <= 5000
+/**
+Add a new logging event containing \c message to attached appender(s)
+if requests at this location are enabled for <code>TRACE</code> events.
+See ::LOG4CXX_SITE_LOG.
+*/
+#define LOG4CXX_SITE_TRACE(logger, message) LOG4CXX_SITE_LOG(logger, ::LOG4CXX_NS::Level::TRACE_INT, message)
+#else
+#define LOG4CXX_SITE_TRACE(logger, message)
+#endif
+
+#if !defined(LOG4CXX_THRESHOLD) || LOG4CXX_THRESHOLD <= 10000
+/**
+Add a new logging event containing \c message to attached appender(s)
+if requests at this location are enabled for <code>DEBUG</code> events.
+See ::LOG4CXX_SITE_LOG.
+
+\usage
+~~~{.cpp}
+LOG4CXX_SITE_DEBUG(m_log, "AddMesh: name " << meshName);
+~~~
+*/
+#define LOG4CXX_SITE_DEBUG(logger, message) LOG4CXX_SITE_LOG(logger, ::LOG4CXX_NS::Level::DEBUG_INT, message)
+#else
+#define LOG4CXX_SITE_DEBUG(logger, message)
+#endif
+
+#if !defined(LOG4CXX_THRESHOLD) || LOG4CXX_THRESHOLD <= 20000
+/**
+Add a new logging event containing \c message to attached appender(s)
+if requests at this location are enabled for <code>INFO</code> events.
+See ::LOG4CXX_SITE_LOG.
+*/
+#define LOG4CXX_SITE_INFO(logger, message) LOG4CXX_SITE_LOG(logger, ::LOG4CXX_NS::Level::INFO_INT, message)
+#else
+#define LOG4CXX_SITE_INFO(logger, message)
+#endif
+
+#if !defined(LOG4CXX_THRESHOLD) || LOG4CXX_THRESHOLD <= 30000
+/**
+Add a new logging event containing \c message to attached appender(s)
+if requests at this location are enabled for <code>WARN</code> events.
+See ::LOG4CXX_SITE_LOG.
+*/
+#define LOG4CXX_SITE_WARN(logger, message) LOG4CXX_SITE_LOG(logger, ::LOG4CXX_NS::Level::WARN_INT, message)
+#else
+#define LOG4CXX_SITE_WARN(logger, message)
+#endif
+
+#if !defined(LOG4CXX_THRESHOLD) || LOG4CXX_THRESHOLD <= 40000
+/**
+Add a new logging event containing \c message to attached appender(s)
+if requests at this location are enabled for <code>ERROR</code> events.
+See ::LOG4CXX_SITE_LOG.
+*/
+#define LOG4CXX_SITE_ERROR(logger, message) LOG4CXX_SITE_LOG(logger, ::LOG4CXX_NS::Level::ERROR_INT, message)
+#else
+#define LOG4CXX_SITE_ERROR(logger, message)
+#endif
+
+#if !defined(LOG4CXX_THRESHOLD) || LOG4CXX_THRESHOLD <= 50000
+/**
+Add a new logging event containing \c message to attached appender(s)
+if requests at this location are enabled for <code>FATAL</code> events.
+See ::LOG4CXX_SITE_LOG.
+*/
+#define LOG4CXX_SITE_FATAL(logger, message) LOG4CXX_SITE_LOG(logger, ::LOG4CXX_NS::Level::FATAL_INT, message)
+#else
+#define LOG4CXX_SITE_FATAL(logger, message)
+#endif
+
+/**@}*/
+
+#endif //_LOG4CXX_SPI_CALLSITE_H
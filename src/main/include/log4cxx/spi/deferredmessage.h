@@ -0,0 +1,59 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef _LOG4CXX_SPI_DEFERRED_MESSAGE_H
+#define _LOG4CXX_SPI_DEFERRED_MESSAGE_H
+
+#include <log4cxx/logger.h>
+
+namespace LOG4CXX_NS
+{
+
+namespace spi
+{
+/**
+The values of a logging request from which the message text is produced
+when it is first required.
+
+A LoggingEvent holding a DeferredMessage produces the text
+when a filter, layout or appender first requests the message.
+When the event is forwarded by an AsyncAppender,
+this is normally done on the AsyncAppender's background thread.
+
+Instances are allocated using memory previously released by the current thread where possible.
+A derived class must not require more than the default new alignment.
+
+\sa ::LOG4CXX_DEFER_LOG_FMT
+*/
+class LOG4CXX_EXPORT DeferredMessage
+{
+	public:
+		virtual ~DeferredMessage();
+
+		/**
+		 * Append the message text to \c output.
+		 */
+		virtual void format(LogString& output) const = 0;
+
+		static void* operator new(std::size_t size);
+		static void operator delete(void* p, std::size_t size);
+};
+
+} // namespace spi
+} // namespace log4cxx
+
+#endif //_LOG4CXX_SPI_DEFERRED_MESSAGE_H
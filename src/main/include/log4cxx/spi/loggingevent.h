@@ -53,6 +53,11 @@ class LOG4CXX_EXPORT LoggingEvent :
 
 		typedef spi::KeySet KeySet;
 
+		/**
+		 * A logger name that is shared by the events of that logger.
+		 */
+		using LoggerNamePtr = std::shared_ptr<const LogString>;
+
 		/** An empty event.
 		*/
 		LoggingEvent();
@@ -75,6 +80,40 @@ class LOG4CXX_EXPORT LoggingEvent :
 		/**
 		An event composed using the supplied parameters.
 
+		The event refers to \c logger rather than holding a copy of the name.
+
+		@param logger The name of the logger used to make the logging request.
+		@param level The severity of this event.
+		@param location The source code location of the logging request.
+		@param message  The text to add to this event.
+		*/
+		LoggingEvent
+			( const LoggerNamePtr& logger
+			, const LevelPtr& level
+			, const LocationInfo& location
+			, LogString&& message
+			);
+
+		/**
+		An event composed using the supplied parameters.
+
+		The message text is produced by \c message when it is first required.
+
+		@param logger The name of the logger used to make the logging request.
+		@param level The severity of this event.
+		@param location The source code location of the logging request.
+		@param message  The values from which the message text is produced.
+		*/
+		LoggingEvent
+			( const LoggerNamePtr& logger
+			, const LevelPtr& level
+			, const LocationInfo& location
+			, DeferredMessageUniquePtr&& message
+			);
+
+		/**
+		An event composed using the supplied parameters.
+
 		@param logger The logger used to make the logging request.
 		@param level The severity of this event.
 		@param message  The text to add to this event.
@@ -87,6 +126,32 @@ class LOG4CXX_EXPORT LoggingEvent :
 			, const LocationInfo& location
 			);
 
+		/**
+		An event composed using previously captured values,
+		for example, when replaying an event that was saved to a file.
+
+		@param logger The logger used to make the logging request.
+		@param level The severity of this event.
+		@param location The source code location of the logging request.
+		@param message  The text to add to this event.
+		@param timeStamp The number of microseconds elapsed since 1970-01-01 when the request was made.
+		@param threadId The identifier of the thread that made the request.
+		@param threadName The name of the thread that made the request.
+		@param ndc The nested diagnostic context of the request, empty if there was none.
+		@param mdc The mapped diagnostic context of the request.
+		*/
+		LoggingEvent
+			( const LogString& logger
+			, const LevelPtr& level
+			, const LocationInfo& location
+			, LogString&& message
+			, log4cxx_time_t timeStamp
+			, const LogString& threadId
+			, const LogString& threadName
+			, const LogString& ndc
+			, const MDC::Map& mdc
+			);
+
 		~LoggingEvent();
 
 		/** The severity level of the logging request that generated this event. */
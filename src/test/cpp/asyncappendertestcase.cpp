@@ -33,6 +33,8 @@
 #include <log4cxx/spi/location/locationinfo.h>
 #include <log4cxx/xml/domconfigurator.h>
 #include <log4cxx/file.h>
+#include <log4cxx/mdc.h>
+#include <atomic>
 #include <thread>
 
 using namespace log4cxx;
@@ -126,8 +128,14 @@ class AsyncAppenderTestCase : public AppenderSkeletonTestCase
 		LOGUNIT_TEST(test2);
 		LOGUNIT_TEST(testEventFlush);
 		LOGUNIT_TEST(testMultiThread);
+		LOGUNIT_TEST(testMultiThreadSmallBuffer);
 		LOGUNIT_TEST(testBadAppender);
 		LOGUNIT_TEST(testBufferOverflowBehavior);
+		LOGUNIT_TEST(testOverflowPolicyDropOldest);
+		LOGUNIT_TEST(testOverflowPolicyDropBelowThreshold);
+		LOGUNIT_TEST(testOverflowPolicySpillToDisk);
+		LOGUNIT_TEST(testOverflowPolicySpillToDiskWithoutFile);
+		LOGUNIT_TEST(testDispatcherPerAppender);
 #if LOG4CXX_HAS_DOMCONFIGURATOR
 		LOGUNIT_TEST(testConfiguration);
 #endif
@@ -286,6 +294,53 @@ class AsyncAppenderTestCase : public AppenderSkeletonTestCase
 				LOGUNIT_ASSERT_EQUAL(msgCount[i], threadCount);
 		}
 
+		// this test checks messages from each thread are delivered in order when the buffer wraps frequently
+		void testMultiThreadSmallBuffer()
+		{
+			int LEN = 2000;
+			auto threadCount = std::max(static_cast<int>(std::thread::hardware_concurrency() - 1), 2);
+			auto root = Logger::getRootLogger();
+			auto vectorAppender = std::make_shared<VectorAppender>();
+			auto asyncAppender = std::make_shared<AsyncAppender>();
+			asyncAppender->setName(LOG4CXX_STR("async-testMultiThreadSmallBuffer"));
+			asyncAppender->setBufferSize(4);
+			asyncAppender->addAppender(vectorAppender);
+			root->addAppender(asyncAppender);
+
+			std::vector<std::thread> threads;
+			for ( int x = 0; x < threadCount; x++ )
+			{
+				threads.emplace_back([root, LEN]()
+				{
+					for (int i = 0; i < LEN; i++)
+					{
+						LOG4CXX_DEBUG(root, "message" << i);
+					}
+				});
+			}
+
+			for ( auto& thr : threads )
+			{
+				if ( thr.joinable() )
+				{
+					thr.join();
+				}
+			}
+			asyncAppender->close();
+
+			const std::vector<spi::LoggingEventPtr>& v = vectorAppender->getVector();
+			LOGUNIT_ASSERT_EQUAL(LEN*threadCount, (int)v.size());
+			std::map<LogString, int> perThreadCount;
+			for (auto m : v)
+			{
+				auto i = StringHelper::toInt(m->getMessage().substr(7));
+				auto& expected = perThreadCount[m->getThreadName()];
+				LOGUNIT_ASSERT_EQUAL(expected, i);
+				++expected;
+			}
+			LOGUNIT_ASSERT_EQUAL(threadCount, (int)perThreadCount.size());
+		}
+
 		/**
 		 * Checks that async will switch a bad appender to another appender.
 		 */
@@ -357,6 +412,241 @@ class AsyncAppenderTestCase : public AppenderSkeletonTestCase
 				discardEvent->getLocationInformation().getClassName());
 		}
 
+		/**
+		 * Checks the newest events are retained when using OverflowPolicy::DropOldest.
+		 */
+		void testOverflowPolicyDropOldest()
+		{
+			auto blockableAppender = std::make_shared<BlockableVectorAppender>();
+			auto async = std::make_shared<AsyncAppender>();
+			async->setName(LOG4CXX_STR("async-testOverflowPolicyDropOldest"));
+			async->addAppender(blockableAppender);
+			async->setBufferSize(5);
+			async->setOption(LOG4CXX_STR("OverflowPolicy"), LOG4CXX_STR("DropOldest"));
+			LOGUNIT_ASSERT(!async->getBlocking());
+			auto rootLogger = Logger::getRootLogger();
+			rootLogger->addAppender(async);
+			{
+				std::lock_guard<std::mutex> sync(blockableAppender->getBlocker());
+				for (int i = 0; i < 100; i++)
+				{
+					LOG4CXX_DEBUG(rootLogger, "message" << i);
+				}
+			}
+			async->close();
+			auto& events = blockableAppender->getVector();
+			LOGUNIT_ASSERT(!events.empty());
+			int lastMessage = -1;
+			bool haveDiscardEvent = false;
+			for (auto& event : events)
+			{
+				auto& msg = event->getMessage();
+				if (msg.substr(0, 10) == LOG4CXX_STR("Discarded "))
+					haveDiscardEvent = true;
+				else
+				{
+					auto i = StringHelper::toInt(msg.substr(7));
+					LOGUNIT_ASSERT(lastMessage < i);
+					lastMessage = i;
+				}
+			}
+			LOGUNIT_ASSERT(haveDiscardEvent);
+			LOGUNIT_ASSERT_EQUAL(99, lastMessage);
+		}
+
+		/**
+		 * Checks events at or above OverflowThreshold are not discarded when using OverflowPolicy::DropBelowThreshold.
+		 */
+		void testOverflowPolicyDropBelowThreshold()
+		{
+			auto blockableAppender = std::make_shared<BlockableVectorAppender>();
+			auto async = std::make_shared<AsyncAppender>();
+			async->setName(LOG4CXX_STR("async-testOverflowPolicyDropBelowThreshold"));
+			async->addAppender(blockableAppender);
+			async->setBufferSize(5);
+			async->setOption(LOG4CXX_STR("OverflowPolicy"), LOG4CXX_STR("DropBelowThreshold"));
+			async->setOption(LOG4CXX_STR("OverflowThreshold"), LOG4CXX_STR("ERROR"));
+			LOGUNIT_ASSERT_EQUAL(Level::getError(), async->getOverflowThreshold());
+			async->setOption(LOG4CXX_STR("OverflowThreshold"), LOG4CXX_STR("ALL"));
+			async->setOption(LOG4CXX_STR("OverflowThreshold"), LOG4CXX_STR("NotALevel"));
+			LOGUNIT_ASSERT_EQUAL(Level::getError(), async->getOverflowThreshold());
+			auto rootLogger = Logger::getRootLogger();
+			rootLogger->addAppender(async);
+			{
+				std::unique_lock<std::mutex> sync(blockableAppender->getBlocker());
+				std::atomic<int> loggedCount{0};
+				std::thread producer([&rootLogger, &loggedCount]()
+				{
+					for (int i = 0; i < 100; i++)
+					{
+						LOG4CXX_WARN(rootLogger, "message" << i);
+						LOG4CXX_ERROR(rootLogger, "message" << i);
+						++loggedCount;
+					}
+				});
+				// The producer waits once BufferSize events are held
+				std::this_thread::sleep_for( std::chrono::milliseconds( 200 ) );
+				LOGUNIT_ASSERT(loggedCount < 100);
+				sync.unlock();
+				producer.join();
+			}
+			async->close();
+			auto& events = blockableAppender->getVector();
+			int errorCount = 0;
+			int warnCount = 0;
+			bool haveDiscardEvent = false;
+			for (auto& event : events)
+			{
+				auto& msg = event->getMessage();
+				if (msg.substr(0, 10) == LOG4CXX_STR("Discarded "))
+					haveDiscardEvent = true;
+				else if (event->getLevel() == Level::getError())
+				{
+					LOGUNIT_ASSERT_EQUAL(errorCount, StringHelper::toInt(msg.substr(7)));
+					++errorCount;
+				}
+				else
+					++warnCount;
+			}
+			LOGUNIT_ASSERT(haveDiscardEvent);
+			LOGUNIT_ASSERT_EQUAL(100, errorCount);
+			LOGUNIT_ASSERT(warnCount < 100);
+		}
+
+		/**
+		 * Checks all events are delivered in order when using OverflowPolicy::SpillToDisk.
+		 */
+		void testOverflowPolicySpillToDisk()
+		{
+			LogString spillFile(LOG4CXX_STR("output/asyncappender.spill"));
+			auto blockableAppender = std::make_shared<BlockableVectorAppender>();
+			auto async = std::make_shared<AsyncAppender>();
+			async->setName(LOG4CXX_STR("async-testOverflowPolicySpillToDisk"));
+			async->addAppender(blockableAppender);
+			async->setBufferSize(5);
+			async->setOption(LOG4CXX_STR("OverflowPolicy"), LOG4CXX_STR("SpillToDisk"));
+			async->setOption(LOG4CXX_STR("SpillFile"), spillFile);
+			auto rootLogger = Logger::getRootLogger();
+			rootLogger->addAppender(async);
+			MDC::put(LOG4CXX_STR("key"), LOG4CXX_STR("value"));
+			{
+				std::lock_guard<std::mutex> sync(blockableAppender->getBlocker());
+				for (int i = 0; i < 100; i++)
+				{
+					LOG4CXX_WARN(rootLogger, "message" << i);
+				}
+			}
+			MDC::remove(LOG4CXX_STR("key"));
+			async->close();
+			auto& events = blockableAppender->getVector();
+			LOGUNIT_ASSERT_EQUAL((size_t) 100, events.size());
+			for (int i = 0; i < 100; i++)
+			{
+				auto& event = events[i];
+				LOGUNIT_ASSERT_EQUAL(i, StringHelper::toInt(event->getMessage().substr(7)));
+				LOGUNIT_ASSERT_EQUAL(Level::getWarn(), event->getLevel());
+				LOGUNIT_ASSERT_EQUAL(LogString(LOG4CXX_STR("root")), event->getLoggerName());
+				LogString value;
+				LOGUNIT_ASSERT(event->getMDC(LOG4CXX_STR("key"), value));
+				LOGUNIT_ASSERT_EQUAL(LogString(LOG4CXX_STR("value")), value);
+				LOGUNIT_ASSERT(0 < event->getLocationInformation().getLineNumber());
+				if (0 < i)
+					LOGUNIT_ASSERT(events[i - 1]->getTimeStamp() <= event->getTimeStamp());
+			}
+			Pool p;
+			LOGUNIT_ASSERT(!File(spillFile).exists(p));
+		}
+
+		/**
+		 * Checks logging threads wait, rather than holding events without limit,
+		 * when using OverflowPolicy::SpillToDisk without a SpillFile.
+		 */
+		void testOverflowPolicySpillToDiskWithoutFile()
+		{
+			auto blockableAppender = std::make_shared<BlockableVectorAppender>();
+			auto async = std::make_shared<AsyncAppender>();
+			async->setName(LOG4CXX_STR("async-testOverflowPolicySpillToDiskWithoutFile"));
+			async->addAppender(blockableAppender);
+			async->setBufferSize(5);
+			async->setOption(LOG4CXX_STR("OverflowPolicy"), LOG4CXX_STR("SpillToDisk"));
+			auto rootLogger = Logger::getRootLogger();
+			rootLogger->addAppender(async);
+			{
+				std::unique_lock<std::mutex> sync(blockableAppender->getBlocker());
+				std::atomic<int> loggedCount{0};
+				std::thread producer([&rootLogger, &loggedCount]()
+				{
+					for (int i = 0; i < 100; i++)
+					{
+						LOG4CXX_WARN(rootLogger, "message" << i);
+						++loggedCount;
+					}
+				});
+				// The producer waits once BufferSize events are held
+				std::this_thread::sleep_for( std::chrono::milliseconds( 200 ) );
+				LOGUNIT_ASSERT(loggedCount < 100);
+				sync.unlock();
+				producer.join();
+			}
+			async->close();
+			auto& events = blockableAppender->getVector();
+			LOGUNIT_ASSERT_EQUAL((size_t) 100, events.size());
+			for (int i = 0; i < 100; i++)
+				LOGUNIT_ASSERT_EQUAL(i, StringHelper::toInt(events[i]->getMessage().substr(7)));
+		}
+
+		/**
+		 * Checks a blocked appender does not delay other appenders when DispatcherPerAppender is set.
+		 */
+		void testDispatcherPerAppender()
+		{
+			auto blockableAppender = std::make_shared<BlockableVectorAppender>();
+			auto vectorAppender = std::make_shared<VectorAppender>();
+			auto async = std::make_shared<AsyncAppender>();
+			async->setName(LOG4CXX_STR("async-testDispatcherPerAppender"));
+			async->setOption(LOG4CXX_STR("DispatcherPerAppender"), LOG4CXX_STR("true"));
+			LOGUNIT_ASSERT(async->getDispatcherPerAppender());
+			async->addAppender(blockableAppender);
+			async->addAppender(vectorAppender);
+			size_t LEN = 200;
+			int BUFFER_SIZE = 10;
+			async->setBufferSize(BUFFER_SIZE);
+			auto rootLogger = Logger::getRootLogger();
+			rootLogger->addAppender(async);
+			std::thread producer;
+			size_t blockedCount = 0;
+			size_t unblockedCount = 0;
+			{
+				std::lock_guard<std::mutex> sync(blockableAppender->getBlocker());
+				producer = std::thread([rootLogger, LEN]()
+				{
+					for (size_t i = 0; i < LEN; i++)
+					{
+						LOG4CXX_DEBUG(rootLogger, "message" << i);
+					}
+				});
+				// The other appender receives at least the events the blocked appender's queue can hold
+				for (int retryCount = 0; vectorAppender->getVector().size() < (size_t) BUFFER_SIZE && retryCount < 1000; ++retryCount)
+					std::this_thread::sleep_for( std::chrono::milliseconds( 10 ) );
+				unblockedCount = vectorAppender->getVector().size();
+				blockedCount = blockableAppender->getVector().size();
+			}
+			producer.join();
+			LOGUNIT_ASSERT((size_t) BUFFER_SIZE <= unblockedCount);
+			LOGUNIT_ASSERT_EQUAL((size_t) 0, blockedCount);
+			async->close();
+			LOGUNIT_ASSERT_EQUAL(LEN, vectorAppender->getVector().size());
+			LOGUNIT_ASSERT_EQUAL(LEN, blockableAppender->getVector().size());
+			for (size_t i = 0; i < LEN; i++)
+			{
+				LogString m(LOG4CXX_STR("message"));
+				Pool p;
+				StringHelper::toString(i, p, m);
+				LOGUNIT_ASSERT(vectorAppender->getVector()[i]->getMessage() == m);
+				LOGUNIT_ASSERT(blockableAppender->getVector()[i]->getMessage() == m);
+			}
+		}
+
 #if LOG4CXX_HAS_DOMCONFIGURATOR
 		void testConfiguration()
 		{
@@ -0,0 +1,191 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Counts heap allocations per logging request.
+// Kept apart from benchmark.cpp because replacing the global operator new
+// would change the timing of every benchmark in the same executable.
+
+#include <log4cxx/logger.h>
+#include <log4cxx/logmanager.h>
+#include <log4cxx/patternlayout.h>
+#include <log4cxx/appenderskeleton.h>
+#include <log4cxx/writerappender.h>
+#include <log4cxx/helpers/writer.h>
+#include <log4cxx/asyncappender.h>
+#include "nullwriterappender.h"
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+using namespace log4cxx;
+
+/**
+ * The number of times operator new has been called in this process.
+ */
+static std::atomic<size_t> allocationCount{0};
+
+void* operator new(std::size_t size)
+{
+	allocationCount.fetch_add(1, std::memory_order_relaxed);
+	if (auto p = std::malloc(size ? size : 1))
+		return p;
+	throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+	std::free(p);
+}
+
+/**
+ * Discards the text formatted by a WriterAppender.
+ */
+class NullWriter : public helpers::Writer
+{
+public:
+	void close(helpers::Pool& /* p */) override {}
+	void flush(helpers::Pool& /* p */) override {}
+	void write(const LogString& /* str */, helpers::Pool& /* p */) override {}
+};
+
+class allocationCounter : public ::benchmark::Fixture
+{
+public: // Attributes
+	LoggerPtr m_logger = getLogger();
+	LoggerPtr m_writerLogger = getWriterLogger();
+	LoggerPtr m_asyncLogger = getAsyncLogger();
+
+public: // Class methods
+	static LoggerPtr getLogger()
+	{
+		static struct initializer
+		{
+			initializer()
+			{
+				auto r = LogManager::getLoggerRepository();
+				r->ensureIsConfigured([r]()
+					{
+					auto writer = std::make_shared<NullWriterAppender>(std::make_shared<PatternLayout>(LOG4CXX_STR("%m%n")));
+					writer->setName(LOG4CXX_STR("NullAppender"));
+					r->getRootLogger()->addAppender(writer);
+					});
+			}
+			~initializer() { LogManager::shutdown(); }
+		} x;
+		return LogManager::getLogger(LOG4CXX_STR("benchmark.allocations"));
+	}
+
+	static LoggerPtr getWriterLogger()
+	{
+		static struct initializer
+		{
+			LoggerPtr logger;
+			initializer()
+			{
+				getLogger();
+				logger = LogManager::getLogger(LOG4CXX_STR("benchmark.allocations.writer"));
+				auto writer = std::make_shared<WriterAppender>();
+				writer->setLayout(std::make_shared<PatternLayout>(LOG4CXX_STR("%m%n")));
+				writer->setName(LOG4CXX_STR("NullWriterAppender"));
+				writer->setWriter(std::make_shared<NullWriter>());
+				logger->addAppender(writer);
+				logger->setAdditivity(false);
+			}
+		} x;
+		return x.logger;
+	}
+
+	static LoggerPtr getAsyncLogger()
+	{
+		static struct initializer
+		{
+			LoggerPtr logger;
+			initializer()
+			{
+				getLogger();
+				logger = LogManager::getLogger(LOG4CXX_STR("benchmark.allocations.async"));
+				auto writer = std::make_shared<NullWriterAppender>(std::make_shared<PatternLayout>(LOG4CXX_STR("%m%n")));
+				writer->setName(LOG4CXX_STR("NullAppender.async"));
+				auto asyncAppender = std::make_shared<AsyncAppender>();
+				asyncAppender->setName(LOG4CXX_STR("AsyncAppender"));
+				asyncAppender->addAppender(writer);
+				logger->addAppender(asyncAppender);
+				logger->setAdditivity(false);
+			}
+		} x;
+		return x.logger;
+	}
+};
+
+BENCHMARK_DEFINE_F(allocationCounter, logShortString)(benchmark::State& state)
+{
+	m_logger->setLevel(Level::getInfo());
+	auto startCount = allocationCount.load();
+	for (auto _ : state)
+	{
+		LOG4CXX_INFO(m_logger, LOG4CXX_STR("Hello"));
+	}
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(allocationCount.load() - startCount), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK_REGISTER_F(allocationCounter, logShortString)->Name("Heap allocations appending 5 char string using MessageBuffer, pattern: %m%n");
+
+BENCHMARK_DEFINE_F(allocationCounter, logLongString)(benchmark::State& state)
+{
+	m_logger->setLevel(Level::getInfo());
+	auto startCount = allocationCount.load();
+	for (auto _ : state)
+	{
+		LOG4CXX_INFO(m_logger, LOG4CXX_STR("Hello: this is a long static string message"));
+	}
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(allocationCount.load() - startCount), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK_REGISTER_F(allocationCounter, logLongString)->Name("Heap allocations appending 49 char string using MessageBuffer, pattern: %m%n");
+
+BENCHMARK_DEFINE_F(allocationCounter, logLongStringToWriter)(benchmark::State& state)
+{
+	m_writerLogger->setLevel(Level::getInfo());
+	auto startCount = allocationCount.load();
+	for (auto _ : state)
+	{
+		LOG4CXX_INFO(m_writerLogger, LOG4CXX_STR("Hello: this is a long static string message"));
+	}
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(allocationCount.load() - startCount), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK_REGISTER_F(allocationCounter, logLongStringToWriter)->Name("Heap allocations appending 49 char string to a WriterAppender, pattern: %m%n");
+
+// Counts the allocations of both the logging thread and the AsyncAppender's thread.
+// Events are released on the AsyncAppender's thread, so their memory is recycled by that thread
+// and each event logged still allocates on the logging thread.
+BENCHMARK_DEFINE_F(allocationCounter, logLongStringToAsync)(benchmark::State& state)
+{
+	m_asyncLogger->setLevel(Level::getInfo());
+	auto startCount = allocationCount.load();
+	for (auto _ : state)
+	{
+		LOG4CXX_INFO(m_asyncLogger, LOG4CXX_STR("Hello: this is a long static string message"));
+	}
+	state.counters["allocations"] = benchmark::Counter(static_cast<double>(allocationCount.load() - startCount), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK_REGISTER_F(allocationCounter, logLongStringToAsync)->Name("Heap allocations on all threads appending 49 char string through an AsyncAppender (events are not recycled across threads), pattern: %m%n");
+
+BENCHMARK_MAIN();
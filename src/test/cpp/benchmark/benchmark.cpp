@@ -1,22 +1,36 @@
 #include <log4cxx/logger.h>
+#include <log4cxx/spi/callsite.h>
 #include <log4cxx/logmanager.h>
 #include <log4cxx/patternlayout.h>
+#include <log4cxx/jsonlayout.h>
+#include <log4cxx/htmllayout.h>
+#include <log4cxx/xml/xmllayout.h>
+#if LOG4CXX_HAS_FMT_LAYOUT
+#include <log4cxx/fmtlayout.h>
+#endif
 #include <log4cxx/appenderskeleton.h>
 #include <log4cxx/helpers/optionconverter.h>
 #include <log4cxx/helpers/stringhelper.h>
+#include <log4cxx/helpers/transcoder.h>
+#include <log4cxx/helpers/charsetencoder.h>
+#include <log4cxx/helpers/bytebuffer.h>
 #include <log4cxx/asyncappender.h>
 #include <log4cxx/net/smtpappender.h>
 #include <log4cxx/fileappender.h>
+#include <log4cxx/rolling/mappedfileappender.h>
 #if LOG4CXX_HAS_MULTIPROCESS_ROLLING_FILE_APPENDER
 #include <log4cxx/rolling/multiprocessrollingfileappender.h>
 #include <log4cxx/rolling/timebasedrollingpolicy.h>
 #endif
-#include <log4cxx/private/appenderskeleton_priv.h>
+#include "nullwriterappender.h"
 #if LOG4CXX_USING_STD_FORMAT
 #include <format>
 #elif LOG4CXX_HAS_FMT
 #include <fmt/format.h>
 #endif
+#if LOG4CXX_USING_STD_FORMAT || LOG4CXX_HAS_FMT
+#include <log4cxx/deferredformat.h>
+#endif
 #include <benchmark/benchmark.h>
 #include <thread>
 #include <cstdlib>
@@ -24,36 +38,6 @@
 
 using namespace log4cxx;
 
-class NullWriterAppender : public AppenderSkeleton
-{
-public:
-	NullWriterAppender(const LayoutPtr& layout)
-	{
-		setLayout(layout);
-	}
-
-	void close() override {}
-
-	bool requiresLayout() const override
-	{
-		return true;
-	}
-
-	void append(const spi::LoggingEventPtr& event, helpers::Pool& p) override
-	{
-		LogString buf;
-		m_priv->layout->format(buf, event, p);
-	}
-
-	void activateOptions(helpers::Pool& /* pool */) override
-	{
-	}
-
-	void setOption(const LogString& option, const LogString& value) override
-	{
-	}
-};
-
 class BenchmarkFileAppender : public FileAppender
 {
 public:
@@ -100,6 +84,8 @@ public: // Attributes
 	LoggerPtr m_logger = getLogger();
 	LoggerPtr m_asyncLogger = getAsyncLogger();
 	LoggerPtr m_fileLogger = getFileLogger();
+	LoggerPtr m_groupCommitLogger = getGroupCommitLogger();
+	LoggerPtr m_mappedFileLogger = getMappedFileLogger();
 #if LOG4CXX_HAS_MULTIPROCESS_ROLLING_FILE_APPENDER
 	LoggerPtr m_multiprocessLogger = getMultiprocessLogger();
 #endif
@@ -161,6 +147,54 @@ public: // Class methods
 		return result;
 	}
 
+#if LOG4CXX_HAS_FMT_LAYOUT
+	static LoggerPtr getFMTLayoutLogger(const LogString& pattern)
+	{
+		getLogger();
+		LogString name = LOG4CXX_STR("benchmark.fixture.fmt.") + pattern;
+		auto r = LogManager::getLoggerRepository();
+		LoggerPtr result;
+		if (!(result = r->exists(name)))
+		{
+			result = r->getLogger(name);
+			result->setAdditivity(false);
+			result->setLevel(Level::getInfo());
+			auto writer = std::make_shared<NullWriterAppender>(std::make_shared<FMTLayout>(pattern));
+			writer->setName(LOG4CXX_STR("NullAppender.fmt.") + pattern);
+			result->addAppender(writer);
+		}
+		return result;
+	}
+#endif
+
+	/**
+	 * A logger that formats events using \c layoutName (JSON, XML or HTML).
+	 */
+	static LoggerPtr getStructuredLayoutLogger(const LogString& layoutName)
+	{
+		getLogger();
+		LogString name = LOG4CXX_STR("benchmark.fixture.layout.") + layoutName;
+		auto r = LogManager::getLoggerRepository();
+		LoggerPtr result;
+		if (!(result = r->exists(name)))
+		{
+			LayoutPtr layout;
+			if (layoutName == LOG4CXX_STR("JSON"))
+				layout = std::make_shared<JSONLayout>();
+			else if (layoutName == LOG4CXX_STR("XML"))
+				layout = std::make_shared<xml::XMLLayout>();
+			else
+				layout = std::make_shared<HTMLLayout>();
+			result = r->getLogger(name);
+			result->setAdditivity(false);
+			result->setLevel(Level::getInfo());
+			auto writer = std::make_shared<NullWriterAppender>(layout);
+			writer->setName(LOG4CXX_STR("NullAppender.layout.") + layoutName);
+			result->addAppender(writer);
+		}
+		return result;
+	}
+
 	static LoggerPtr getAsyncLogger()
 	{
 		LogString name = LOG4CXX_STR("benchmark.fixture.async");
@@ -202,6 +236,54 @@ public: // Class methods
 		return result;
 	}
 
+	static LoggerPtr getGroupCommitLogger()
+	{
+		LogString name = LOG4CXX_STR("benchmark.fixture.groupcommit");
+		auto r = LogManager::getLoggerRepository();
+		LoggerPtr result;
+		if (!(result = r->exists(name)))
+		{
+			result = r->getLogger(name);
+			result->setAdditivity(false);
+			result->setLevel(Level::getInfo());
+			auto tempDir = helpers::OptionConverter::getSystemProperty(LOG4CXX_STR("TEMP"), LOG4CXX_STR("/tmp"));
+			auto writer = std::make_shared<FileAppender>();
+			writer->setName(LOG4CXX_STR("GroupCommitFileAppender"));
+			writer->setLayout(std::make_shared<PatternLayout>(LOG4CXX_STR("%d %m%n")));
+			writer->setFile(tempDir + LOG4CXX_STR("/") + LOG4CXX_STR("groupcommit.log"));
+			writer->setAppend(false);
+			writer->setGroupCommitMilliseconds(10);
+			helpers::Pool p;
+			writer->activateOptions(p);
+			result->addAppender(writer);
+		}
+		return result;
+	}
+
+	static LoggerPtr getMappedFileLogger()
+	{
+		LogString name = LOG4CXX_STR("benchmark.fixture.mapped");
+		auto r = LogManager::getLoggerRepository();
+		LoggerPtr result;
+		if (!(result = r->exists(name)))
+		{
+			result = r->getLogger(name);
+			result->setAdditivity(false);
+			result->setLevel(Level::getInfo());
+			auto tempDir = helpers::OptionConverter::getSystemProperty(LOG4CXX_STR("TEMP"), LOG4CXX_STR("/tmp"));
+			auto writer = std::make_shared<rolling::MappedFileAppender>();
+			writer->setName(LOG4CXX_STR("MappedFileAppender"));
+			writer->setLayout(std::make_shared<PatternLayout>(LOG4CXX_STR("%d %m%n")));
+			writer->setFile(tempDir + LOG4CXX_STR("/") + LOG4CXX_STR("mapped.log"));
+			writer->setAppend(false);
+			writer->setMaximumFileSize(100 * 1024 * 1024);
+			helpers::Pool p;
+			writer->activateOptions(p);
+			result->addAppender(writer);
+		}
+		return result;
+	}
+
 #if LOG4CXX_HAS_MULTIPROCESS_ROLLING_FILE_APPENDER
 	static LoggerPtr getMultiprocessLogger()
 	{
@@ -235,6 +317,83 @@ BENCHMARK_DEFINE_F(benchmarker, logDisabledTrace)(benchmark::State& state)
 BENCHMARK_REGISTER_F(benchmarker, logDisabledTrace)->Name("Testing disabled logging request")->MinWarmUpTime(benchmarker::warmUpSeconds());
 BENCHMARK_REGISTER_F(benchmarker, logDisabledTrace)->Name("Testing disabled logging request")->Threads(benchmarker::threadCount());
 
+BENCHMARK_DEFINE_F(benchmarker, logDisabledTraceCallSite)(benchmark::State& state)
+{
+	m_logger->setLevel(Level::getDebug());
+	for (auto _ : state)
+	{
+		LOG4CXX_SITE_TRACE( m_logger, LOG4CXX_STR("Hello: static string message"));
+	}
+}
+BENCHMARK_REGISTER_F(benchmarker, logDisabledTraceCallSite)->Name("Testing disabled logging request using LOG4CXX_SITE_TRACE");
+BENCHMARK_REGISTER_F(benchmarker, logDisabledTraceCallSite)->Name("Testing disabled logging request using LOG4CXX_SITE_TRACE")->Threads(benchmarker::threadCount());
+
+BENCHMARK_DEFINE_F(benchmarker, getExistingLogger)(benchmark::State& state)
+{
+	auto r = LogManager::getLoggerRepository();
+	LogString name = LOG4CXX_STR("benchmark.fixture");
+	for (auto _ : state)
+	{
+		auto logger = r->getLogger(name);
+		benchmark::DoNotOptimize(logger);
+	}
+}
+BENCHMARK_REGISTER_F(benchmarker, getExistingLogger)->Name("Retrieving an existing logger using LoggerRepository::getLogger");
+BENCHMARK_REGISTER_F(benchmarker, getExistingLogger)->Name("Retrieving an existing logger using LoggerRepository::getLogger")->Threads(benchmarker::threadCount());
+
+#if LOG4CXX_WCHAR_T_API
+BENCHMARK_DEFINE_F(benchmarker, decodeWideString)(benchmark::State& state)
+{
+	std::wstring text(state.range(0), L'x');
+	for (auto _ : state)
+	{
+		LogString decoded;
+		helpers::Transcoder::decode(text, decoded);
+		benchmark::DoNotOptimize(decoded);
+	}
+}
+BENCHMARK_REGISTER_F(benchmarker, decodeWideString)->Name("Transcoding std::wstring to LogString")->Arg(16)->Arg(256);
+
+BENCHMARK_DEFINE_F(benchmarker, encodeWideString)(benchmark::State& state)
+{
+	LogString text(state.range(0), 0x78 /* x */);
+	for (auto _ : state)
+	{
+		std::wstring encoded;
+		helpers::Transcoder::encode(text, encoded);
+		benchmark::DoNotOptimize(encoded);
+	}
+}
+BENCHMARK_REGISTER_F(benchmarker, encodeWideString)->Name("Transcoding LogString to std::wstring")->Arg(16)->Arg(256);
+#endif
+
+BENCHMARK_DEFINE_F(benchmarker, decodeUTF8)(benchmark::State& state)
+{
+	std::string text(state.range(0), 'x');
+	for (auto _ : state)
+	{
+		LogString decoded;
+		helpers::Transcoder::decodeUTF8(text, decoded);
+		benchmark::DoNotOptimize(decoded);
+	}
+}
+BENCHMARK_REGISTER_F(benchmarker, decodeUTF8)->Name("Transcoding UTF-8 std::string to LogString")->Arg(16)->Arg(256);
+
+BENCHMARK_DEFINE_F(benchmarker, encodeLatin1)(benchmark::State& state)
+{
+	auto encoder = helpers::CharsetEncoder::getEncoder(LOG4CXX_STR("ISO-8859-1"));
+	LogString text(state.range(0), 0x78 /* x */);
+	std::vector<char> buf(text.size());
+	for (auto _ : state)
+	{
+		helpers::ByteBuffer out(buf.data(), buf.size());
+		auto iter = text.cbegin();
+		encoder->encode(text, iter, out);
+		benchmark::DoNotOptimize(buf.data());
+	}
+}
+BENCHMARK_REGISTER_F(benchmarker, encodeLatin1)->Name("Encoding LogString to ISO-8859-1 using CharsetEncoder")->Arg(16)->Arg(256);
+
 BENCHMARK_DEFINE_F(benchmarker, logShortString)(benchmark::State& state)
 {
 	m_logger->setLevel(Level::getInfo());
@@ -296,6 +455,48 @@ void logWithConversionPattern(benchmark::State& state, Args&&... args)
 BENCHMARK_CAPTURE(logWithConversionPattern, DateMessage, LOG4CXX_STR("[%d] %m%n"))->Name("Appending int value using MessageBuffer, pattern: [%d] %m%n");
 BENCHMARK_CAPTURE(logWithConversionPattern, DateClassLevelMessage, LOG4CXX_STR("[%d] [%c] [%p] %m%n"))->Name("Appending int value using MessageBuffer, pattern: [%d] [%c] [%p] %m%n");
 
+#if LOG4CXX_HAS_FMT_LAYOUT
+template <class ...Args>
+void logWithFMTLayout(benchmark::State& state, Args&&... args)
+{
+	auto args_tuple = std::make_tuple(std::move(args)...);
+	LogString conversionPattern = std::get<0>(args_tuple);
+	auto logger = benchmarker::getFMTLayoutLogger(conversionPattern);
+	int x = 0;
+	for (auto _ : state)
+	{
+		LOG4CXX_INFO( logger, LOG4CXX_STR("Hello: msg number ") << ++x);
+	}
+}
+BENCHMARK_CAPTURE(logWithFMTLayout, DateClassLevelMessage, LOG4CXX_STR("[{d}] [{c}] [{p}] {m}{n}"))->Name("Appending int value using MessageBuffer, FMTLayout: [{d}] [{c}] [{p}] {m}{n}");
+#endif
+
+template <class ...Args>
+void logWithStructuredLayout(benchmark::State& state, Args&&... args)
+{
+	auto args_tuple = std::make_tuple(std::move(args)...);
+	LogString layoutName = std::get<0>(args_tuple);
+	LogString message = std::get<1>(args_tuple);
+	auto logger = benchmarker::getStructuredLayoutLogger(layoutName);
+	for (auto _ : state)
+	{
+		LOG4CXX_INFO( logger, message);
+	}
+}
+#define LOG4CXX_BENCHMARK_PLAIN_TEXT \
+	LOG4CXX_STR("The quick brown fox jumps over the lazy dog while the five boxing wizards jump quickly. ") \
+	LOG4CXX_STR("Pack my box with five dozen liquor jugs; how vexingly quick daft zebras jump, and then sleep.")
+#define LOG4CXX_BENCHMARK_MARKUP_TEXT \
+	LOG4CXX_STR("<a href=\"x\">\"A\" & \\B\\</a>]]>\t<b>\"C\" & \\D\\</b>]]>\n") \
+	LOG4CXX_STR("<a href=\"y\">\"E\" & \\F\\</a>]]>\t<b>\"G\" & \\H\\</b>]]>\n") \
+	LOG4CXX_STR("<a href=\"z\">\"I\" & \\J\\</a>]]>\t")
+BENCHMARK_CAPTURE(logWithStructuredLayout, JSONPlain, LOG4CXX_STR("JSON"), LOG4CXX_BENCHMARK_PLAIN_TEXT)->Name("Appending long string without special characters, JSONLayout");
+BENCHMARK_CAPTURE(logWithStructuredLayout, JSONMarkup, LOG4CXX_STR("JSON"), LOG4CXX_BENCHMARK_MARKUP_TEXT)->Name("Appending long string with frequent special characters, JSONLayout");
+BENCHMARK_CAPTURE(logWithStructuredLayout, XMLPlain, LOG4CXX_STR("XML"), LOG4CXX_BENCHMARK_PLAIN_TEXT)->Name("Appending long string without special characters, XMLLayout");
+BENCHMARK_CAPTURE(logWithStructuredLayout, XMLMarkup, LOG4CXX_STR("XML"), LOG4CXX_BENCHMARK_MARKUP_TEXT)->Name("Appending long string with frequent special characters, XMLLayout");
+BENCHMARK_CAPTURE(logWithStructuredLayout, HTMLPlain, LOG4CXX_STR("HTML"), LOG4CXX_BENCHMARK_PLAIN_TEXT)->Name("Appending long string without special characters, HTMLLayout");
+BENCHMARK_CAPTURE(logWithStructuredLayout, HTMLMarkup, LOG4CXX_STR("HTML"), LOG4CXX_BENCHMARK_MARKUP_TEXT)->Name("Appending long string with frequent special characters, HTMLLayout");
+
 #if  LOG4CXX_USING_STD_FORMAT || LOG4CXX_HAS_FMT
 BENCHMARK_DEFINE_F(benchmarker, logLongStringFMT)(benchmark::State& state)
 {
@@ -344,6 +545,32 @@ BENCHMARK_DEFINE_F(benchmarker, asyncIntPlusFloatValueMessageBuffer)(benchmark::
 BENCHMARK_REGISTER_F(benchmarker, asyncIntPlusFloatValueMessageBuffer)->Name("Async, Sending int+float using MessageBuffer");
 BENCHMARK_REGISTER_F(benchmarker, asyncIntPlusFloatValueMessageBuffer)->Name("Async, Sending int+float using MessageBuffer")->Threads(benchmarker::threadCount());
 
+#if  LOG4CXX_USING_STD_FORMAT || LOG4CXX_HAS_FMT
+BENCHMARK_DEFINE_F(benchmarker, asyncIntPlusFloatValueFMT)(benchmark::State& state)
+{
+	int x = 0;
+	for (auto _ : state)
+	{
+		auto f = static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+		LOG4CXX_INFO_FMT(m_asyncLogger, "Hello: msg number {} pseudo-random float {:.3f}", ++x, f);
+	}
+}
+BENCHMARK_REGISTER_F(benchmarker, asyncIntPlusFloatValueFMT)->Name("Async, Sending int+float using FMT");
+BENCHMARK_REGISTER_F(benchmarker, asyncIntPlusFloatValueFMT)->Name("Async, Sending int+float using FMT")->Threads(benchmarker::threadCount());
+
+BENCHMARK_DEFINE_F(benchmarker, asyncIntPlusFloatValueDeferredFMT)(benchmark::State& state)
+{
+	int x = 0;
+	for (auto _ : state)
+	{
+		auto f = static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+		LOG4CXX_DEFER_INFO_FMT(m_asyncLogger, "Hello: msg number {} pseudo-random float {:.3f}", ++x, f);
+	}
+}
+BENCHMARK_REGISTER_F(benchmarker, asyncIntPlusFloatValueDeferredFMT)->Name("Async, Sending int+float using deferred FMT");
+BENCHMARK_REGISTER_F(benchmarker, asyncIntPlusFloatValueDeferredFMT)->Name("Async, Sending int+float using deferred FMT")->Threads(benchmarker::threadCount());
+#endif
+
 BENCHMARK_DEFINE_F(benchmarker, fileIntPlusFloatValueMessageBuffer)(benchmark::State& state)
 {
 	int x = 0;
@@ -357,6 +584,32 @@ BENCHMARK_DEFINE_F(benchmarker, fileIntPlusFloatValueMessageBuffer)(benchmark::S
 BENCHMARK_REGISTER_F(benchmarker, fileIntPlusFloatValueMessageBuffer)->Name("Logging int+float using MessageBuffer, pattern: %d %m%n");
 BENCHMARK_REGISTER_F(benchmarker, fileIntPlusFloatValueMessageBuffer)->Name("Logging int+float using MessageBuffer, pattern: %d %m%n")->Threads(benchmarker::threadCount());
 
+BENCHMARK_DEFINE_F(benchmarker, groupCommitFileIntPlusFloatValueMessageBuffer)(benchmark::State& state)
+{
+	int x = 0;
+	for (auto _ : state)
+	{
+		auto f = static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+		LOG4CXX_INFO( m_groupCommitLogger, "Hello: message number " << ++x
+			<< " pseudo-random float " << std::setprecision(3) << std::fixed << f);
+	}
+}
+BENCHMARK_REGISTER_F(benchmarker, groupCommitFileIntPlusFloatValueMessageBuffer)->Name("Logging int+float using MessageBuffer and GroupCommitMilliseconds=10, pattern: %d %m%n");
+BENCHMARK_REGISTER_F(benchmarker, groupCommitFileIntPlusFloatValueMessageBuffer)->Name("Logging int+float using MessageBuffer and GroupCommitMilliseconds=10, pattern: %d %m%n")->Threads(benchmarker::threadCount());
+
+BENCHMARK_DEFINE_F(benchmarker, mappedFileIntPlusFloatValueMessageBuffer)(benchmark::State& state)
+{
+	int x = 0;
+	for (auto _ : state)
+	{
+		auto f = static_cast<float>(rand()) / static_cast<float>(RAND_MAX);
+		LOG4CXX_INFO( m_mappedFileLogger, "Hello: message number " << ++x
+			<< " pseudo-random float " << std::setprecision(3) << std::fixed << f);
+	}
+}
+BENCHMARK_REGISTER_F(benchmarker, mappedFileIntPlusFloatValueMessageBuffer)->Name("Logging int+float using MessageBuffer and MappedFileAppender, pattern: %d %m%n");
+BENCHMARK_REGISTER_F(benchmarker, mappedFileIntPlusFloatValueMessageBuffer)->Name("Logging int+float using MessageBuffer and MappedFileAppender, pattern: %d %m%n")->Threads(benchmarker::threadCount());
+
 #if LOG4CXX_HAS_MULTIPROCESS_ROLLING_FILE_APPENDER
 BENCHMARK_DEFINE_F(benchmarker, multiprocessFileIntPlusFloatValueMessageBuffer)(benchmark::State& state)
 {
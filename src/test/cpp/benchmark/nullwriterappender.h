@@ -0,0 +1,62 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#if !defined(_LOG4CXX_BENCHMARK_NULLWRITERAPPENDER_H)
+#define _LOG4CXX_BENCHMARK_NULLWRITERAPPENDER_H
+
+#include <log4cxx/appenderskeleton.h>
+#include <log4cxx/private/appenderskeleton_priv.h>
+
+namespace LOG4CXX_NS
+{
+
+/**
+ * Formats each logging event using the layout and discards the text.
+ */
+class NullWriterAppender : public AppenderSkeleton
+{
+public:
+	NullWriterAppender(const LayoutPtr& layout)
+	{
+		setLayout(layout);
+	}
+
+	void close() override {}
+
+	bool requiresLayout() const override
+	{
+		return true;
+	}
+
+	void append(const spi::LoggingEventPtr& event, helpers::Pool& p) override
+	{
+		LogString buf;
+		m_priv->layout->format(buf, event, p);
+	}
+
+	void activateOptions(helpers::Pool& /* pool */) override
+	{
+	}
+
+	void setOption(const LogString& option, const LogString& value) override
+	{
+	}
+};
+
+} // namespace log4cxx
+
+#endif //_LOG4CXX_BENCHMARK_NULLWRITERAPPENDER_H
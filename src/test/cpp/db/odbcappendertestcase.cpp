@@ -25,6 +25,13 @@
 #include <log4cxx/private/log4cxx_private.h>
 
 #ifdef LOG4CXX_HAVE_ODBC
+#if defined(WIN32) || defined(_WIN32)
+	#include <windows.h>
+#endif
+#include <sqlext.h>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
 
 using namespace log4cxx;
 
@@ -39,6 +46,9 @@ class ODBCAppenderTestCase : public AppenderSkeletonTestCase
 		//
 		LOGUNIT_TEST(testDefaultThreshold);
 		LOGUNIT_TEST(testSetOptionThreshold);
+		LOGUNIT_TEST(testSetOptionBackgroundFlush);
+		LOGUNIT_TEST(testInsertMultipleChunks);
+		LOGUNIT_TEST(testBackgroundFlushInsertsAll);
 		//LOGUNIT_TEST(testConnectUsingDSN);
 		LOGUNIT_TEST_SUITE_END();
 
@@ -50,6 +60,191 @@ class ODBCAppenderTestCase : public AppenderSkeletonTestCase
 			return new db::ODBCAppender();
 		}
 
+		void testSetOptionBackgroundFlush()
+		{
+			db::ODBCAppender appender;
+			LOGUNIT_ASSERT(!appender.getBackgroundFlush());
+			appender.setOption(LOG4CXX_STR("BackgroundFlush"), LOG4CXX_STR("true"));
+			LOGUNIT_ASSERT(appender.getBackgroundFlush());
+		}
+
+		/**
+		 * Execute each of \c statements using a separate connection to the data source \c dsn,
+		 * returning the first column of the last result in \c result.
+		 * Returns false when the data source is not available.
+		 */
+		static bool executeDirect(const char* dsn, const std::vector<std::string>& statements, SQLINTEGER* result = nullptr)
+		{
+			SQLHENV env = SQL_NULL_HENV;
+			SQLHDBC con = SQL_NULL_HDBC;
+			SQLHSTMT stmt = SQL_NULL_HSTMT;
+			bool ok = SQL_SUCCEEDED(SQLAllocHandle(SQL_HANDLE_ENV, SQL_NULL_HANDLE, &env))
+				&& SQL_SUCCEEDED(SQLSetEnvAttr(env, SQL_ATTR_ODBC_VERSION, (SQLPOINTER) SQL_OV_ODBC3, SQL_IS_INTEGER))
+				&& SQL_SUCCEEDED(SQLAllocHandle(SQL_HANDLE_DBC, env, &con))
+				&& SQL_SUCCEEDED(SQLConnectA(con, (SQLCHAR*)dsn, SQL_NTS, nullptr, 0, nullptr, 0));
+			if (ok)
+			{
+				ok = SQL_SUCCEEDED(SQLAllocHandle(SQL_HANDLE_STMT, con, &stmt));
+				for (auto& sql : statements)
+				{
+					if (ok)
+						ok = SQL_SUCCEEDED(SQLExecDirectA(stmt, (SQLCHAR*)sql.c_str(), SQL_NTS));
+				}
+				if (ok && result)
+				{
+					SQLLEN ind = 0;
+					ok = SQL_SUCCEEDED(SQLFetch(stmt))
+						&& SQL_SUCCEEDED(SQLGetData(stmt, 1, SQL_C_SLONG, result, 0, &ind));
+				}
+				if (stmt != SQL_NULL_HSTMT)
+					SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+				SQLDisconnect(con);
+			}
+			if (con != SQL_NULL_HDBC)
+				SQLFreeHandle(SQL_HANDLE_DBC, con);
+			if (env != SQL_NULL_HENV)
+				SQLFreeHandle(SQL_HANDLE_ENV, env);
+			return ok;
+		}
+
+#if !defined(WIN32) && !defined(_WIN32)
+		/**
+		 * The SQLite3 ODBC data source 'Log4cxxSQLite' containing an empty 'UnitTestLog' table,
+		 * defined using ODBCINI for the life of this object.
+		 */
+		struct SQLiteDataSource
+		{
+			const char* dsn = "Log4cxxSQLite";
+			bool hadPreviousIni;
+			std::string previousIni;
+
+			SQLiteDataSource()
+			{
+				auto current = ::getenv("ODBCINI");
+				hadPreviousIni = current != nullptr;
+				if (current)
+					previousIni = current;
+				std::ofstream ini("output/odbc.ini", std::ios::trunc);
+				ini << "[Log4cxxSQLite]\n"
+					<< "Driver = SQLite3\n"
+					<< "Database = output/odbcappender.db\n";
+				ini.close();
+				::setenv("ODBCINI", "output/odbc.ini", 1);
+			}
+
+			~SQLiteDataSource()
+			{
+				if (hadPreviousIni)
+					::setenv("ODBCINI", previousIni.c_str(), 1);
+				else
+					::unsetenv("ODBCINI");
+			}
+
+			/**
+			 * Returns false when the SQLite3 ODBC driver is not available.
+			 */
+			bool createTable() const
+			{
+				return executeDirect(dsn,
+					{ "DROP TABLE IF EXISTS UnitTestLog"
+					, "CREATE TABLE UnitTestLog (LogName VARCHAR(50), Message VARCHAR(200))"
+					});
+			}
+
+			SQLINTEGER rowCount() const
+			{
+				SQLINTEGER result = -1;
+				executeDirect(dsn, { "SELECT COUNT(*) FROM UnitTestLog" }, &result);
+				return result;
+			}
+
+			std::shared_ptr<db::ODBCAppender> createAppender(size_t bufferSize, bool backgroundFlush) const
+			{
+				auto appender = std::make_shared<db::ODBCAppender>();
+				appender->setURL(LOG4CXX_STR("Log4cxxSQLite"));
+				appender->setSql(LOG4CXX_STR("INSERT INTO UnitTestLog (LogName, Message) VALUES (?,?)"));
+				appender->setOption(LOG4CXX_STR("ColumnMapping"), LOG4CXX_STR("logger"));
+				appender->setOption(LOG4CXX_STR("ColumnMapping"), LOG4CXX_STR("message"));
+				appender->setBufferSize(bufferSize);
+				appender->setBackgroundFlush(backgroundFlush);
+				helpers::Pool p;
+				appender->activateOptions(p);
+				return appender;
+			}
+		};
+#endif
+
+		/**
+		 * Check every logging event is inserted
+		 * when a flush requires more than one execution of the prepared statement.
+		 *
+		 * Requires the unixODBC driver manager and the SQLite3 ODBC driver.
+		 */
+		void testInsertMultipleChunks()
+		{
+#if defined(WIN32) || defined(_WIN32)
+			std::cout << "testInsertMultipleChunks skipped: requires unixODBC" << std::endl;
+#else
+			SQLiteDataSource dataSource;
+			if (!dataSource.createTable())
+			{
+				std::cout << "testInsertMultipleChunks skipped: the SQLite3 ODBC driver is not available" << std::endl;
+				return;
+			}
+
+			auto appender = dataSource.createAppender(10, false);
+			auto logger = Logger::getLogger(LOG4CXX_STR("DB.SQLite"));
+			logger->setAdditivity(false);
+			logger->addAppender(appender);
+
+			// The first flush prepares a statement that inserts 10 rows per execution
+			for (int i = 0; i < 10; ++i)
+				LOG4CXX_INFO(logger, "Message '" << i << "'");
+
+			// This flush requires three executions: 10, 10 and 5 rows
+			appender->setBufferSize(25);
+			for (int i = 10; i < 35; ++i)
+				LOG4CXX_INFO(logger, "Message '" << i << "'");
+			logger->removeAppender(appender);
+			appender->close();
+
+			LOGUNIT_ASSERT_EQUAL(SQLINTEGER(35), dataSource.rowCount());
+#endif
+		}
+
+		/**
+		 * Check every logging event is inserted by the background thread
+		 * when full buffers are handed to it and the appender is then closed.
+		 *
+		 * Requires the unixODBC driver manager and the SQLite3 ODBC driver.
+		 */
+		void testBackgroundFlushInsertsAll()
+		{
+#if defined(WIN32) || defined(_WIN32)
+			std::cout << "testBackgroundFlushInsertsAll skipped: requires unixODBC" << std::endl;
+#else
+			SQLiteDataSource dataSource;
+			if (!dataSource.createTable())
+			{
+				std::cout << "testBackgroundFlushInsertsAll skipped: the SQLite3 ODBC driver is not available" << std::endl;
+				return;
+			}
+
+			auto appender = dataSource.createAppender(10, true);
+			auto logger = Logger::getLogger(LOG4CXX_STR("DB.SQLite.Background"));
+			logger->setAdditivity(false);
+			logger->addAppender(appender);
+
+			// Three full buffers are inserted by the background thread, the rest when closed
+			for (int i = 0; i < 35; ++i)
+				LOG4CXX_INFO(logger, "Message '" << i << "'");
+			logger->removeAppender(appender);
+			appender->close();
+
+			LOGUNIT_ASSERT_EQUAL(SQLINTEGER(35), dataSource.rowCount());
+#endif
+		}
+
 		// Flush the last message to the database prior to process termination
 		void tearDown()
 		{
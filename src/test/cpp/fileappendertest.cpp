@@ -60,6 +60,7 @@ LOGUNIT_CLASS(FileAppenderTest)
 	LOGUNIT_TEST(testgetSetThreshold);
 	LOGUNIT_TEST(testIsAsSevereAsThreshold);
 	LOGUNIT_TEST(testBufferedOutput);
+	LOGUNIT_TEST(testGroupCommit);
 	LOGUNIT_TEST_SUITE_END();
 
 #ifdef _DEBUG
@@ -146,6 +147,60 @@ public:
 		}
 		LOGUNIT_ASSERT(initialLength < flushedLength);
 	}
+
+	void testGroupCommit()
+	{
+		Pool p;
+		LogString fileName(LOG4CXX_STR("output/groupcommit.log"));
+		File file(fileName);
+		file.deleteFile(p);
+		auto makeAppender = [&fileName, &p](const LogString& milliseconds)
+		{
+			auto appender = std::make_shared<FileAppender>();
+			appender->setName(LOG4CXX_STR("GroupCommitAppender"));
+			appender->setLayout(std::make_shared<PatternLayout>(LOG4CXX_STR("%m%n")));
+			appender->setOption(LOG4CXX_STR("File"), fileName);
+			appender->setOption(LOG4CXX_STR("Append"), LOG4CXX_STR("true"));
+			appender->setOption(LOG4CXX_STR("BufferSize"), LOG4CXX_STR("1MB"));
+			appender->setOption(LOG4CXX_STR("GroupCommitMilliseconds"), milliseconds);
+			appender->activateOptions(p);
+			return appender;
+		};
+		auto logger = getLogger("groupcommit");
+		logger->setAdditivity(false);
+		int requiredMsgCount = 100;
+		auto logMessages = [logger, requiredMsgCount]()
+		{
+			for ( int x = 0; x < requiredMsgCount; x++ )
+			{
+				LOG4CXX_INFO( logger, "Message " << (x % 10) );
+			}
+		};
+
+		// Nothing is written before the first periodic commit
+		auto appender = makeAppender(LOG4CXX_STR("3600000"));
+		LOGUNIT_ASSERT_EQUAL(3600000, appender->getGroupCommitMilliseconds());
+		LOGUNIT_ASSERT(!appender->getImmediateFlush());
+		logger->addAppender(appender);
+		logMessages();
+		LOGUNIT_ASSERT_EQUAL(size_t(0), file.length(p));
+		logger->removeAppender(appender);
+		appender->close();
+		LOGUNIT_ASSERT_EQUAL(size_t(requiredMsgCount * 10), file.length(p));
+
+		// The periodic commit writes pending events
+		appender = makeAppender(LOG4CXX_STR("10"));
+		logger->addAppender(appender);
+		logMessages();
+		for (int retryCount = 0; file.length(p) < size_t(requiredMsgCount * 20) && retryCount < 1000; ++retryCount)
+			apr_sleep(10000);
+		LOGUNIT_ASSERT_EQUAL(size_t(requiredMsgCount * 20), file.length(p));
+
+		LOG4CXX_INFO( logger, "Message " << 0 );
+		logger->removeAppender(appender);
+		appender->close();
+		LOGUNIT_ASSERT_EQUAL(size_t((requiredMsgCount * 2 + 1) * 10), file.length(p));
+	}
 };
 
 LOGUNIT_TEST_SUITE_REGISTRATION(FileAppenderTest);
@@ -28,8 +28,11 @@
 #include "util/filenamefilter.h"
 #include "vectorappender.h"
 #include <log4cxx/fmtlayout.h>
+#include <log4cxx/asyncappender.h>
+#include <log4cxx/deferredformat.h>
 #include <log4cxx/propertyconfigurator.h>
 #include <log4cxx/helpers/date.h>
+#include <log4cxx/helpers/stringhelper.h>
 #include <log4cxx/spi/loggingevent.h>
 #include <iostream>
 #include <iomanip>
@@ -59,6 +62,8 @@ LOGUNIT_CLASS(FMTTestCase)
 	LOGUNIT_TEST(test1_expanded);
 	LOGUNIT_TEST(test10);
 //	LOGUNIT_TEST(test_date);
+	LOGUNIT_TEST(testFormatSpecs);
+	LOGUNIT_TEST(testDeferredFormat);
 	LOGUNIT_TEST_SUITE_END();
 
 	LoggerPtr root;
@@ -129,6 +134,48 @@ public:
 		LOGUNIT_ASSERT(Compare::compare(FILTERED, LOG4CXX_FILE("witness/patternLayout.10")));
 	}
 
+	void testFormatSpecs()
+	{
+		auto event = std::make_shared<log4cxx::spi::LoggingEvent>
+			( LOG4CXX_STR("org.example")
+			, Level::getInfo()
+			, LOG4CXX_STR("hi")
+			, log4cxx::spi::LocationInfo::getLocationUnavailable()
+			);
+		FMTLayout layout(LOG4CXX_STR("{{{p:<5}}} {c} {message:>4}|{m:.1}{n}"));
+		LogString output;
+		log4cxx::helpers::Pool pool;
+		layout.format(output, event, pool);
+		LogString expected(LOG4CXX_STR("{INFO } org.example   hi|h"));
+		expected.append(LOG4CXX_EOL);
+		LOGUNIT_ASSERT_EQUAL(expected, output);
+	}
+
+	/**
+	 * The message of a deferred request is formatted using copies of the argument values.
+	 */
+	void testDeferredFormat()
+	{
+		auto vectorAppender = std::make_shared<VectorAppender>();
+		auto asyncAppender = std::make_shared<AsyncAppender>();
+		asyncAppender->addAppender(vectorAppender);
+		root->addAppender(asyncAppender);
+
+		char buffer[] = "first";
+		std::string name("temporary");
+		LOG4CXX_DEFER_INFO_FMT(logger, "{} {} {:.2f} {}", 42, buffer, 1.5, name);
+		buffer[0] = 'F';
+		name = "changed";
+		LOG4CXX_DEFER_WARN_FMT(logger, "{:{}}", name, -1); // Negative width
+		asyncAppender->close();
+
+		LOGUNIT_ASSERT_EQUAL((size_t) 2, vectorAppender->vector.size());
+		LOGUNIT_ASSERT_EQUAL(LogString(LOG4CXX_STR("42 first 1.50 temporary")), vectorAppender->vector[0]->getMessage());
+		// The format string and the reason are kept when the values cannot be formatted
+		LogString failed = vectorAppender->vector[1]->getMessage();
+		LOGUNIT_ASSERT(StringHelper::startsWith(failed, LOG4CXX_STR("{:{}} [format error: ")));
+	}
+
 	void test_date(){
 		std::tm tm = {};
 		std::stringstream ss("2013-04-11 08:35:34");
@@ -26,6 +26,9 @@
 #include <apr.h>
 #include <apr_time.h>
 #include "localechanger.h"
+#include <atomic>
+#include <thread>
+#include <vector>
 
 using namespace log4cxx;
 using namespace log4cxx::helpers;
@@ -78,6 +81,7 @@ LOGUNIT_CLASS(CachedDateFormatTestCase)
 	LOGUNIT_TEST(test20);
 	LOGUNIT_TEST(test21);
 	LOGUNIT_TEST(test22);
+	LOGUNIT_TEST(testConcurrentUse);
 	LOGUNIT_TEST_SUITE_END();
 
 #define MICROSECONDS_PER_DAY APR_INT64_C(86400000000)
@@ -696,6 +700,44 @@ public:
 		LOGUNIT_ASSERT_EQUAL(LOG4CXX_STR("1970-01-01 00:00:01,999"), formatted);
 	}
 
+	/**
+	 * Tests concurrent conversions of different times do not interfere.
+	 */
+	void testConcurrentUse()
+	{
+		DateFormatPtr baseFormatter(new ISO8601DateFormat());
+		baseFormatter->setTimeZone(TimeZone::getGMT());
+		auto cachedFormat = std::make_shared<CachedDateFormat>(baseFormatter, 1000000);
+
+		const int threadCount = 4;
+		const int iterationCount = 2000;
+		std::atomic<int> failureCount{0};
+		std::vector<std::thread> threads;
+		for (int threadIndex = 0; threadIndex < threadCount; ++threadIndex)
+		{
+			threads.emplace_back([=, &failureCount]()
+			{
+				Pool p;
+				LogString expected;
+				LogString actual;
+				for (int i = 0; i < iterationCount; ++i)
+				{
+					// Each thread uses a different second and varies the milliseconds
+					log4cxx_time_t when = (log4cxx_time_t(threadIndex) * 3600 + i / 500) * 1000000 + (i % 1000) * 1000;
+					expected.clear();
+					baseFormatter->format(expected, when, p);
+					actual.clear();
+					cachedFormat->format(actual, when, p);
+					if (expected != actual)
+						++failureCount;
+				}
+			});
+		}
+		for (auto& thread : threads)
+			thread.join();
+		LOGUNIT_ASSERT_EQUAL(0, failureCount.load());
+	}
+
 };
 
 LOGUNIT_TEST_SUITE_REGISTRATION(CachedDateFormatTestCase);
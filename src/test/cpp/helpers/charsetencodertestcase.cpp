@@ -38,6 +38,8 @@ LOGUNIT_CLASS(CharsetEncoderTestCase)
 	LOGUNIT_TEST(encode3);
 	LOGUNIT_TEST(encode4);
 	LOGUNIT_TEST(encode5);
+	LOGUNIT_TEST(encode6);
+	LOGUNIT_TEST(encode7);
 	LOGUNIT_TEST(thread1);
 	LOGUNIT_TEST_SUITE_END();
 
@@ -364,6 +366,66 @@ public:
 			int repetitions;
 	};
 
+	void encode6()
+	{
+#if LOG4CXX_LOGCHAR_IS_WCHAR || LOG4CXX_LOGCHAR_IS_UNICHAR
+		const logchar greet[] = { L'A', L'b', 0xE9, L'c', 0x4E03, L'D', 0 };
+#endif
+
+#if LOG4CXX_LOGCHAR_IS_UTF8
+		const char greet[] = { 'A', 'b',
+				(char) 0xC3, (char) 0xA9,
+				'c',
+				(char) 0xE4, (char) 0xB8, (char) 0x83,
+				'D',
+				0
+			};
+#endif
+		LogString greeting(greet);
+
+		CharsetEncoderPtr enc(CharsetEncoder::getEncoder(LOG4CXX_STR("ISO-8859-1")));
+
+		char buf[BUFSIZE];
+		ByteBuffer out(buf, BUFSIZE);
+		LogString::const_iterator iter = greeting.begin();
+		log4cxx_status_t stat = enc->encode(greeting, iter, out);
+		LOGUNIT_ASSERT_EQUAL(true, CharsetEncoder::isError(stat));
+		LOGUNIT_ASSERT_EQUAL((size_t) 4, out.position());
+
+		CharsetEncoder::encode(enc, greeting, iter, out);
+		stat = enc->encode(greeting, iter, out);
+		LOGUNIT_ASSERT_EQUAL(false, CharsetEncoder::isError(stat));
+		LOGUNIT_ASSERT(iter == greeting.end());
+
+		out.flip();
+		std::string encoded(out.data(), out.limit());
+		LOGUNIT_ASSERT_EQUAL(std::string("Ab\xE9" "c?D"), encoded);
+	}
+
+	/**
+	 * Check a US-ASCII encoder stops at a non-ASCII character at each position of a long string.
+	 */
+	void encode7()
+	{
+		CharsetEncoderPtr enc(CharsetEncoder::getEncoder(LOG4CXX_STR("US-ASCII")));
+		const size_t length = 70;
+		for (size_t pos = 0; pos < length; ++pos)
+		{
+			LogString greeting(length, 0x41 /* A */);
+			LogString nonAscii;
+			Transcoder::encode(0xE9, nonAscii);
+			greeting.replace(pos, 1, nonAscii);
+
+			char buf[BUFSIZE];
+			ByteBuffer out(buf, BUFSIZE);
+			LogString::const_iterator iter = greeting.begin();
+			log4cxx_status_t stat = enc->encode(greeting, iter, out);
+			LOGUNIT_ASSERT_EQUAL(true, CharsetEncoder::isError(stat));
+			LOGUNIT_ASSERT_EQUAL(pos, out.position());
+			LOGUNIT_ASSERT(iter == greeting.begin() + pos);
+		}
+	}
+
 	void thread1()
 	{
 		enum { THREAD_COUNT = 10, THREAD_REPS = 10000 };
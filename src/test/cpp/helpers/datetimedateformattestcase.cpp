@@ -66,6 +66,7 @@ LOGUNIT_CLASS(DateTimeDateFormatTestCase)
 	LOGUNIT_TEST( test4 );
 	LOGUNIT_TEST( test5 );
 	LOGUNIT_TEST( test6 );
+	LOGUNIT_TEST( testCompiled );
 #if LOG4CXX_HAS_STD_LOCALE
 	LOGUNIT_TEST( test7 );
 	LOGUNIT_TEST( test8 );
@@ -175,6 +176,35 @@ public:
 			LOG4CXX_STR("03 Jul 2004 00:00:00,000"));
 	}
 
+	/** Check the pattern is compiled and formats the same text as the equivalent pattern tokens. */
+	void testCompiled()
+	{
+		MAKE_LOCALE(localeUS, LOCALE_US);
+		DateTimeDateFormat formatter(localeUS);
+		LOGUNIT_ASSERT(formatter.isCompiled());
+		SimpleDateFormat fullFormatter(LOG4CXX_STR("dd MMMM yyyy"), localeUS);
+		LOGUNIT_ASSERT(fullFormatter.isCompiled());
+		SimpleDateFormat tokenFormatter(LOG4CXX_STR("EEE dd MMM yyyy HH:mm:ss,SSS"), localeUS);
+		LOGUNIT_ASSERT(!tokenFormatter.isCompiled());
+		formatter.setTimeZone(TimeZone::getGMT());
+		fullFormatter.setTimeZone(TimeZone::getGMT());
+		tokenFormatter.setTimeZone(TimeZone::getGMT());
+		Pool p;
+		apr_time_t jan1 = MICROSECONDS_PER_DAY * 12418;
+		for (int month = 0; month < 12; ++month)
+		{
+			apr_time_t time = jan1 + MICROSECONDS_PER_DAY * (31 * month) + 12345678;
+			LogString expected;
+			tokenFormatter.format(expected, time, p);
+			LogString actual;
+			formatter.format(actual, time, p);
+			LOGUNIT_ASSERT_EQUAL(expected.substr(4), actual);
+		}
+		LogString actual;
+		fullFormatter.format(actual, MICROSECONDS_PER_DAY * 12599, p);
+		LOGUNIT_ASSERT_EQUAL((LogString) LOG4CXX_STR("30 June 2004"), actual);
+	}
+
 #if LOG4CXX_HAS_STD_LOCALE
 	LogString formatDate(const std::locale & locale, const tm & date, const LogString & fmt)
 	{
@@ -45,6 +45,8 @@ LOGUNIT_CLASS(ISO8601DateFormatTestCase)
 	LOGUNIT_TEST( test5 );
 	LOGUNIT_TEST( test6 );
 	LOGUNIT_TEST( test7 );
+	LOGUNIT_TEST( test8 );
+	LOGUNIT_TEST( test9 );
 	LOGUNIT_TEST_SUITE_END();
 
 	/**
@@ -162,6 +164,62 @@ public:
 		LOGUNIT_ASSERT_EQUAL((LogString) LOG4CXX_STR("87"), number);
 	}
 
+	/**
+	 * Check the reused components of a previous conversion are not used for a different quarter hour.
+	 */
+	void test8()
+	{
+		log4cxx_time_t jan1 = Date::getMicrosecondsPerDay() * 12784;
+		ISO8601DateFormat formatter;
+		formatter.setTimeZone(TimeZone::getGMT());
+		Pool p;
+		const struct
+		{
+			log4cxx_time_t time;
+			const logchar* expected;
+		} conversions[] =
+		{ { jan1 - 1000, LOG4CXX_STR("2004-12-31 23:59:59,999") }
+		, { jan1, LOG4CXX_STR("2005-01-01 00:00:00,000") }
+		, { jan1 - 15 * 60 * 1000000LL, LOG4CXX_STR("2004-12-31 23:45:00,000") }
+		, { jan1 - 1, LOG4CXX_STR("2004-12-31 23:59:59,999") }
+		, { jan1 + 14 * 60 * 1000000LL + 59999999, LOG4CXX_STR("2005-01-01 00:14:59,999") }
+		, { jan1 + 15 * 60 * 1000000LL, LOG4CXX_STR("2005-01-01 00:15:00,000") }
+		, { jan1 + 123456789, LOG4CXX_STR("2005-01-01 00:02:03,456") }
+		};
+		for (auto& item : conversions)
+		{
+			LogString actual;
+			formatter.format(actual, item.time, p);
+			LOGUNIT_ASSERT_EQUAL((LogString) item.expected, actual);
+		}
+	}
+
+	/**
+	 * Check a sequence of conversions by one formatter matches
+	 * independent conversions using pattern tokens.
+	 */
+	void test9()
+	{
+		auto timeZone = TimeZone::getTimeZone(LOG4CXX_STR("GMT+5:45"));
+		ISO8601DateFormat formatter;
+		formatter.setTimeZone(timeZone);
+		Pool p;
+		log4cxx_time_t start = Date::getMicrosecondsPerDay() * 12600;
+		log4cxx_time_t step = (7 * 60 + 13) * 1000000LL + 457321;
+		for (int i = -250; i < 250; ++i)
+		{
+			log4cxx_time_t time = start + (i < 0 ? -i : i) * step;
+			SimpleDateFormat tokenFormatter(LOG4CXX_STR("yyyy-MM-dd HH:mm:ss,SSS G"));
+			tokenFormatter.setTimeZone(timeZone);
+			LogString expected;
+			tokenFormatter.format(expected, time, p);
+			expected.erase(expected.size() - 3);
+			LogString actual;
+			formatter.format(actual, time, p);
+			LOGUNIT_ASSERT_EQUAL(expected, actual);
+		}
+	}
+
 
 
 };
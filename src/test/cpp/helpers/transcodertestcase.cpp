@@ -63,6 +63,10 @@ LOGUNIT_CLASS(TranscoderTestCase)
 	LOGUNIT_TEST(testDecodeUTF8_2);
 	LOGUNIT_TEST(testDecodeUTF8_3);
 	LOGUNIT_TEST(testDecodeUTF8_4);
+	LOGUNIT_TEST(testDecodeUTF8_5);
+#if LOG4CXX_WCHAR_T_API
+	LOGUNIT_TEST(testLongWideText);
+#endif
 #if LOG4CXX_UNICHAR_API
 	LOGUNIT_TEST(udecode2);
 	LOGUNIT_TEST(udecode4);
@@ -312,6 +316,64 @@ public:
 		LOGUNIT_ASSERT_EQUAL(true, iter == out.end());
 	}
 
+	/**
+	 * Check multibyte and invalid sequences at each position of a long string.
+	 */
+	void testDecodeUTF8_5()
+	{
+		const size_t length = 70;
+		for (size_t pos = 0; pos + 3 < length; ++pos)
+		{
+			std::string src(length, 'a');
+			src.replace(pos, 2, "\xC2\xA9");
+			auto invalidPos = length - 1 - pos;
+			if (invalidPos != pos && invalidPos != pos + 1)
+				src[invalidPos] = '\xFF';
+			LogString expected;
+			for (auto iter = src.begin(); iter != src.end(); ++iter)
+			{
+				if (*iter == '\xFF')
+					expected.append(1, Transcoder::LOSSCHAR);
+				else if (*iter != '\xC2')
+					expected.append(1, (logchar) *iter);
+				else
+				{
+					Transcoder::encode(0xA9, expected);
+					++iter;
+				}
+			}
+			LogString out;
+			Transcoder::decodeUTF8(src, out);
+			LOGUNIT_ASSERT_EQUAL(expected, out);
+		}
+	}
+
+#if LOG4CXX_WCHAR_T_API
+	/**
+	 * Check non-ASCII characters at each position of a long wide string.
+	 */
+	void testLongWideText()
+	{
+		const size_t length = 70;
+		for (size_t pos = 0; pos < length; ++pos)
+		{
+			std::wstring src(length, L'a');
+			src[pos] = 0xE9;
+			src[length - 1 - pos] = 0x4E03;
+			LogString expected;
+			for (auto ch : src)
+				Transcoder::encode(ch, expected);
+			LogString decoded;
+			Transcoder::decode(src, decoded);
+			LOGUNIT_ASSERT_EQUAL(expected, decoded);
+
+			std::wstring encoded;
+			Transcoder::encode(decoded, encoded);
+			LOGUNIT_ASSERT(src == encoded);
+		}
+	}
+#endif
+
 
 #if LOG4CXX_UNICHAR_API
 	void udecode2()
@@ -50,6 +50,7 @@ LOGUNIT_CLASS(JSONLayoutTest), public JSONLayout
 	LOGUNIT_TEST(testIgnoresThrowable);
 	LOGUNIT_TEST(testAppendQuotedEscapedStringWithPrintableChars);
 	LOGUNIT_TEST(testAppendQuotedEscapedStringWithControlChars);
+	LOGUNIT_TEST(testAppendQuotedEscapedStringWithLongText);
 	LOGUNIT_TEST(testAppendSerializedMDC);
 	LOGUNIT_TEST(testAppendSerializedMDCWithPrettyPrint);
 	LOGUNIT_TEST(testAppendSerializedNDC);
@@ -124,6 +125,35 @@ public:
 		LOGUNIT_ASSERT_EQUAL(LOG4CXX_STR("\"\\\"bar\\\\\\\"baz\\\"\""), t3);
 	}
 
+	/**
+	 * Tests appendQuotedEscapedString with special characters at each position of a long string.
+	 */
+	void testAppendQuotedEscapedStringWithLongText()
+	{
+		const size_t length = 70;
+		for (size_t pos = 0; pos < length; ++pos)
+		{
+			LogString text(length, 0x61 /* a */);
+			text[pos] = 0x0a;
+			text[length - 1 - pos] = 0x22;
+			LogString expected(1, 0x22);
+			for (auto ch : text)
+			{
+				if (ch == 0x0a)
+					expected.append(LOG4CXX_STR("\\n"));
+				else if (ch == 0x22)
+					expected.append(LOG4CXX_STR("\\\""));
+				else
+					expected.push_back(ch);
+			}
+			expected.push_back(0x22);
+
+			LogString actual;
+			appendQuotedEscapedString(actual, text);
+			LOGUNIT_ASSERT_EQUAL(expected, actual);
+		}
+	}
+
 	/**
 	 * Tests appendQuotedEscapedString with control characters.
 	 */
@@ -25,6 +25,7 @@
 #include <log4cxx/hierarchy.h>
 #include <log4cxx/loggerinstance.h>
 #include <log4cxx/spi/rootlogger.h>
+#include <log4cxx/spi/callsite.h>
 #include <log4cxx/helpers/propertyresourcebundle.h>
 #include "insertwide.h"
 #include "testchar.h"
@@ -61,6 +62,21 @@ class CountingAppender : public AppenderSkeleton
 		}
 };
 
+class SelfRemovingAppender : public CountingAppender
+{
+	public:
+		LoggerPtr owner;
+
+		SelfRemovingAppender(const LoggerPtr& owner) : owner(owner)
+		{}
+
+		void append(const spi::LoggingEventPtr& event, Pool& p) override
+		{
+			CountingAppender::append(event, p);
+			owner->removeAllAppenders();
+		}
+};
+
 class CountingListener : public HierarchyEventListener{
 public:
 	DECLARE_LOG4CXX_OBJECT(CountingListener)
@@ -91,6 +107,7 @@ LOGUNIT_CLASS(LoggerTestCase)
 	LOGUNIT_TEST_SUITE(LoggerTestCase);
 	LOGUNIT_TEST(testAppender1);
 	LOGUNIT_TEST(testAppender2);
+	LOGUNIT_TEST(testAppenderListChangedWhileAppending);
 	LOGUNIT_TEST(testAdditivity1);
 	LOGUNIT_TEST(testAdditivity2);
 	LOGUNIT_TEST(testAdditivity3);
@@ -103,6 +120,7 @@ LOGUNIT_CLASS(LoggerTestCase)
 	LOGUNIT_TEST(testLoggerInstance);
 	LOGUNIT_TEST(testTrace);
 	LOGUNIT_TEST(testIsTraceEnabled);
+	LOGUNIT_TEST(testCallSite);
 	LOGUNIT_TEST(testAddingListeners);
 	LOGUNIT_TEST(testAddingAndRemovingListeners);
 	LOGUNIT_TEST(testAddingAndRemovingListeners2);
@@ -158,6 +176,29 @@ public:
 		LOGUNIT_ASSERT(list.size() == 1);
 	}
 
+	/**
+	Remove all appenders while the logger is calling them and check
+	that each appender attached when the event was logged receives it.
+	*/
+	void testAppenderListChangedWhileAppending()
+	{
+		logger = Logger::getLogger(LOG4CXX_TEST_STR("test"));
+		auto remover = std::make_shared<SelfRemovingAppender>(logger);
+		auto counter = std::make_shared<CountingAppender>();
+		logger->addAppender(remover);
+		logger->addAppender(counter);
+
+		logger->debug(MSG);
+		LOGUNIT_ASSERT_EQUAL(1, remover->counter);
+		LOGUNIT_ASSERT_EQUAL(1, counter->counter);
+		LOGUNIT_ASSERT(logger->getAllAppenders().empty());
+
+		logger->debug(MSG);
+		LOGUNIT_ASSERT_EQUAL(1, remover->counter);
+		LOGUNIT_ASSERT_EQUAL(1, counter->counter);
+		remover->owner = 0;
+	}
+
 	/**
 	Test if LoggerPtr a.b inherits its appender from a.
 	*/
@@ -532,6 +573,72 @@ public:
 		LOGUNIT_ASSERT_EQUAL(LogString(LOG4CXX_STR("Message 1")), event->getMessage());
 	}
 
+	/**
+	 * Tests the cached enabled state of LOG4CXX_SITE_XXXX requests.
+	 */
+	void testCallSite()
+	{
+		VectorAppenderPtr appender = VectorAppenderPtr(new VectorAppender());
+		LoggerPtr root = Logger::getRootLogger();
+		root->addAppender(appender);
+		root->setLevel(Level::getInfo());
+
+		LoggerPtr tracer = Logger::getLogger("com.example.Tracer");
+		int lineNumber = 0;
+		auto logMessages = [tracer, &lineNumber]()
+		{
+			for (int i = 0; i < 2; ++i)
+			{
+				lineNumber = __LINE__ + 1;
+				LOG4CXX_SITE_DEBUG(tracer, "Message " << i);
+			}
+		};
+		logMessages();
+		LOGUNIT_ASSERT_EQUAL((size_t) 0, appender->vector.size());
+
+		// A level change is detected
+		tracer->setLevel(Level::getDebug());
+		logMessages();
+		LOGUNIT_ASSERT_EQUAL((size_t) 2, appender->vector.size());
+		LOGUNIT_ASSERT_EQUAL((int) Level::DEBUG_INT, appender->vector[0]->getLevel()->toInt());
+
+		// A parent level change is detected
+		tracer->setLevel(LevelPtr());
+		logMessages();
+		LOGUNIT_ASSERT_EQUAL((size_t) 2, appender->vector.size());
+		root->setLevel(Level::getTrace());
+		logMessages();
+		LOGUNIT_ASSERT_EQUAL((size_t) 4, appender->vector.size());
+
+		// A threshold change is detected
+		root->getLoggerRepository()->setThreshold(Level::getInfo());
+		logMessages();
+		LOGUNIT_ASSERT_EQUAL((size_t) 4, appender->vector.size());
+
+		// An individual request can be enabled
+		spi::CallSite::setEnabled("loggertestcase.cpp", lineNumber, true);
+		logMessages();
+		LOGUNIT_ASSERT_EQUAL((size_t) 6, appender->vector.size());
+		spi::CallSite::removeAllOverrides();
+		logMessages();
+		LOGUNIT_ASSERT_EQUAL((size_t) 6, appender->vector.size());
+		root->getLoggerRepository()->setThreshold(Level::getAll());
+
+		// A different logger at the same location is detected
+		LoggerPtr quiet = Logger::getLogger("com.example.Quiet");
+		quiet->setLevel(Level::getInfo());
+		auto logTo = [](const LoggerPtr& logger)
+		{
+			LOG4CXX_SITE_DEBUG(logger, "Message");
+		};
+		logTo(tracer);
+		LOGUNIT_ASSERT_EQUAL((size_t) 7, appender->vector.size());
+		logTo(quiet);
+		LOGUNIT_ASSERT_EQUAL((size_t) 7, appender->vector.size());
+		logTo(tracer);
+		LOGUNIT_ASSERT_EQUAL((size_t) 8, appender->vector.size());
+	}
+
 	/**
 	 * Tests isTraceEnabled.
 	 *
@@ -20,6 +20,8 @@
 #include <log4cxx/file.h>
 #include <log4cxx/logger.h>
 #include <log4cxx/propertyconfigurator.h>
+#include <log4cxx/spi/loggingevent.h>
+#include <log4cxx/helpers/threadspecificdata.h>
 #include "insertwide.h"
 #include "logunit.h"
 #include "util/compare.h"
@@ -32,6 +34,7 @@ LOGUNIT_CLASS(MDCTestCase)
 {
 	LOGUNIT_TEST_SUITE(MDCTestCase);
 	LOGUNIT_TEST(test1);
+	LOGUNIT_TEST(testLoadDC);
 	LOGUNIT_TEST_SUITE_END();
 
 public:
@@ -62,6 +65,35 @@ public:
 		std::string actual(MDC::get(key));
 		LOGUNIT_ASSERT_EQUAL(expected, actual);
 	}
+
+	/**
+	 *   Events share a copy of the MDC until it is changed.
+	 */
+	void testLoadDC()
+	{
+		LogString key(LOG4CXX_STR("key1"));
+		MDC::put(key, LOG4CXX_STR("value1"));
+		auto pData = helpers::ThreadSpecificData::getCurrentData();
+		LOGUNIT_ASSERT(pData);
+		auto copy1 = pData->getMapCopy();
+		LOGUNIT_ASSERT(copy1 == pData->getMapCopy());
+
+		auto event1 = std::make_shared<spi::LoggingEvent>(LOG4CXX_STR("test"), Level::getInfo(), LOG4CXX_STR("m1"), LOG4CXX_LOCATION);
+		event1->LoadDC();
+		MDC::put(key, LOG4CXX_STR("value2"));
+		LOGUNIT_ASSERT(copy1 != pData->getMapCopy());
+		auto event2 = std::make_shared<spi::LoggingEvent>(LOG4CXX_STR("test"), Level::getInfo(), LOG4CXX_STR("m2"), LOG4CXX_LOCATION);
+		event2->LoadDC();
+		MDC::clear();
+
+		LogString value1;
+		LOGUNIT_ASSERT(event1->getMDC(key, value1));
+		LOGUNIT_ASSERT_EQUAL(LogString(LOG4CXX_STR("value1")), value1);
+		LogString value2;
+		LOGUNIT_ASSERT(event2->getMDC(key, value2));
+		LOGUNIT_ASSERT_EQUAL(LogString(LOG4CXX_STR("value2")), value2);
+		LOGUNIT_ASSERT(pData->getMapCopy()->empty());
+	}
 };
 
 LOGUNIT_TEST_SUITE_REGISTRATION(MDCTestCase);
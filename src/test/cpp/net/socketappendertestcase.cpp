@@ -44,6 +44,9 @@ class SocketAppenderTestCase : public AppenderSkeletonTestCase
 		LOGUNIT_TEST(testDefaultThreshold);
 		LOGUNIT_TEST(testSetOptionThreshold);
 		LOGUNIT_TEST(testRetryConnect);
+		LOGUNIT_TEST(testBufferedSend);
+		LOGUNIT_TEST(testBufferFull);
+		LOGUNIT_TEST(testBufferSizeReset);
 
 		LOGUNIT_TEST_SUITE_END();
 
@@ -180,6 +183,111 @@ class SocketAppenderTestCase : public AppenderSkeletonTestCase
 			}
 			LOGUNIT_ASSERT_EQUAL(logEventCount, (int)messageCount.size());
 		}
+
+		static void logMessages(const AppenderPtr& appender, int count)
+		{
+			auto logger = Logger::getLogger(LOG4CXX_STR("SocketAppenderTestCase"));
+			helpers::Pool p;
+			for (int i = 0; i < count; ++i)
+			{
+				LogString msg(LOG4CXX_STR("Message "));
+				helpers::StringHelper::toString(i, p, msg);
+				auto event = std::make_shared<spi::LoggingEvent>
+					( logger->getName(), Level::getInfo(), msg, LOG4CXX_LOCATION );
+				appender->doAppend(event, p);
+			}
+		}
+
+		/**
+		 * Check events written to the buffer are all sent by the sending thread.
+		 */
+		void testBufferedSend()
+		{
+			int tcpPort = 44446;
+			auto serverSocket = helpers::ServerSocket::create(tcpPort);
+			auto appender = std::make_shared<net::SocketAppender>();
+			appender->setLayout(std::make_shared<log4cxx::PatternLayout>(LOG4CXX_STR("%m%n")));
+			appender->setRemoteHost(LOG4CXX_STR("localhost"));
+			appender->setPort(tcpPort);
+			appender->setOption(LOG4CXX_STR("BufferSize"), LOG4CXX_STR("1MB"));
+			helpers::Pool pool;
+			appender->activateOptions(pool);
+
+			int logEventCount = 1000;
+			logMessages(appender, logEventCount);
+			auto incomingSocket = serverSocket->accept();
+			appender->close();
+			LOGUNIT_ASSERT_EQUAL((size_t)0, appender->getQueuedByteCount());
+			LOGUNIT_ASSERT_EQUAL((size_t)0, appender->getDiscardedByteCount());
+
+			auto aprSocket = std::dynamic_pointer_cast<helpers::APRSocket>(incomingSocket);
+			LOGUNIT_ASSERT(aprSocket);
+			auto pSocket = aprSocket->getSocketPtr();
+			apr_socket_timeout_set(pSocket, 200000);    // 200 millisecond
+			std::string received;
+			char buffer[8*1024];
+			apr_size_t len = sizeof(buffer);
+			while (APR_SUCCESS == apr_socket_recv(pSocket, buffer, &len))
+			{
+				received.append(buffer, len);
+				len = sizeof(buffer);
+			}
+			incomingSocket->close();
+			serverSocket->close();
+
+			std::string expected;
+			for (int i = 0; i < logEventCount; ++i)
+				expected += "Message " + std::to_string(i) + "\n";
+			LOGUNIT_ASSERT_EQUAL(expected, received);
+		}
+
+		/**
+		 * Check output is discarded (not blocked) when the server is unreachable.
+		 */
+		void testBufferFull()
+		{
+			int tcpPort = 44447;
+			auto appender = std::make_shared<net::SocketAppender>();
+			appender->setLayout(std::make_shared<log4cxx::PatternLayout>(LOG4CXX_STR("%m%n")));
+			appender->setRemoteHost(LOG4CXX_STR("localhost"));
+			appender->setPort(tcpPort);
+			appender->setBufferSize(1000);
+			helpers::Pool pool;
+			appender->activateOptions(pool);
+
+			int logEventCount = 500;
+			size_t totalSize = 0;
+			for (int i = 0; i < logEventCount; ++i)
+				totalSize += std::string("Message " + std::to_string(i) + "\n").size();
+			logMessages(appender, logEventCount);
+			LOGUNIT_ASSERT(appender->getQueuedByteCount() <= 1000);
+			LOGUNIT_ASSERT(0 < appender->getDiscardedByteCount());
+			LOGUNIT_ASSERT_EQUAL(totalSize, appender->getQueuedByteCount() + appender->getDiscardedByteCount());
+			appender->close();
+		}
+
+		/**
+		 * Check the sending thread is removed when BufferSize is changed to zero.
+		 */
+		void testBufferSizeReset()
+		{
+			int tcpPort = 44448;
+			auto appender = std::make_shared<net::SocketAppender>();
+			appender->setLayout(std::make_shared<log4cxx::PatternLayout>(LOG4CXX_STR("%m%n")));
+			appender->setRemoteHost(LOG4CXX_STR("localhost"));
+			appender->setPort(tcpPort);
+			appender->setBufferSize(100);
+			helpers::Pool pool;
+			appender->activateOptions(pool);
+			logMessages(appender, 50);
+			LOGUNIT_ASSERT(0 < appender->getDiscardedByteCount());
+
+			appender->setBufferSize(0);
+			appender->activateOptions(pool);
+			LOGUNIT_ASSERT_EQUAL((size_t)0, appender->getQueuedByteCount());
+			LOGUNIT_ASSERT_EQUAL((size_t)0, appender->getDiscardedByteCount());
+			appender->close();
+		}
 };
 
 LOGUNIT_TEST_SUITE_REGISTRATION(SocketAppenderTestCase);
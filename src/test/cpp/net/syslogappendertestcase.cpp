@@ -16,8 +16,15 @@
  */
 
 #include <log4cxx/helpers/datagramsocket.h>
+#include <log4cxx/helpers/serversocket.h>
+#include <log4cxx/helpers/stringhelper.h>
+#include <log4cxx/helpers/syslogwriter.h>
 #include <log4cxx/net/syslogappender.h>
+#include <log4cxx/patternlayout.h>
+#include <log4cxx/logger.h>
+#include <log4cxx/private/aprsocket.h>
 #include "../appenderskeletontestcase.h"
+#include <apr_network_io.h>
 
 using namespace log4cxx;
 using namespace log4cxx::helpers;
@@ -33,6 +40,10 @@ class SyslogAppenderTestCase : public AppenderSkeletonTestCase
 		//
 		LOGUNIT_TEST(testDefaultThreshold);
 		LOGUNIT_TEST(testSetOptionThreshold);
+		LOGUNIT_TEST(testBatchedUDP);
+		LOGUNIT_TEST(testOctetCountedTCP);
+		LOGUNIT_TEST(testHeldUntilConnected);
+		LOGUNIT_TEST(testHostWithoutActivateOptions);
 
 		LOGUNIT_TEST_SUITE_END();
 
@@ -43,6 +54,197 @@ class SyslogAppenderTestCase : public AppenderSkeletonTestCase
 		{
 			return new log4cxx::net::SyslogAppender();
 		}
+
+		/**
+		 * An appender sending "<14>message N" messages to \c port on the local host.
+		 */
+		static net::SyslogAppenderPtr createAppender(int port, const LogString& protocol, int batchSize)
+		{
+			auto appender = std::make_shared<net::SyslogAppender>();
+			appender->setLayout(std::make_shared<PatternLayout>(LOG4CXX_STR("%m")));
+			appender->setOption(LOG4CXX_STR("Protocol"), protocol);
+			Pool p;
+			LogString batchSizeStr;
+			StringHelper::toString(batchSize, p, batchSizeStr);
+			appender->setOption(LOG4CXX_STR("BatchSize"), batchSizeStr);
+			appender->setOption(LOG4CXX_STR("BatchMilliseconds"), LOG4CXX_STR("0"));
+			LogString host(LOG4CXX_STR("127.0.0.1:"));
+			StringHelper::toString(port, p, host);
+			appender->setSyslogHost(host);
+			appender->activateOptions(p);
+			return appender;
+		}
+
+		static void logMessages(const net::SyslogAppenderPtr& appender, int count)
+		{
+			auto logger = Logger::getLogger(LOG4CXX_STR("SyslogAppenderTestCase"));
+			Pool p;
+			for (int i = 0; i < count; ++i)
+			{
+				LogString msg(LOG4CXX_STR("message "));
+				StringHelper::toString(i, p, msg);
+				auto event = std::make_shared<spi::LoggingEvent>
+					( logger->getName(), Level::getInfo(), msg, LOG4CXX_LOCATION );
+				appender->doAppend(event, p);
+			}
+		}
+
+		/**
+		 * Check batched datagrams are received as individual messages.
+		 */
+		void testBatchedUDP()
+		{
+			int udpPort = 44450;
+			Pool p;
+			apr_socket_t* server;
+			apr_sockaddr_t* addr;
+			LOGUNIT_ASSERT_EQUAL(APR_SUCCESS, apr_sockaddr_info_get(&addr, "127.0.0.1", APR_INET, udpPort, 0, p.getAPRPool()));
+			LOGUNIT_ASSERT_EQUAL(APR_SUCCESS, apr_socket_create(&server, APR_INET, SOCK_DGRAM, APR_PROTO_UDP, p.getAPRPool()));
+			LOGUNIT_ASSERT_EQUAL(APR_SUCCESS, apr_socket_bind(server, addr));
+			apr_socket_timeout_set(server, 200000);    // 200 millisecond
+
+			const int messageCount = 25;
+			auto appender = createAppender(udpPort, LOG4CXX_STR("UDP"), 10);
+			logMessages(appender, messageCount);
+			appender->close();
+
+			char buffer[2048];
+			int receivedCount = 0;
+			for (;;)
+			{
+				apr_size_t len = sizeof(buffer);
+				if (APR_SUCCESS != apr_socket_recv(server, buffer, &len))
+					break;
+				std::string expected("<14>message " + std::to_string(receivedCount));
+				LOGUNIT_ASSERT_EQUAL(expected, std::string(buffer, len));
+				++receivedCount;
+			}
+			apr_socket_close(server);
+			LOGUNIT_ASSERT_EQUAL(messageCount, receivedCount);
+		}
+
+		/**
+		 * Check messages sent over TCP are framed using octet counting.
+		 */
+		void testOctetCountedTCP()
+		{
+			int tcpPort = 44451;
+			auto serverSocket = ServerSocket::create(tcpPort);
+
+			const int messageCount = 25;
+			auto appender = createAppender(tcpPort, LOG4CXX_STR("TCP"), 10);
+			logMessages(appender, messageCount);
+			appender->close();
+
+			checkOctetCounted(serverSocket, messageCount);
+		}
+
+		/**
+		 * Check messages logged before the syslog host is listening are held and then sent.
+		 */
+		void testHeldUntilConnected()
+		{
+			int tcpPort = 44452;
+			const int messageCount = 25;
+			auto appender = createAppender(tcpPort, LOG4CXX_STR("TCP"), 1);
+			logMessages(appender, messageCount);
+
+			auto serverSocket = ServerSocket::create(tcpPort);
+			appender->close();
+
+			checkOctetCounted(serverSocket, messageCount);
+
+			// A failed connection attempt delays the next attempt, but not the one made by close()
+			SyslogWriter writer(LOG4CXX_STR("127.0.0.1"), tcpPort, SyslogWriter::TCP, 1);
+			writer.setReconnectionDelay(60000, 60000);
+			for (int i = 0; i < messageCount; ++i)
+			{
+				LogString msg(LOG4CXX_STR("<14>message "));
+				Pool p;
+				StringHelper::toString(i, p, msg);
+				writer.write(msg);
+			}
+			writer.flush(); // Nothing is listening
+			serverSocket = ServerSocket::create(tcpPort);
+			writer.flush(); // Within the reconnection delay
+			writer.close();
+			LOGUNIT_ASSERT_EQUAL(size_t(0), writer.takeDiscardedCount());
+
+			checkOctetCounted(serverSocket, messageCount);
+		}
+
+		/**
+		 * Check messages reach the syslog host when only the host is set.
+		 */
+		void testHostWithoutActivateOptions()
+		{
+			int udpPort = 44453;
+			Pool p;
+			apr_socket_t* server;
+			apr_sockaddr_t* addr;
+			LOGUNIT_ASSERT_EQUAL(APR_SUCCESS, apr_sockaddr_info_get(&addr, "127.0.0.1", APR_INET, udpPort, 0, p.getAPRPool()));
+			LOGUNIT_ASSERT_EQUAL(APR_SUCCESS, apr_socket_create(&server, APR_INET, SOCK_DGRAM, APR_PROTO_UDP, p.getAPRPool()));
+			LOGUNIT_ASSERT_EQUAL(APR_SUCCESS, apr_socket_bind(server, addr));
+			apr_socket_timeout_set(server, 200000);    // 200 millisecond
+
+			const int messageCount = 5;
+			auto appender = std::make_shared<net::SyslogAppender>();
+			appender->setLayout(std::make_shared<PatternLayout>(LOG4CXX_STR("%m")));
+			appender->setSyslogHost(LOG4CXX_STR("127.0.0.1:44453"));
+			logMessages(appender, messageCount);
+			appender->close();
+
+			char buffer[2048];
+			int receivedCount = 0;
+			for (;;)
+			{
+				apr_size_t len = sizeof(buffer);
+				if (APR_SUCCESS != apr_socket_recv(server, buffer, &len))
+					break;
+				std::string expected("<14>message " + std::to_string(receivedCount));
+				LOGUNIT_ASSERT_EQUAL(expected, std::string(buffer, len));
+				++receivedCount;
+			}
+			apr_socket_close(server);
+			LOGUNIT_ASSERT_EQUAL(messageCount, receivedCount);
+		}
+
+		/**
+		 * Check \c messageCount "<14>message N" frames are received by \c serverSocket.
+		 */
+		void checkOctetCounted(const ServerSocketUniquePtr& serverSocket, int messageCount)
+		{
+			auto incomingSocket = serverSocket->accept();
+			auto aprSocket = std::dynamic_pointer_cast<APRSocket>(incomingSocket);
+			LOGUNIT_ASSERT(aprSocket);
+			auto pSocket = aprSocket->getSocketPtr();
+			apr_socket_timeout_set(pSocket, 200000);    // 200 millisecond
+			std::string received;
+			char buffer[2048];
+			apr_size_t len = sizeof(buffer);
+			while (APR_SUCCESS == apr_socket_recv(pSocket, buffer, &len))
+			{
+				received.append(buffer, len);
+				len = sizeof(buffer);
+			}
+			incomingSocket->close();
+			serverSocket->close();
+
+			int receivedCount = 0;
+			size_t pos = 0;
+			while (pos < received.size())
+			{
+				auto space = received.find(' ', pos);
+				LOGUNIT_ASSERT(received.npos != space);
+				auto frameLength = std::stoul(received.substr(pos, space - pos));
+				LOGUNIT_ASSERT(space + 1 + frameLength <= received.size());
+				std::string expected("<14>message " + std::to_string(receivedCount));
+				LOGUNIT_ASSERT_EQUAL(expected, received.substr(space + 1, frameLength));
+				pos = space + 1 + frameLength;
+				++receivedCount;
+			}
+			LOGUNIT_ASSERT_EQUAL(messageCount, receivedCount);
+		}
 };
 
 LOGUNIT_TEST_SUITE_REGISTRATION(SyslogAppenderTestCase);
@@ -17,7 +17,10 @@
 
 #include <log4cxx/net/telnetappender.h>
 #include <log4cxx/patternlayout.h>
+#include <log4cxx/helpers/inetaddress.h>
+#include <log4cxx/private/aprsocket.h>
 #include "../appenderskeletontestcase.h"
+#include <apr_network_io.h>
 #include <apr_thread_proc.h>
 #include <apr_time.h>
 #include <thread>
@@ -41,6 +44,7 @@ class TelnetAppenderTestCase : public AppenderSkeletonTestCase
 		LOGUNIT_TEST(testActivateSleepClose);
 		LOGUNIT_TEST(testActivateWriteClose);
 		LOGUNIT_TEST(testActivateWriteNoClose);
+		LOGUNIT_TEST(testDiscardReport);
 
 		LOGUNIT_TEST_SUITE_END();
 
@@ -120,6 +124,57 @@ class TelnetAppenderTestCase : public AppenderSkeletonTestCase
 			}
 		}
 
+		/**
+		 * Receive from \c socket until \c terminator is received or nothing arrives for 2 seconds.
+		 */
+		static std::string receiveUntil(const SocketPtr& socket, const std::string& terminator)
+		{
+			auto pSocket = std::dynamic_pointer_cast<APRSocket>(socket)->getSocketPtr();
+			apr_socket_timeout_set(pSocket, 2 * APR_USEC_PER_SEC);
+			std::string result;
+			char buffer[1024];
+			apr_size_t len = sizeof(buffer);
+			while (result.size() < terminator.size()
+				|| result.compare(result.size() - terminator.size(), terminator.size(), terminator) != 0)
+			{
+				if (APR_SUCCESS != apr_socket_recv(pSocket, buffer, &len))
+					break;
+				result.append(buffer, len);
+				len = sizeof(buffer);
+			}
+			return result;
+		}
+
+		/**
+		 * Check output that does not fit in the client's buffer is discarded and reported.
+		 */
+		void testDiscardReport()
+		{
+			TelnetAppenderPtr appender(new TelnetAppender());
+			appender->setLayout(std::make_shared<PatternLayout>(LOG4CXX_STR("%m")));
+			appender->setPort(TEST_PORT + 1);
+			appender->setOption(LOG4CXX_STR("BufferSize"), LOG4CXX_STR("100"));
+			Pool p;
+			appender->activateOptions(p);
+
+			auto address = InetAddress::getByName(LOG4CXX_STR("127.0.0.1"));
+			SocketPtr client = Socket::create(address, TEST_PORT + 1);
+			auto greeting = receiveUntil(client, "active connections)\r\n\r\n");
+			LOGUNIT_ASSERT_EQUAL(std::string("TelnetAppender v1.0 (1 active connections)\r\n\r\n"), greeting);
+
+			auto logger = Logger::getLogger(LOG4CXX_STR("TelnetAppenderTestCase"));
+			auto tooLong = std::make_shared<spi::LoggingEvent>
+				( logger->getName(), Level::getInfo(), LogString(148, 'x'), LOG4CXX_LOCATION );
+			appender->doAppend(tooLong, p);
+			auto last = std::make_shared<spi::LoggingEvent>
+				( logger->getName(), Level::getInfo(), LOG4CXX_STR("done"), LOG4CXX_LOCATION );
+			appender->doAppend(last, p);
+
+			auto received = receiveUntil(client, "done\r\n");
+			LOGUNIT_ASSERT_EQUAL(std::string("150 bytes of logging output were discarded.\r\ndone\r\n"), received);
+			client->close();
+			appender->close();
+		}
 };
 
 LOGUNIT_TEST_SUITE_REGISTRATION(TelnetAppenderTestCase);
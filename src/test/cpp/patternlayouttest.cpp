@@ -79,6 +79,7 @@ LOGUNIT_CLASS(PatternLayoutTest)
 	LOGUNIT_TEST(test14);
 	LOGUNIT_TEST(testMDC1);
 	LOGUNIT_TEST(testMDC2);
+	LOGUNIT_TEST(testMergedSegments);
 	LOGUNIT_TEST_SUITE_END();
 
 	LoggerPtr root;
@@ -439,6 +440,23 @@ public:
 		LOGUNIT_ASSERT(Compare::compare(TEMP, LOG4CXX_FILE("witness/patternLayout.14")));
 	}
 
+	void testMergedSegments()
+	{
+		PatternLayout layout(LOG4CXX_STR("[%-6p]%%%% %.4c %c %5m|%m{x}%n"));
+		auto event = std::make_shared<spi::LoggingEvent>
+			( LOG4CXX_STR("org.example")
+			, Level::getInfo()
+			, LOG4CXX_STR("axb")
+			, spi::LocationInfo::getLocationUnavailable()
+			);
+		LogString result;
+		Pool p;
+		layout.format(result, event, p);
+		LogString expected(LOG4CXX_STR("[INFO  ]%% mple org.example   axb|axxb"));
+		expected.append(LOG4CXX_EOL);
+		LOGUNIT_ASSERT_EQUAL(expected, result);
+	}
+
 	void testMDC1()
 	{
 		PropertyConfigurator::configure(LOG4CXX_FILE("input/patternLayout.mdc.1.properties"));
@@ -0,0 +1,176 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "../logunit.h"
+#include <log4cxx/rolling/gzcompressaction.h>
+#include <log4cxx/rolling/zipcompressaction.h>
+#include <log4cxx/file.h>
+#include <log4cxx/helpers/pool.h>
+#include <apr_file_io.h>
+#include <apr_time.h>
+#include <zlib.h>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+using namespace log4cxx;
+using namespace log4cxx::helpers;
+using namespace log4cxx::rolling;
+
+/**
+ *   Tests that the in-process compression actions
+ *   produce files that zlib restores to the original content.
+ */
+LOGUNIT_CLASS(CompressActionTest)
+{
+	LOGUNIT_TEST_SUITE(CompressActionTest);
+	LOGUNIT_TEST(testGZRoundTrip);
+	LOGUNIT_TEST(testZipRoundTrip);
+	LOGUNIT_TEST(testZipDateBefore1980);
+	LOGUNIT_TEST_SUITE_END();
+
+	/**
+	 * Content larger than the 64 KiB chunk used when deflating.
+	 */
+	static std::string makeContent()
+	{
+		std::string result;
+		for (int i = 0; result.size() < 200000; ++i)
+		{
+			result += "Line " + std::to_string(i) + ": the quick brown fox jumps over the lazy dog " + std::to_string(i * 7919 % 1013) + "\n";
+		}
+		return result;
+	}
+
+	static void writeFile(const std::string& path, const std::string& content)
+	{
+		std::ofstream out(path, std::ios::binary | std::ios::trunc);
+		out.write(content.data(), content.size());
+	}
+
+	static std::string readFile(const std::string& path)
+	{
+		std::ifstream in(path, std::ios::binary);
+		return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+	}
+
+	static uint32_t getUInt16(const std::string& data, size_t offset)
+	{
+		return static_cast<unsigned char>(data[offset])
+			| (static_cast<unsigned char>(data[offset + 1]) << 8);
+	}
+
+	static uint32_t getUInt32(const std::string& data, size_t offset)
+	{
+		return getUInt16(data, offset) | (getUInt16(data, offset + 2) << 16);
+	}
+
+	/**
+	 * Decompress \c compressed using \c windowBits, storing the number of input bytes used in \c used.
+	 */
+	std::string inflateAll(const std::string& compressed, int windowBits, size_t offset = 0, size_t* used = nullptr)
+	{
+		z_stream strm{};
+		LOGUNIT_ASSERT_EQUAL(Z_OK, inflateInit2(&strm, windowBits));
+		strm.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(compressed.data() + offset));
+		strm.avail_in = static_cast<uInt>(compressed.size() - offset);
+		std::string result;
+		char buffer[16384];
+		int ret;
+		do
+		{
+			strm.next_out = reinterpret_cast<Bytef*>(buffer);
+			strm.avail_out = sizeof(buffer);
+			ret = inflate(&strm, Z_NO_FLUSH);
+			LOGUNIT_ASSERT(Z_OK == ret || Z_STREAM_END == ret);
+			result.append(buffer, sizeof(buffer) - strm.avail_out);
+		} while (Z_STREAM_END != ret);
+		if (used)
+			*used = strm.total_in;
+		inflateEnd(&strm);
+		return result;
+	}
+
+public:
+	void testGZRoundTrip()
+	{
+		Pool p;
+		std::string source = "output/compressaction.log";
+		std::string destination = source + ".gz";
+		auto content = makeContent();
+		writeFile(source, content);
+
+		GZCompressAction action(File(source), File(destination), true);
+		action.setCompressionLevel(9);
+		LOGUNIT_ASSERT(action.execute(p));
+		LOGUNIT_ASSERT(!File(source).exists(p));
+
+		auto compressed = readFile(destination);
+		LOGUNIT_ASSERT(compressed.size() < content.size());
+		LOGUNIT_ASSERT(content == inflateAll(compressed, 16 + MAX_WBITS));
+	}
+
+	void testZipRoundTrip()
+	{
+		Pool p;
+		std::string source = "output/compressaction.log";
+		std::string destination = source + ".zip";
+		auto content = makeContent();
+		writeFile(source, content);
+
+		ZipCompressAction action(File(source), File(destination), true);
+		LOGUNIT_ASSERT(action.execute(p));
+		LOGUNIT_ASSERT(!File(source).exists(p));
+
+		auto archive = readFile(destination);
+		LOGUNIT_ASSERT(30 < archive.size());
+		LOGUNIT_ASSERT_EQUAL(0x04034b50u, getUInt32(archive, 0));
+		LOGUNIT_ASSERT_EQUAL(8u, getUInt16(archive, 8)); // deflate
+		size_t dataStart = 30 + getUInt16(archive, 26) + getUInt16(archive, 28);
+
+		size_t used = 0;
+		LOGUNIT_ASSERT(content == inflateAll(archive, -MAX_WBITS, dataStart, &used));
+
+		// The data descriptor follows the compressed data
+		size_t descriptor = dataStart + used;
+		LOGUNIT_ASSERT(descriptor + 16 <= archive.size());
+		LOGUNIT_ASSERT_EQUAL(0x08074b50u, getUInt32(archive, descriptor));
+		auto crc = crc32(0L, reinterpret_cast<const Bytef*>(content.data()), static_cast<uInt>(content.size()));
+		LOGUNIT_ASSERT_EQUAL(static_cast<uint32_t>(crc), getUInt32(archive, descriptor + 4));
+		LOGUNIT_ASSERT_EQUAL(static_cast<uint32_t>(used), getUInt32(archive, descriptor + 8));
+		LOGUNIT_ASSERT_EQUAL(static_cast<uint32_t>(content.size()), getUInt32(archive, descriptor + 12));
+	}
+
+	void testZipDateBefore1980()
+	{
+		Pool p;
+		std::string source = "output/compressaction-old.log";
+		std::string destination = source + ".zip";
+		writeFile(source, "old\n");
+		apr_time_t epoch = 0;
+		LOGUNIT_ASSERT_EQUAL(APR_SUCCESS, apr_file_mtime_set(source.c_str(), epoch, p.getAPRPool()));
+
+		ZipCompressAction action(File(source), File(destination), true);
+		LOGUNIT_ASSERT(action.execute(p));
+
+		auto archive = readFile(destination);
+		LOGUNIT_ASSERT(30 < archive.size());
+		LOGUNIT_ASSERT_EQUAL(0u, getUInt16(archive, 10)); // 00:00:00
+		LOGUNIT_ASSERT_EQUAL((1u << 5) | 1u, getUInt16(archive, 12)); // 1980-01-01
+	}
+};
+
+LOGUNIT_TEST_SUITE_REGISTRATION(CompressActionTest);
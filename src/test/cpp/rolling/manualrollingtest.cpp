@@ -193,6 +193,7 @@ public:
 		root->addAppender(rfa);
 
 		common(rfa, p, logger);
+		rfa->close(); // Wait for compression to complete
 
 		LOGUNIT_ASSERT_EQUAL(true, File("output/manual-test3.log").exists(p));
 		LOGUNIT_ASSERT_EQUAL(true, File("output/manual-test3.0.gz").exists(p));
@@ -343,6 +344,7 @@ public:
 
 
 		common(rfa, p, logger);
+		rfa->close(); // Wait for compression to complete
 
 		LOGUNIT_ASSERT_EQUAL(true, File(filenamePatternPrefix + LOG4CXX_STR("/file-0.gz")).exists(p));
 		LOGUNIT_ASSERT_EQUAL(true, File(filenamePatternPrefix + LOG4CXX_STR("/file-1.gz")).exists(p));
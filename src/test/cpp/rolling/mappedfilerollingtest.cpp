@@ -0,0 +1,193 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one or more
+ * contributor license agreements.  See the NOTICE file distributed with
+ * this work for additional information regarding copyright ownership.
+ * The ASF licenses this file to You under the Apache License, Version 2.0
+ * (the "License"); you may not use this file except in compliance with
+ * the License.  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "../util/compare.h"
+#include "../insertwide.h"
+#include "../logunit.h"
+#include <log4cxx/basicconfigurator.h>
+#include <log4cxx/logmanager.h>
+#include <log4cxx/patternlayout.h>
+#include <log4cxx/rolling/fixedwindowrollingpolicy.h>
+#include <log4cxx/rolling/sizebasedtriggeringpolicy.h>
+#include <log4cxx/rolling/mappedfileappender.h>
+#include <log4cxx/helpers/pool.h>
+#include <log4cxx/logger.h>
+#include <fstream>
+
+
+using namespace log4cxx;
+using namespace log4cxx::helpers;
+using namespace log4cxx::rolling;
+
+/**
+ * Tests MappedFileAppender.
+ */
+LOGUNIT_CLASS(MappedFileRollingTest)
+{
+	LOGUNIT_TEST_SUITE(MappedFileRollingTest);
+	LOGUNIT_TEST(test1);
+	LOGUNIT_TEST(test2);
+	LOGUNIT_TEST(test3);
+	LOGUNIT_TEST(test4);
+	LOGUNIT_TEST_SUITE_END();
+
+	LoggerPtr root;
+	LoggerPtr logger;
+
+public:
+	void setUp()
+	{
+		root = Logger::getRootLogger();
+		logger = Logger::getLogger("org.apache.log4j.rolling.MappedFileRollingTest");
+	}
+
+	void tearDown()
+	{
+		LogManager::shutdown();
+	}
+
+	void common(LoggerPtr & logger1)
+	{
+		char msg[] = { 'H', 'e', 'l', 'l', 'o', '-', '-', '-', 'N', 0 };
+
+		// Write exactly 10 bytes with each log
+		for (int i = 0; i < 25; i++)
+		{
+			if (i < 10)
+			{
+				msg[8] = '0' + i;
+			}
+			else if (i < 100)
+			{
+				msg[7] = '0' + i / 10;
+				msg[8] = '0' + i % 10;
+			}
+
+			LOG4CXX_DEBUG(logger1, msg);
+		}
+	}
+
+	MappedFileAppenderPtr createAppender(const LogString& fileName, bool append)
+	{
+		auto result = std::make_shared<MappedFileAppender>();
+		result->setName(LOG4CXX_STR("MAPPED"));
+		result->setAppend(append);
+		result->setLayout(std::make_shared<PatternLayout>(LOG4CXX_STR("%m\n")));
+		if (!fileName.empty())
+			result->setFile(fileName);
+		return result;
+	}
+
+	/**
+	 * Tests files are truncated to their content when rolled over or closed.
+	 */
+	void test1()
+	{
+		auto mfa = createAppender(LogString(), false);
+		auto swrp = std::make_shared<FixedWindowRollingPolicy>();
+		auto sbtp = std::make_shared<SizeBasedTriggeringPolicy>();
+		sbtp->setMaxFileSize(100);
+		swrp->setMinIndex(0);
+		swrp->setFileNamePattern(LOG4CXX_STR("output/mappedFile-test1.%i"));
+		Pool p;
+		swrp->activateOptions(p);
+		mfa->setRollingPolicy(swrp);
+		mfa->setTriggeringPolicy(sbtp);
+		mfa->activateOptions(p);
+		root->addAppender(mfa);
+
+		common(logger);
+
+		LOGUNIT_ASSERT_EQUAL(true, Compare::compare(File("output/mappedFile-test1.1"),
+				File("witness/rolling/sbr-test2.0")));
+		LOGUNIT_ASSERT_EQUAL(true, Compare::compare(File("output/mappedFile-test1.2"),
+				File("witness/rolling/sbr-test2.1")));
+
+		root->removeAppender(mfa);
+		mfa->close();
+		LOGUNIT_ASSERT_EQUAL(true, Compare::compare(File("output/mappedFile-test1.0"),
+				File("witness/rolling/sbr-test2.log")));
+	}
+
+	/**
+	 * Tests writing more than the size of a mapped region.
+	 */
+	void test2()
+	{
+		auto mfa = createAppender(LOG4CXX_STR("output/mappedFile-test2.log"), false);
+		mfa->setOption(LOG4CXX_STR("MapSize"), LOG4CXX_STR("64KB"));
+		mfa->setMaximumFileSize(100 * 1024 * 1024);
+		LOGUNIT_ASSERT_EQUAL(size_t(64 * 1024), mfa->getMapSize());
+		Pool p;
+		mfa->activateOptions(p);
+		root->addAppender(mfa);
+
+		int messageCount = 20000; // 200,000 bytes
+		for (int i = 0; i < messageCount; i++)
+		{
+			LOG4CXX_DEBUG(logger, "Hello-" << (100 + i % 900));
+		}
+
+		root->removeAppender(mfa);
+		mfa->close();
+		LOGUNIT_ASSERT_EQUAL(size_t(messageCount * 10), File("output/mappedFile-test2.log").length(p));
+	}
+
+	/**
+	 * Tests content is added to an existing file.
+	 */
+	void test3()
+	{
+		Pool p;
+		File("output/mappedFile-test3.log").deleteFile(p);
+		for (int pass = 0; pass < 2; ++pass)
+		{
+			auto mfa = createAppender(LOG4CXX_STR("output/mappedFile-test3.log"), true);
+			mfa->setMaximumFileSize(100 * 1024 * 1024);
+			mfa->activateOptions(p);
+			root->addAppender(mfa);
+			common(logger);
+			root->removeAppender(mfa);
+			mfa->close();
+		}
+		LOGUNIT_ASSERT_EQUAL(size_t(2 * 25 * 10), File("output/mappedFile-test3.log").length(p));
+	}
+
+	/**
+	 * Tests appending overwrites the unused region left by a process that did not truncate the file.
+	 */
+	void test4()
+	{
+		Pool p;
+		{
+			std::ofstream out("output/mappedFile-test4.log", std::ios::binary | std::ios::trunc);
+			out << "Hello---X\n";
+			out << std::string(5000, '\0');
+		}
+		auto mfa = createAppender(LOG4CXX_STR("output/mappedFile-test4.log"), true);
+		mfa->activateOptions(p);
+		root->addAppender(mfa);
+		common(logger);
+		root->removeAppender(mfa);
+		mfa->close();
+		LOGUNIT_ASSERT_EQUAL(size_t(10 + 25 * 10), File("output/mappedFile-test4.log").length(p));
+		std::ifstream in("output/mappedFile-test4.log", std::ios::binary);
+		std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+		LOGUNIT_ASSERT_EQUAL(std::string("Hello---X\nHello---0\n"), content.substr(0, 20));
+	}
+};
+
+LOGUNIT_TEST_SUITE_REGISTRATION(MappedFileRollingTest);
@@ -56,6 +56,7 @@ LOGUNIT_CLASS(SizeBasedRollingTest)
 	LOGUNIT_TEST(test4);
 	LOGUNIT_TEST(test5);
 	LOGUNIT_TEST(test6);
+	LOGUNIT_TEST(test7);
 	LOGUNIT_TEST_SUITE_END();
 
 	LoggerPtr root;
@@ -206,6 +207,7 @@ public:
 		root->addAppender(rfa);
 
 		common(logger, 100);
+		rfa->close(); // Wait for compression to complete
 
 		LOGUNIT_ASSERT_EQUAL(true, File("output/sbr-test3.log").exists(p));
 		LOGUNIT_ASSERT_EQUAL(true, File("output/sbr-test3.0.gz").exists(p));
@@ -354,6 +356,7 @@ public:
 		root->addAppender(rfa);
 
 		common(logger, 100);
+		rfa->close(); // Wait for compression to complete
 
 		LOGUNIT_ASSERT_EQUAL(true, File("output/sbr-test6.log").exists(p));
 		LOGUNIT_ASSERT_EQUAL(true, File("output/sbr-test6.0.zip").exists(p));
@@ -362,6 +365,58 @@ public:
 		LOGUNIT_ASSERT_EQUAL(true, Compare::compare(File("output/sbr-test6.log"),  File("witness/rolling/sbr-test3.log")));
 	}
 
+	/**
+	 * Checks rollovers that occur while a previous compression is in progress
+	 * leave every archive in place.
+	 */
+	void test7()
+	{
+		auto layout = std::make_shared<PatternLayout>(LOG4CXX_STR("%m\n"));
+		auto rfa = std::make_shared<RollingFileAppender>();
+		rfa->setAppend(false);
+		rfa->setLayout(layout);
+
+		auto fwrp = std::make_shared<FixedWindowRollingPolicy>();
+		auto sbtp = std::make_shared<SizeBasedTriggeringPolicy>();
+
+		sbtp->setMaxFileSize(100);
+		fwrp->setMinIndex(1);
+		fwrp->setMaxIndex(12);
+		rfa->setFile(LOG4CXX_STR("output/sbr-test7.log"));
+		fwrp->setFileNamePattern(LOG4CXX_STR("output/sbr-test7.%i.gz"));
+		Pool p;
+		fwrp->activateOptions(p);
+		rfa->setRollingPolicy(fwrp);
+		rfa->setTriggeringPolicy(sbtp);
+		rfa->activateOptions(p);
+		root->addAppender(rfa);
+
+		// Write exactly 10 bytes with each log
+		for (int i = 0; i < 135; i++)
+		{
+			LogString msg(LOG4CXX_STR("Hello-"));
+			msg.append(i < 10 ? LOG4CXX_STR("00") : i < 100 ? LOG4CXX_STR("0") : LOG4CXX_STR(""));
+			StringHelper::toString(i, p, msg);
+			LOG4CXX_DEBUG(logger, msg);
+		}
+		rfa->close(); // Wait for queued rollovers to complete
+
+		LOGUNIT_ASSERT_EQUAL(true, File("output/sbr-test7.log").exists(p));
+		for (int i = 1; i <= 12; ++i)
+		{
+			LogString name(LOG4CXX_STR("output/sbr-test7."));
+			StringHelper::toString(i, p, name);
+			LOGUNIT_ASSERT_EQUAL(true, File(name + LOG4CXX_STR(".gz")).exists(p));
+			LOGUNIT_ASSERT_EQUAL(false, File(name).exists(p));
+		}
+		LOGUNIT_ASSERT_EQUAL(false, File("output/sbr-test7.13.gz").exists(p));
+		LogString pendingPrefix(LOG4CXX_STR("sbr-test7.log.rollover"));
+		for (auto& name : File(LOG4CXX_STR("output")).list(p))
+		{
+			LOGUNIT_ASSERT_EQUAL(false, StringHelper::startsWith(name, pendingPrefix));
+		}
+	}
+
 };
 
 
@@ -482,6 +482,7 @@ public:
 		fnames[nrOfFnames - 1].resize(fnames[nrOfFnames - 1].size() - 3);
 		this->delayUntilNextSecondWithMsg();
 		this->logMsgAndSleep(	pool, nrOfFnames + 1, __LOG4CXX_FUNC__, __LINE__);
+		rfa->close(); // Wait for compression to complete
 		this->checkFilesExist<4>(	pool, LOG4CXX_STR("test3."), fnames, nrOfFnames - 1, __LINE__);
 	}
 
@@ -603,6 +604,7 @@ public:
 
 		this->delayUntilNextSecondWithMsg();
 		this->logMsgAndSleep(	pool, nrOfLogMsgs, __LOG4CXX_FUNC__, __LINE__);
+		rfa->close(); // Wait for compression to complete
 		this->checkFilesExist(	pool, LOG4CXX_STR("test6."), fnames, 0, __LINE__);
 	}
 
@@ -67,6 +67,7 @@ LOGUNIT_CLASS(XMLLayoutTest)
 	LOGUNIT_TEST(testActivateOptions);
 	LOGUNIT_TEST(testProblemCharacters);
 	LOGUNIT_TEST(testNDCWithCDATA);
+	LOGUNIT_TEST(testLongNDCWithCDATA);
 	LOGUNIT_TEST_SUITE_END();
 
 
@@ -453,6 +454,47 @@ public:
 		LOGUNIT_ASSERT_EQUAL(1, ndcCount);
 	}
 
+	/**
+	  * Tests CDATA end markers at each position of long NDC content.
+	  */
+	void testLongNDCWithCDATA()
+	{
+		LogString logger = LOG4CXX_STR("com.example.bar");
+		LevelPtr level = Level::getInfo();
+		XMLLayout layout;
+		Pool p;
+
+		for (size_t pos = 0; pos < 40; ++pos)
+		{
+			std::string ndcMessage(40, 'x');
+			ndcMessage.replace(pos, 3, "]]>");
+			ndcMessage.resize(40);
+			ndcMessage.insert(0, "<envelope>&");
+			NDC::push(ndcMessage);
+			LoggingEventPtr event = LoggingEventPtr(
+					new LoggingEvent(
+						logger, level, LOG4CXX_STR("Hello, World"), LOG4CXX_LOCATION));
+			LogString result;
+			layout.format(result, event, p);
+			NDC::clear();
+			apr_xml_elem* parsedResult = parse(result, p);
+			int ndcCount = 0;
+
+			for (apr_xml_elem* node = parsedResult->first_child;
+				node != NULL;
+				node = node->next)
+			{
+				if (strcmp(node->name, "NDC") == 0)
+				{
+					ndcCount++;
+					LOGUNIT_ASSERT_EQUAL(ndcMessage, getText(node));
+				}
+			}
+
+			LOGUNIT_ASSERT_EQUAL(1, ndcCount);
+		}
+	}
+
 };
 
 